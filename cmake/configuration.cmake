@@ -73,6 +73,8 @@ CPMGetPackage (hibf)
 CPMGetPackage (sharg)
 CPMGetPackage (seqan3)
 CPMGetPackage (chopper)
+CPMGetPackage (zstd)
+CPMGetPackage (lz4)
 
 # ----------------------------------------------------------------------------
 # Find Raptor include path
@@ -94,7 +96,7 @@ endif ()
 # ----------------------------------------------------------------------------
 
 add_library (raptor_interface INTERFACE)
-target_link_libraries (raptor_interface INTERFACE sharg::sharg seqan3::seqan3 seqan::hibf)
+target_link_libraries (raptor_interface INTERFACE sharg::sharg seqan3::seqan3 seqan::hibf libzstd_static lz4_static)
 target_include_directories (raptor_interface INTERFACE "${RAPTOR_INCLUDE_DIR}")
 
 if ("${CMAKE_CXX_COMPILER_ID}" STREQUAL "IntelLLVM")
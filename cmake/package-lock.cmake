@@ -50,6 +50,32 @@ CPMDeclarePackage (chopper
                            "CMAKE_MESSAGE_LOG_LEVEL WARNING"
                    EXCLUDE_FROM_ALL TRUE
 )
+# zstd
+set (RAPTOR_ZSTD_VERSION 1.5.7 CACHE STRING "")
+CPMDeclarePackage (zstd
+                   NAME zstd
+                   VERSION ${RAPTOR_ZSTD_VERSION}
+                   GIT_TAG v${RAPTOR_ZSTD_VERSION}
+                   GITHUB_REPOSITORY facebook/zstd
+                   SOURCE_SUBDIR build/cmake
+                   SYSTEM TRUE
+                   EXCLUDE_FROM_ALL TRUE
+                   OPTIONS "ZSTD_BUILD_PROGRAMS OFF" "ZSTD_BUILD_SHARED OFF" "ZSTD_BUILD_TESTS OFF"
+                           "ZSTD_LEGACY_SUPPORT OFF" "CMAKE_MESSAGE_LOG_LEVEL WARNING"
+)
+# lz4
+set (RAPTOR_LZ4_VERSION 1.10.0 CACHE STRING "")
+CPMDeclarePackage (lz4
+                   NAME lz4
+                   VERSION ${RAPTOR_LZ4_VERSION}
+                   GIT_TAG v${RAPTOR_LZ4_VERSION}
+                   GITHUB_REPOSITORY lz4/lz4
+                   SOURCE_SUBDIR build/cmake
+                   SYSTEM TRUE
+                   EXCLUDE_FROM_ALL TRUE
+                   OPTIONS "LZ4_BUILD_CLI OFF" "BUILD_SHARED_LIBS OFF" "BUILD_STATIC_LIBS ON"
+                           "CMAKE_MESSAGE_LOG_LEVEL WARNING"
+)
 # benchmark
 set (RAPTOR_BENCHMARK_VERSION 1.9.5 CACHE STRING "")
 CPMDeclarePackage (benchmark
@@ -16,6 +16,10 @@
 
 #include <hibf/misc/timer.hpp>
 
+#include <raptor/index_compression.hpp>
+#include <raptor/perf_counters.hpp>
+#include <raptor/sketch.hpp>
+
 namespace raptor
 {
 
@@ -26,23 +30,37 @@ struct build_arguments
     uint32_t window_size{kmer_size};
     std::string shape_string{};
     seqan3::shape shape{seqan3::ungapped{kmer_size}};
+    sketch_kind sketch{sketch_kind::minimiser};
 
     // Related to IBF
     std::filesystem::path out_path{};
     uint64_t bins{64};
-    mutable uint64_t bits{4096}; // Allow to change bits for each partition
+    uint64_t bits{4096};
     uint64_t hash{2};
-    uint8_t parts{1u};
+    mutable uint8_t parts{1u}; // Increased if the index does not fit into the memory limit
+    bool spill_parts{false};
+    index_compression compression{index_compression::none};
     double fpr{0.05};
+    uint64_t memory_limit{}; // In MiB. 0 means no limit.
+    // Only the user bins in [bin_range_begin, bin_range_end) are inserted. The index has the size for all user bins.
+    uint64_t bin_range_begin{};
+    uint64_t bin_range_end{};
 
     // General arguments
     std::vector<std::vector<std::string>> bin_path{};
     std::filesystem::path bin_file{};
     uint8_t threads{1u};
     bool is_hibf{false};
+    bool is_blocked_ibf{false};
     bool input_is_minimiser{false};
     bool quiet{false};
     std::filesystem::path timing_out{};
+    bool perf_counters{false};
+    std::filesystem::path trace_file{};
+    std::filesystem::path sketch_cache_dir{};
+    std::string bin_range_string{};
+    uint64_t checkpoint_interval{}; // In seconds. 0: no checkpoints.
+    bool resume{false};
 
     // Timers do not copy the stored duration upon copy construction/assignment
     mutable seqan::hibf::concurrent_timer wall_clock_timer{};
@@ -52,6 +70,17 @@ struct build_arguments
     mutable seqan::hibf::concurrent_timer merge_kmers_timer{};
     mutable seqan::hibf::concurrent_timer fill_ibf_timer{};
     mutable seqan::hibf::concurrent_timer store_index_timer{};
+    mutable concurrent_perf_counters user_bin_io_counters{};
+
+    bool has_bin_range() const
+    {
+        return bin_range_end != 0u;
+    }
+
+    bool uses_checkpoint() const
+    {
+        return checkpoint_interval != 0u || resume;
+    }
 
     void print_timings() const;
     void write_timings_to_file() const;
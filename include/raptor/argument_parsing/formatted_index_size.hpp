@@ -42,4 +42,14 @@ namespace raptor
     return formatted_bytes(index_size_in_KiB(index_path, parts) << 10);
 }
 
+//!\brief The rate at which the index was stored or loaded within `seconds`.
+[[nodiscard]] inline double
+index_throughput_in_MiB_per_second(std::filesystem::path const & index_path, uint8_t const parts, double const seconds)
+{
+    if (seconds <= 0.0)
+        return 0.0;
+
+    return index_size_in_KiB(index_path, parts) / 1024.0 / seconds;
+}
+
 } // namespace raptor
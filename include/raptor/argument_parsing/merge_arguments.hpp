@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::merge_arguments.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <hibf/misc/timer.hpp>
+
+#include <raptor/argument_parsing/memory_usage.hpp>
+
+namespace raptor
+{
+
+struct merge_arguments
+{
+    //!\brief The indices built with `raptor build --bin-range`. Parts: Without suffix _0
+    std::vector<std::filesystem::path> shard_files{};
+    std::filesystem::path out_path{};
+    uint8_t threads{1u};
+    bool quiet{false};
+
+    // Read from the indices, not from the command line.
+    uint8_t parts{1u};
+
+    // Timers do not copy the stored duration upon copy construction/assignment
+    mutable seqan::hibf::concurrent_timer wall_clock_timer{};
+    mutable seqan::hibf::concurrent_timer merge_timer{};
+
+    void print_timings() const
+    {
+        if (quiet)
+            return;
+        std::cerr << std::fixed << std::setprecision(2) << "============= Timings =============\n";
+        std::cerr << "Wall clock time [s]: " << wall_clock_timer.in_seconds() << '\n';
+        std::cerr << "Peak memory usage " << formatted_peak_ram() << '\n';
+        std::cerr << "Merge [s]: " << merge_timer.in_seconds() << '\n';
+    }
+};
+
+} // namespace raptor
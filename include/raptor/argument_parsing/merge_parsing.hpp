@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::merge_parsing.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <sharg/parser.hpp>
+
+namespace raptor
+{
+
+void merge_parsing(sharg::parser & parser);
+
+} // namespace raptor
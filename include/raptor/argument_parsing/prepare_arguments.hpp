@@ -17,6 +17,8 @@
 #include <hibf/misc/timer.hpp>
 
 #include <raptor/argument_parsing/memory_usage.hpp>
+#include <raptor/perf_counters.hpp>
+#include <raptor/sketch.hpp>
 #include <raptor/strong_types.hpp>
 
 namespace raptor
@@ -28,8 +30,11 @@ struct prepare_arguments
     uint32_t window_size{kmer_size};
     std::string shape_string{};
     seqan3::shape shape{seqan3::ungapped{kmer_size}};
+    sketch_kind sketch{sketch_kind::minimiser};
     bool use_filesize_dependent_cutoff{false};
     uint8_t kmer_count_cutoff{1u};
+    uint64_t counting_memory{}; // In MiB. 0 means no limit.
+    uint64_t memory_limit{};    // In MiB. 0 means no limit.
 
     std::filesystem::path out_dir{"./"};
 
@@ -37,12 +42,16 @@ struct prepare_arguments
     std::filesystem::path bin_file{};
     uint8_t threads{1u};
     bool quiet{false};
+    bool perf_counters{false};
+    std::filesystem::path trace_file{};
 
     // Timers do not copy the stored duration upon copy construction/assignment
     mutable seqan::hibf::concurrent_timer wall_clock_timer{};
     mutable seqan::hibf::concurrent_timer compute_minimiser_timer{};
     mutable seqan::hibf::concurrent_timer write_minimiser_timer{};
     mutable seqan::hibf::concurrent_timer write_header_timer{};
+    mutable concurrent_perf_counters compute_minimiser_counters{};
+    mutable concurrent_perf_counters write_minimiser_counters{};
 
     void print_timings() const
     {
@@ -52,7 +61,17 @@ struct prepare_arguments
         std::cerr << "Wall clock time [s]: " << wall_clock_timer.in_seconds() << '\n';
         std::cerr << "Peak memory usage " << formatted_peak_ram() << '\n';
         std::cerr << "Compute minimiser [s]: " << compute_minimiser_timer.in_seconds() / threads << '\n';
+        if (perf_counters)
+        {
+            std::cerr << "└── Hardware counters\n";
+            compute_minimiser_counters.print(std::cerr, "    ");
+        }
         std::cerr << "Write minimiser files [s]: " << write_minimiser_timer.in_seconds() / threads << '\n';
+        if (perf_counters)
+        {
+            std::cerr << "└── Hardware counters\n";
+            write_minimiser_counters.print(std::cerr, "    ");
+        }
         std::cerr << "Write header files [s]: " << write_header_timer.in_seconds() / threads << '\n';
     }
 };
@@ -18,6 +18,11 @@
 
 #include <raptor/argument_parsing/formatted_index_size.hpp>
 #include <raptor/argument_parsing/memory_usage.hpp>
+#include <raptor/bin_path_table.hpp>
+#include <raptor/build/partition_config.hpp>
+#include <raptor/perf_counters.hpp>
+#include <raptor/search/latency_histogram.hpp>
+#include <raptor/sketch.hpp>
 #include <raptor/threshold/threshold_parameters.hpp>
 
 namespace raptor
@@ -30,8 +35,10 @@ struct search_arguments
     seqan3::shape shape{seqan3::ungapped{20u}};
     uint8_t shape_size{shape.size()};
     uint8_t shape_weight{shape.count()};
+    sketch_kind sketch{};
     uint8_t threads{1u};
     uint8_t parts{1u};
+    hash_partitioning partitioning{};
 
     // Related to thresholding
     double tau{0.9999};
@@ -41,18 +48,27 @@ struct search_arguments
     uint64_t query_length{};
     uint8_t errors{0};
 
+    // Lengths of the shortest and longest query. Estimated from a sample, and updated during the search.
+    mutable uint64_t min_query_length{};
+    mutable uint64_t max_query_length{};
+
     // Related to IBF
     std::filesystem::path index_file{};
 
     // General arguments
-    std::vector<std::vector<std::string>> bin_path{};
+    bin_path_table bin_path{};
     std::filesystem::path query_file{};
     std::filesystem::path out_file{"search.out"};
     bool write_time{false};
     bool is_hibf{false};
+    bool is_blocked_ibf{false};
+    bool lazy_load{false};
     bool cache_thresholds{false};
     bool quiet{false};
     std::filesystem::path timing_out{};
+    bool latency_histograms{false};
+    bool perf_counters{false};
+    std::filesystem::path trace_file{};
 
     // FPGA
     bool use_fpga{false};
@@ -69,14 +85,20 @@ struct search_arguments
     mutable seqan::hibf::concurrent_timer generate_results_timer{};
     mutable seqan::hibf::concurrent_timer complete_search_timer{};
     mutable seqan::hibf::concurrent_timer parallel_search_timer{};
+    mutable concurrent_stage_latencies stage_latency{};
+    mutable concurrent_perf_counters compute_minimiser_counters{};
+    mutable concurrent_perf_counters query_ibf_counters{};
+    mutable concurrent_perf_counters generate_results_counters{};
 
     void print_timings() const;
     void write_timings_to_file() const;
+    void write_latencies_per_length_to_file() const;
 
     raptor::threshold::threshold_parameters make_threshold_parameters() const noexcept
     {
         return {.window_size = window_size,
                 .shape = shape,
+                .sketch = sketch,
                 .query_length = query_length,
                 .errors = errors,
                 .percentage = threshold,
@@ -3,7 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 /*!\file
- * \brief Provides raptor::validate_shape.
+ * \brief Provides raptor::validate_shape and raptor::add_trace_option.
  * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
  */
 
@@ -13,6 +13,7 @@
 
 #include <raptor/argument_parsing/build_arguments.hpp>
 #include <raptor/argument_parsing/prepare_arguments.hpp>
+#include <raptor/argument_parsing/validators.hpp>
 
 namespace raptor
 {
@@ -52,6 +53,25 @@ void validate_shape(sharg::parser & parser, argument_t & arguments)
         arguments.window_size = arguments.shape.size();
     else if (arguments.shape.size() > arguments.window_size)
         throw sharg::parser_error{"The k-mer size cannot be bigger than the window size."};
+
+    if (arguments.sketch == sketch_kind::syncmer && arguments.shape.count() != arguments.shape.size())
+        throw sharg::parser_error{"--sketch syncmer requires an ungapped shape."};
+
+    if (arguments.sketch == sketch_kind::syncmer && arguments.shape.size() < syncmer_hash::min_kmer_size)
+        throw sharg::parser_error{"--sketch syncmer requires a k-mer size of at least "
+                                  + std::to_string(syncmer_hash::min_kmer_size) + "."};
+}
+
+//!\brief Adds the `--trace` option of the subcommands that run stages on multiple threads.
+inline void add_trace_option(sharg::parser & parser, std::filesystem::path & trace_file)
+{
+    parser.add_option(trace_file,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "trace",
+                                    .description = "Write a timeline of the stages and of the work of each thread to "
+                                                   "the specified file (Chrome trace event format). The file can be "
+                                                   "viewed with, e.g., https://ui.perfetto.dev.",
+                                    .validator = output_file_validator{}});
 }
 
 } // namespace raptor
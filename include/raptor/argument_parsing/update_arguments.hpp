@@ -27,6 +27,7 @@ struct update_arguments
     //!\brief The `--insert` argument: a single sequence file, or a file containing file names.
     std::filesystem::path bin_file{};
     uint8_t threads{1u};
+    std::filesystem::path trace_file{};
 
     // Read from the index, not from the command line.
     uint32_t window_size{20u};
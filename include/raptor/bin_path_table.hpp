@@ -0,0 +1,306 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::bin_path_table.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+namespace raptor
+{
+
+/*!\brief The file paths of the user bins, stored in one buffer.
+ * \details
+ * All paths are concatenated in one string. Two offset vectors mark where each path, and the paths of each user bin,
+ * begin. Accessing a user bin yields a view of std::string_view; copying or loading the table needs a constant
+ * number of allocations, independent of the number of paths.
+ *
+ * In the serialised form, each distinct directory is stored once. The paths are stored as the ID of their directory
+ * and their file name.
+ */
+class bin_path_table
+{
+private:
+    //!\brief Returns the path with the given ID.
+    struct path_at
+    {
+        bin_path_table const * table{};
+
+        std::string_view operator()(uint64_t const path_id) const
+        {
+            return table->path(path_id);
+        }
+    };
+
+public:
+    //!\brief The paths of one user bin, a random access range of std::string_view.
+    using user_bin_view = std::ranges::transform_view<std::ranges::iota_view<uint64_t, uint64_t>, path_at>;
+
+    class iterator;
+
+    bin_path_table() = default;
+    bin_path_table(bin_path_table const &) = default;
+    bin_path_table(bin_path_table &&) = default;
+    bin_path_table & operator=(bin_path_table const &) = default;
+    bin_path_table & operator=(bin_path_table &&) = default;
+    ~bin_path_table() = default;
+
+    explicit bin_path_table(std::vector<std::vector<std::string>> const & bin_path)
+    {
+        size_t characters{};
+        size_t paths{};
+        for (std::vector<std::string> const & user_bin : bin_path)
+        {
+            paths += user_bin.size();
+            for (std::string const & path : user_bin)
+                characters += path.size();
+        }
+
+        characters_.reserve(characters);
+        path_offsets_.reserve(paths + 1u);
+        user_bin_offsets_.reserve(bin_path.size() + 1u);
+        for (std::vector<std::string> const & user_bin : bin_path)
+            push_back(user_bin);
+    }
+
+    //!\brief The number of user bins.
+    size_t size() const noexcept
+    {
+        return user_bin_offsets_.size() - 1u;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0u;
+    }
+
+    //!\brief The number of paths of all user bins.
+    size_t number_of_paths() const noexcept
+    {
+        return path_offsets_.size() - 1u;
+    }
+
+    std::string_view path(size_t const path_id) const
+    {
+        assert(path_id < number_of_paths());
+        return std::string_view{characters_}.substr(path_offsets_[path_id],
+                                                    path_offsets_[path_id + 1u] - path_offsets_[path_id]);
+    }
+
+    user_bin_view operator[](size_t const user_bin_id) const
+    {
+        assert(user_bin_id < size());
+        return user_bin_view{std::views::iota(user_bin_offsets_[user_bin_id], user_bin_offsets_[user_bin_id + 1u]),
+                             path_at{this}};
+    }
+
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+    //!\brief Appends a user bin.
+    template <std::ranges::input_range range_t>
+        requires std::convertible_to<std::ranges::range_reference_t<range_t>, std::string_view>
+    void push_back(range_t && paths)
+    {
+        for (std::string_view const path : paths)
+        {
+            characters_.append(path);
+            path_offsets_.push_back(characters_.size());
+        }
+        user_bin_offsets_.push_back(number_of_paths());
+    }
+
+    //!\brief Returns a copy of the paths as nested vectors.
+    std::vector<std::vector<std::string>> to_vector() const
+    {
+        std::vector<std::vector<std::string>> result(size());
+        for (size_t user_bin_id = 0; user_bin_id < size(); ++user_bin_id)
+            for (std::string_view const path : (*this)[user_bin_id])
+                result[user_bin_id].emplace_back(path);
+        return result;
+    }
+
+    bool operator==(bin_path_table const &) const = default;
+
+    /*!\cond DEV
+     * \brief Serialisation support functions.
+     * \tparam archive_t Type of `archive`; must satisfy seqan3::cereal_archive.
+     * \param[in] archive The archive being serialised from/to.
+     *
+     * \attention These functions are never called directly.
+     * \sa https://docs.seqan.de/seqan/3.2.0/group__io.html#serialisation
+     */
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & archive) const
+    {
+        std::unordered_map<std::string_view, uint32_t> directory_ids{};
+        std::string directories{};
+        std::vector<uint64_t> directory_offsets{0u};
+        std::string file_names{};
+        std::vector<uint64_t> file_name_offsets{0u};
+        std::vector<uint32_t> path_directories(number_of_paths());
+
+        for (size_t path_id = 0; path_id < number_of_paths(); ++path_id)
+        {
+            std::string_view const full_path = path(path_id);
+            // The directory keeps its trailing '/'. A path without '/' has the empty directory.
+            size_t const split = full_path.rfind('/') + 1u;
+            auto [it, inserted] = directory_ids.try_emplace(full_path.substr(0u, split), directory_ids.size());
+            if (inserted)
+            {
+                directories.append(it->first);
+                directory_offsets.push_back(directories.size());
+            }
+            path_directories[path_id] = it->second;
+            file_names.append(full_path.substr(split));
+            file_name_offsets.push_back(file_names.size());
+        }
+
+        archive(user_bin_offsets_);
+        archive(directories);
+        archive(directory_offsets);
+        archive(file_names);
+        archive(file_name_offsets);
+        archive(path_directories);
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & archive)
+    {
+        std::string directories{};
+        std::vector<uint64_t> directory_offsets{};
+        std::string file_names{};
+        std::vector<uint64_t> file_name_offsets{};
+        std::vector<uint32_t> path_directories{};
+
+        archive(user_bin_offsets_);
+        archive(directories);
+        archive(directory_offsets);
+        archive(file_names);
+        archive(file_name_offsets);
+        archive(path_directories);
+
+        size_t const paths = path_directories.size();
+        size_t const number_of_directories = directory_offsets.size() - 1u;
+        // Checked before the paths are assembled, because the offsets are used without bounds checks.
+        if (!is_valid_offsets(directory_offsets, directories.size())
+            || !is_valid_offsets(file_name_offsets, file_names.size()) || file_name_offsets.size() != paths + 1u
+            || !is_valid_offsets(user_bin_offsets_, paths)
+            || std::ranges::any_of(path_directories,
+                                   [&](uint32_t const id)
+                                   {
+                                       return id >= number_of_directories;
+                                   }))
+            throw std::runtime_error{"The bin paths are corrupted."};
+
+        size_t characters{file_names.size()};
+        for (uint32_t const id : path_directories)
+            characters += directory_offsets[id + 1u] - directory_offsets[id];
+
+        characters_.clear();
+        characters_.reserve(characters);
+        path_offsets_.clear();
+        path_offsets_.reserve(paths + 1u);
+        path_offsets_.push_back(0u);
+
+        std::string_view const directory_view{directories};
+        std::string_view const file_name_view{file_names};
+        for (size_t path_id = 0; path_id < paths; ++path_id)
+        {
+            uint32_t const id = path_directories[path_id];
+            characters_.append(
+                directory_view.substr(directory_offsets[id], directory_offsets[id + 1u] - directory_offsets[id]));
+            characters_.append(file_name_view.substr(file_name_offsets[path_id],
+                                                     file_name_offsets[path_id + 1u] - file_name_offsets[path_id]));
+            path_offsets_.push_back(characters_.size());
+        }
+    }
+    //!\endcond
+
+private:
+    //!\brief All paths, concatenated.
+    std::string characters_{};
+    //!\brief Path `i` is `characters_[path_offsets_[i], path_offsets_[i + 1])`.
+    std::vector<uint64_t> path_offsets_{0u};
+    //!\brief The paths of user bin `i` have the IDs `[user_bin_offsets_[i], user_bin_offsets_[i + 1])`.
+    std::vector<uint64_t> user_bin_offsets_{0u};
+
+    //!\brief Whether `offsets` start at 0, do not decrease, and end at `size`.
+    static bool is_valid_offsets(std::vector<uint64_t> const & offsets, uint64_t const size)
+    {
+        return !offsets.empty() && offsets.front() == 0u && offsets.back() == size && std::ranges::is_sorted(offsets);
+    }
+};
+
+//!\brief Iterates over the user bins of a raptor::bin_path_table.
+class bin_path_table::iterator
+{
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = user_bin_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    iterator(bin_path_table const & table, size_t const user_bin_id) noexcept :
+        table{std::addressof(table)},
+        user_bin_id{user_bin_id}
+    {}
+
+    value_type operator*() const
+    {
+        return (*table)[user_bin_id];
+    }
+
+    iterator & operator++() noexcept
+    {
+        ++user_bin_id;
+        return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+        iterator tmp{*this};
+        ++user_bin_id;
+        return tmp;
+    }
+
+    bool operator==(iterator const & other) const noexcept
+    {
+        return user_bin_id == other.user_bin_id;
+    }
+
+private:
+    bin_path_table const * table{nullptr};
+    size_t user_bin_id{};
+};
+
+inline bin_path_table::iterator bin_path_table::begin() const noexcept
+{
+    return iterator{*this, 0u};
+}
+
+inline bin_path_table::iterator bin_path_table::end() const noexcept
+{
+    return iterator{*this, size()};
+}
+
+} // namespace raptor
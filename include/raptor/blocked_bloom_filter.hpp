@@ -0,0 +1,368 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::blocked_bloom_filter.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <hibf/interleaved_bloom_filter.hpp>
+#include <hibf/misc/next_multiple_of_64.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+//!\brief An allocator that default-initialises instead of value-initialising, i.e., `resize` does not zero integers.
+template <typename value_t>
+class default_init_allocator : public std::allocator<value_t>
+{
+public:
+    template <typename other_t>
+    struct rebind
+    {
+        using other = default_init_allocator<other_t>;
+    };
+
+    using std::allocator<value_t>::allocator;
+
+    template <typename other_t>
+    void construct(other_t * const pointer) noexcept(std::is_nothrow_default_constructible_v<other_t>)
+    {
+        ::new (static_cast<void *>(pointer)) other_t;
+    }
+
+    template <typename other_t, typename... args_t>
+    void construct(other_t * const pointer, args_t &&... args)
+    {
+        ::new (static_cast<void *>(pointer)) other_t(std::forward<args_t>(args)...);
+    }
+};
+
+} // namespace detail
+
+/*!\brief An interleaved Bloom filter whose hash positions of a value lie in one block.
+ * \details
+ * Like seqan::hibf::interleaved_bloom_filter, the filter consists of `bin_size` rows of `bin_count` bits, rounded up
+ * to a multiple of 64. Consecutive rows are grouped into blocks of raptor::blocked_bloom_filter::rows_per_block rows,
+ * which is about one page. A value is hashed to one block, and all `hash_function_count` rows of the value are chosen
+ * within this block. Hence, a query touches one or two pages instead of `hash_function_count` random ones.
+ *
+ * Since the rows of a block are shared by fewer values, the false positive rate is higher than for an unblocked
+ * filter of the same size. raptor::blocked_bloom_filter::bin_size_in_bits accounts for this.
+ *
+ * raptor::blocked_bloom_filter::emplace may be called concurrently.
+ *
+ * The bit vector is zeroed by `threads` threads, each zeroing a contiguous range. Hence, the page faults are spread
+ * over the threads, and on a NUMA machine, the pages are spread over the nodes of the threads. If the bit vector is
+ * overwritten right away, e.g., when it is read from an index, it may be left uninitialised instead.
+ */
+class blocked_bloom_filter
+{
+public:
+    class membership_agent_type;
+
+    //!\brief The number of bits a block should have.
+    static constexpr size_t block_bits{4096u * 8u};
+    //!\brief The minimum number of rows in a block. Fewer rows would increase the false positive rate too much.
+    static constexpr size_t min_rows_per_block{64u};
+
+    //!\brief Selects the constructor that does not initialise the bit vector.
+    struct uninitialised_t
+    {};
+    static constexpr uninitialised_t uninitialised{};
+
+    blocked_bloom_filter() = default;
+    blocked_bloom_filter(blocked_bloom_filter const &) = default;
+    blocked_bloom_filter(blocked_bloom_filter &&) = default;
+    blocked_bloom_filter & operator=(blocked_bloom_filter const &) = default;
+    blocked_bloom_filter & operator=(blocked_bloom_filter &&) = default;
+    ~blocked_bloom_filter() = default;
+
+    //!\brief The bin size is rounded up to a multiple of raptor::blocked_bloom_filter::rows_per_block.
+    blocked_bloom_filter(seqan::hibf::bin_count const bins_,
+                         seqan::hibf::bin_size const size,
+                         seqan::hibf::hash_function_count const funs,
+                         uint8_t const threads = 1u) :
+        blocked_bloom_filter{bins_, size, funs, uninitialised}
+    {
+        size_t const thread_count = std::max<size_t>(threads, 1u);
+        size_t const chunk_words = (words.size() + thread_count - 1u) / thread_count;
+
+#pragma omp parallel for schedule(static) num_threads(thread_count)
+        for (size_t thread = 0; thread < thread_count; ++thread)
+        {
+            size_t const begin = std::min(thread * chunk_words, words.size());
+            std::fill_n(words.begin() + begin, std::min(chunk_words, words.size() - begin), 0u);
+        }
+    }
+
+    //!\brief Like the other constructor, but the bit vector is not initialised. Every word must be written.
+    blocked_bloom_filter(seqan::hibf::bin_count const bins_,
+                         seqan::hibf::bin_size const size,
+                         seqan::hibf::hash_function_count const funs,
+                         uninitialised_t) :
+        bins{bins_.value},
+        hash_funs{funs.value},
+        block_rows{rows_per_block(bins)},
+        bin_words{seqan::hibf::next_multiple_of_64(bins) / 64u}
+    {
+        if (bins == 0u)
+            throw std::logic_error{"The number of bins must be > 0."};
+        if (size.value == 0u)
+            throw std::logic_error{"The size of a bin must be > 0."};
+        if (hash_funs == 0u || hash_funs > 5u)
+            throw std::logic_error{"The number of hash functions must be > 0 and <= 5."};
+
+        blocks = (size.value + block_rows - 1u) / block_rows;
+        words.resize(blocks * block_rows * bin_words);
+    }
+
+    //!\brief The number of rows in a block for `bins` user bins. Always a power of two.
+    static constexpr size_t rows_per_block(size_t const bins) noexcept
+    {
+        size_t const row_bits = seqan::hibf::next_multiple_of_64(std::max<size_t>(bins, 1u));
+        return std::max(min_rows_per_block, std::bit_floor(block_bits / row_bits));
+    }
+
+    /*!\brief The false positive rate of a bin with `elements` values.
+     * \details
+     * The number of values in a block is Poisson distributed with mean `elements * rows_per_block / bin_size`.
+     * A value sets `hash_count` distinct rows of its block, i.e., a row is not set by a value with probability
+     * `1 - hash_count / rows_per_block`.
+     */
+    static double false_positive_rate(size_t const bin_size,
+                                      size_t const rows_per_block,
+                                      size_t const hash_count,
+                                      size_t const elements)
+    {
+        if (elements == 0u)
+            return 0.0;
+
+        double const mean = static_cast<double>(elements) * rows_per_block / bin_size;
+        double const log_mean = std::log(mean);
+        double const log_row_empty = std::log1p(-static_cast<double>(hash_count) / rows_per_block);
+        double const spread = 12.0 * std::sqrt(mean) + 12.0;
+        size_t const first = static_cast<size_t>(std::max(0.0, mean - spread));
+        size_t const last = static_cast<size_t>(mean + spread);
+
+        double result{};
+        for (size_t i = first; i <= last; ++i)
+        {
+            double const probability = std::exp(i * log_mean - mean - std::lgamma(i + 1.0));
+            double const row_set = -std::expm1(i * log_row_empty);
+            result += probability * std::pow(row_set, hash_count);
+        }
+        return std::min(result, 1.0);
+    }
+
+    //!\brief The bin size (in bits) needed for a false positive rate of `fpr` with `elements` values.
+    static size_t bin_size_in_bits(double const fpr, size_t const hash_count, size_t const elements, size_t const bins)
+    {
+        size_t const rows = rows_per_block(bins);
+        auto round_up = [rows](double const bits) -> size_t
+        {
+            size_t const blocks = std::max<size_t>(1u, std::ceil(bits / rows));
+            return blocks * rows;
+        };
+
+        // The size of an unblocked Bloom filter is a lower bound.
+        double const unblocked = -static_cast<double>(hash_count * elements)
+                               / std::log1p(-std::exp(std::log(fpr) / hash_count));
+        size_t size = round_up(unblocked);
+        while (false_positive_rate(size, rows, hash_count, elements) > fpr)
+            size = round_up(size * 1.02);
+        return size;
+    }
+
+    //!\brief Inserts `value` into `bin`. Thread-safe.
+    void emplace(size_t const value, seqan::hibf::bin_index const bin) noexcept
+    {
+        assert(bin.value < bins);
+        uint64_t const bit = 1ULL << (bin.value % 64u);
+        for_each_row(value,
+                     [&](size_t const row)
+                     {
+                         std::atomic_ref<uint64_t>{words[row * bin_words + bin.value / 64u]}.fetch_or(
+                             bit,
+                             std::memory_order_relaxed);
+                     });
+    }
+
+    size_t hash_function_count() const noexcept
+    {
+        return hash_funs;
+    }
+
+    size_t bin_count() const noexcept
+    {
+        return bins;
+    }
+
+    size_t bin_size() const noexcept
+    {
+        return blocks * block_rows;
+    }
+
+    size_t bit_size() const noexcept
+    {
+        return words.size() * 64u;
+    }
+
+    uint64_t * data() noexcept
+    {
+        return words.data();
+    }
+
+    uint64_t const * data() const noexcept
+    {
+        return words.data();
+    }
+
+    membership_agent_type membership_agent() const;
+
+    bool operator==(blocked_bloom_filter const &) const = default;
+
+    /*!\cond DEV
+     * \brief Serialisation support function.
+     * \tparam archive_t Type of `archive`; must satisfy seqan3::cereal_archive.
+     * \param[in] archive The archive being serialised from/to.
+     *
+     * \attention These functions are never called directly.
+     * \sa https://docs.seqan.de/seqan/3.2.0/group__io.html#serialisation
+     */
+    template <typename archive_t>
+    void CEREAL_SERIALIZE_FUNCTION_NAME(archive_t & archive)
+    {
+        archive(bins);
+        archive(hash_funs);
+        archive(block_rows);
+        archive(bin_words);
+        archive(blocks);
+        archive(words);
+    }
+    //!\endcond
+
+private:
+    size_t bins{};
+    size_t hash_funs{};
+    size_t block_rows{};
+    size_t bin_words{};
+    size_t blocks{};
+    //!\brief Not value-initialised; the constructor zeroes it in parallel, and loading overwrites it.
+    std::vector<uint64_t, detail::default_init_allocator<uint64_t>> words{};
+
+    /* Calls `callback(row)` for the `hash_funs` distinct rows of `value`.
+     * The upper bits of the hash select the block. Within the block, the rows are chosen by double hashing with an odd
+     * step. Since the number of rows in a block is a power of two, the rows are distinct.
+     */
+    template <typename callback_t>
+    void for_each_row(uint64_t const value, callback_t && callback) const noexcept
+    {
+        uint64_t hash = value * 0x9E3779B97F4A7C15ULL;
+        size_t const block = static_cast<uint64_t>((static_cast<__uint128_t>(hash) * blocks) >> 64);
+        hash ^= hash >> 29;
+        hash *= 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 32;
+
+        size_t const mask = block_rows - 1u;
+        size_t const first_row = block * block_rows;
+        size_t const step = (hash >> 32) | 1u;
+        size_t offset = hash;
+        for (size_t i = 0; i < hash_funs; ++i, offset += step)
+            callback(first_row + (offset & mask));
+    }
+};
+
+/*!\brief Counts the occurrences of values in the user bins of a raptor::blocked_bloom_filter.
+ * \details
+ * Provides the same interface as the membership agent of seqan::hibf::interleaved_bloom_filter.
+ */
+class blocked_bloom_filter::membership_agent_type
+{
+public:
+    membership_agent_type() = default;
+    membership_agent_type(membership_agent_type const &) = default;
+    membership_agent_type(membership_agent_type &&) = default;
+    membership_agent_type & operator=(membership_agent_type const &) = default;
+    membership_agent_type & operator=(membership_agent_type &&) = default;
+    ~membership_agent_type() = default;
+
+    explicit membership_agent_type(blocked_bloom_filter const & filter) :
+        filter{std::addressof(filter)},
+        counts(filter.bin_words * 64u),
+        row(filter.bin_words)
+    {}
+
+    //!\brief Returns the user bins that contain at least `threshold` of the `values`.
+    template <std::ranges::range value_range_t>
+    [[nodiscard]] std::vector<uint64_t> const & membership_for(value_range_t && values, size_t const threshold) &
+    {
+        assert(filter != nullptr);
+        std::ranges::fill(counts, 0u);
+
+        for (uint64_t const value : values)
+        {
+            bool first{true};
+            filter->for_each_row(value,
+                                 [&](size_t const row_index)
+                                 {
+                                     uint64_t const * const words = filter->words.data() + row_index * row.size();
+                                     if (first)
+                                         std::ranges::copy_n(words, row.size(), row.begin());
+                                     else
+                                         for (size_t i = 0; i < row.size(); ++i)
+                                             row[i] &= words[i];
+                                     first = false;
+                                 });
+
+            for (size_t i = 0; i < row.size(); ++i)
+                for (uint64_t word = row[i]; word != 0u; word &= word - 1u)
+                    ++counts[i * 64u + std::countr_zero(word)];
+        }
+
+        result.clear();
+        for (size_t bin = 0; bin < filter->bins; ++bin)
+            if (counts[bin] >= threshold)
+                result.push_back(bin);
+
+        return result;
+    }
+
+    // `membership_for` must not be called on a temporary agent.
+    template <std::ranges::range value_range_t>
+    [[nodiscard]] std::vector<uint64_t> const & membership_for(value_range_t && values,
+                                                               size_t const threshold) && = delete;
+
+private:
+    blocked_bloom_filter const * filter{nullptr};
+    std::vector<uint32_t> counts{};
+    std::vector<uint64_t> row{};
+    std::vector<uint64_t> result{};
+};
+
+inline blocked_bloom_filter::membership_agent_type blocked_bloom_filter::membership_agent() const
+{
+    return membership_agent_type{*this};
+}
+
+} // namespace raptor
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::build_checkpoint.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <hibf/interleaved_bloom_filter.hpp>
+
+#include <raptor/argument_parsing/build_arguments.hpp>
+
+namespace raptor
+{
+
+/*!\brief Periodically writes a partially filled IBF and its finished user bins to `<output>.checkpoint`.
+ * \details
+ * After raptor::build_checkpoint::start, a background thread writes a checkpoint every
+ * `build_arguments::checkpoint_interval` seconds. The threads filling the IBF are not blocked: only the list of
+ * finished user bins is copied under a lock, and the IBF is copied while it is being filled. Hence, a checkpoint
+ * contains all k-mers of the finished user bins, and possibly some k-mers of other user bins. Since inserting a k-mer
+ * twice does not change the IBF, these user bins are inserted again when resuming.
+ *
+ * A checkpoint is written to a temporary file that is then renamed; an interrupted run keeps the previous checkpoint.
+ * It is only used if the input files and the options that determine the IBF did not change.
+ */
+class build_checkpoint
+{
+public:
+    build_checkpoint() = delete;
+    build_checkpoint(build_checkpoint const &) = delete;
+    build_checkpoint & operator=(build_checkpoint const &) = delete;
+    build_checkpoint(build_checkpoint &&) = delete;
+    build_checkpoint & operator=(build_checkpoint &&) = delete;
+    ~build_checkpoint();
+
+    /*!\brief Loads the checkpoint into `ibf` if `build_arguments::resume` is set and a checkpoint exists.
+     * \throws std::runtime_error if the checkpoint was written for different input files or options.
+     */
+    build_checkpoint(build_arguments const & arguments, seqan::hibf::interleaved_bloom_filter & ibf);
+
+    //!\brief Returns the path of the checkpoint file.
+    static std::filesystem::path path(build_arguments const & arguments);
+
+    //!\brief Whether the user bin was loaded from the checkpoint. Only valid before start().
+    bool is_finished(size_t const bin_number) const
+    {
+        return finished[bin_number] != 0u;
+    }
+
+    //!\brief Starts writing checkpoints. Does nothing if `build_arguments::checkpoint_interval` is 0.
+    void start();
+
+    //!\brief Marks the user bin as completely inserted. Thread-safe.
+    void finish_bin(size_t const bin_number);
+
+    //!\brief Stops writing checkpoints. A checkpoint that is currently written is discarded.
+    void stop();
+
+private:
+    std::filesystem::path file{};
+    std::string key{};
+    uint64_t interval{};
+    uint64_t * data{nullptr};
+    size_t words{};
+    std::vector<uint8_t> finished{};
+
+    std::mutex mutex{};
+    std::condition_variable stop_requested{};
+    std::atomic<bool> stopping{false};
+    std::thread writer{};
+
+    void load();
+    void run();
+    void write(std::vector<uint8_t> const & snapshot) const;
+};
+
+} // namespace raptor
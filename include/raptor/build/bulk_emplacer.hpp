@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::bulk_emplacer.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include <hibf/interleaved_bloom_filter.hpp>
+#include <hibf/misc/next_multiple_of_64.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+/*!\brief Computes the rows of a value in a seqan::hibf::interleaved_bloom_filter.
+ * \details
+ * The bit of a value in bin `b` is `row * technical_bins + b`, where `technical_bins` is the number of bins rounded up
+ * to a multiple of 64. The rows are computed as in seqan::hibf::interleaved_bloom_filter::emplace; the unit test
+ * `bulk_emplacer` checks that both agree.
+ */
+class ibf_rows
+{
+public:
+    ibf_rows() = default;
+    ibf_rows(ibf_rows const &) = default;
+    ibf_rows(ibf_rows &&) = default;
+    ibf_rows & operator=(ibf_rows const &) = default;
+    ibf_rows & operator=(ibf_rows &&) = default;
+    ~ibf_rows() = default;
+
+    explicit ibf_rows(seqan::hibf::interleaved_bloom_filter const & ibf) :
+        bin_size{ibf.bin_size()},
+        hash_shift{static_cast<uint8_t>(std::countl_zero(bin_size))},
+        hash_funs{static_cast<uint8_t>(ibf.hash_function_count())}
+    {
+        assert(hash_funs <= seeds.size());
+    }
+
+    //!\brief Calls `callback(row)` for each hash function.
+    template <typename callback_t>
+    void for_each(uint64_t const value, callback_t && callback) const noexcept
+    {
+        for (size_t i = 0; i < hash_funs; ++i)
+        {
+            uint64_t hash = value * seeds[i];
+            hash ^= hash >> hash_shift;
+            hash *= 11400714819323198485ULL;
+            callback(static_cast<uint64_t>((static_cast<__uint128_t>(hash) * bin_size) >> 64));
+        }
+    }
+
+private:
+    // The seeds and `hash_and_fit` of seqan::hibf::interleaved_bloom_filter as of hibf commit
+    // a0d554a8c60bed9697b757bf4f8ff983a3493226, i.e., RAPTOR_HIBF_VERSION in cmake/package-lock.cmake.
+    // Check them when updating hibf.
+    static constexpr std::array<uint64_t, 5> seeds{13572355802537770549ULL,
+                                                   13043817825332782213ULL,
+                                                   10650232656628343401ULL,
+                                                   16499269484942379435ULL,
+                                                   4893150838803335377ULL};
+
+    uint64_t bin_size{};
+    uint8_t hash_shift{};
+    uint8_t hash_funs{};
+};
+
+} // namespace detail
+
+/*!\brief Inserts values into a bin of a seqan::hibf::interleaved_bloom_filter in blocks.
+ * \details
+ * Each value sets `hash_function_count` bits at random positions of the bit vector. For a large IBF, nearly every bit
+ * is a cache and TLB miss. Instead, the rows of up to `block_size` values are buffered and bucketed by their most
+ * significant bits. The buckets are written in ascending order, hence consecutive writes are close to each other, and
+ * the words are prefetched a few writes ahead. Sorting within the buckets costs more than it saves.
+ *
+ * Since the bin is fixed, all bits of a block are in the same column of 64 bins and use the same mask. The words are
+ * set with an atomic OR, hence multiple emplacers may fill the same IBF concurrently.
+ * The values are only guaranteed to be in the IBF after raptor::bulk_emplacer::flush or the destructor.
+ *
+ * Provides `push_back` to be used with std::back_inserter.
+ */
+class bulk_emplacer
+{
+public:
+    using value_type = uint64_t;
+
+    //!\brief The default number of values that are buffered.
+    static constexpr size_t default_block_size{1ULL << 16};
+    //!\brief The number of buckets is at most `2^bucket_bits`.
+    static constexpr size_t bucket_bits{12u};
+    //!\brief The number of writes that a word is prefetched ahead.
+    static constexpr size_t prefetch_distance{16u};
+
+    bulk_emplacer() = delete;
+    bulk_emplacer(bulk_emplacer const &) = delete;
+    bulk_emplacer(bulk_emplacer &&) = default;
+    bulk_emplacer & operator=(bulk_emplacer const &) = delete;
+    bulk_emplacer & operator=(bulk_emplacer &&) = delete;
+
+    ~bulk_emplacer()
+    {
+        flush();
+    }
+
+    bulk_emplacer(seqan::hibf::interleaved_bloom_filter & ibf,
+                  seqan::hibf::bin_index const bin,
+                  size_t const block_size = default_block_size) :
+        words{reinterpret_cast<uint64_t *>(ibf.data())},
+        rows_of{ibf},
+        words_per_row{seqan::hibf::next_multiple_of_64(ibf.bin_count()) / 64u},
+        column{bin.value / 64u},
+        mask{1ULL << (bin.value % 64u)},
+        capacity{std::max<size_t>(block_size, 1u) * ibf.hash_function_count()}
+    {
+        assert(bin.value < ibf.bin_count());
+        uint64_t const bin_size = ibf.bin_size();
+        uint8_t const bin_size_bits = std::bit_width(bin_size - 1u);
+        bucket_shift = bin_size_bits > bucket_bits ? bin_size_bits - bucket_bits : 0u;
+        bucket_offsets.resize(((bin_size - 1u) >> bucket_shift) + 2u);
+    }
+
+    void push_back(uint64_t const value)
+    {
+        rows_of.for_each(value,
+                         [this](uint64_t const row)
+                         {
+                             rows.push_back(row);
+                         });
+
+        if (rows.size() >= capacity)
+            flush();
+    }
+
+    //!\brief Writes all buffered values to the IBF.
+    void flush()
+    {
+        if (rows.empty())
+            return;
+
+        // Counting sort by bucket. The buffers keep their capacity, hence nothing is allocated after the first flush.
+        std::ranges::fill(bucket_offsets, 0u);
+        for (uint64_t const row : rows)
+            ++bucket_offsets[(row >> bucket_shift) + 1u];
+        for (size_t i = 1; i < bucket_offsets.size(); ++i)
+            bucket_offsets[i] += bucket_offsets[i - 1u];
+
+        bucketed_rows.resize(rows.size());
+        for (uint64_t const row : rows)
+            bucketed_rows[bucket_offsets[row >> bucket_shift]++] = row;
+        rows.clear();
+
+        size_t const size = bucketed_rows.size();
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (i + prefetch_distance < size)
+                __builtin_prefetch(word(bucketed_rows[i + prefetch_distance]), 1);
+            std::atomic_ref<uint64_t>{*word(bucketed_rows[i])}.fetch_or(mask, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    uint64_t * words{nullptr};
+    detail::ibf_rows rows_of{};
+    size_t words_per_row{};
+    size_t column{};
+    uint64_t mask{};
+    size_t capacity{};
+    uint8_t bucket_shift{};
+    std::vector<uint64_t> rows{};
+    std::vector<uint64_t> bucketed_rows{};
+    std::vector<size_t> bucket_offsets{};
+
+    uint64_t * word(uint64_t const row) const noexcept
+    {
+        return words + row * words_per_row + column;
+    }
+};
+
+} // namespace raptor
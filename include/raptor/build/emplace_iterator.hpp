@@ -14,6 +14,8 @@
 namespace raptor
 {
 
+//!\brief Inserts values into a bin of a seqan::hibf::interleaved_bloom_filter or a raptor::blocked_bloom_filter.
+template <typename ibf_t = seqan::hibf::interleaved_bloom_filter>
 class emplace_iterator
 {
 public:
@@ -30,7 +32,7 @@ public:
     emplace_iterator & operator=(emplace_iterator &&) = default;
     ~emplace_iterator() = default;
 
-    explicit constexpr emplace_iterator(seqan::hibf::interleaved_bloom_filter & ibf, seqan::hibf::bin_index const idx) :
+    explicit constexpr emplace_iterator(ibf_t & ibf, seqan::hibf::bin_index const idx) :
         ibf{std::addressof(ibf)},
         index{idx}
     {}
@@ -58,14 +60,14 @@ public:
     }
 
 private:
-    seqan::hibf::interleaved_bloom_filter * ibf{nullptr};
+    ibf_t * ibf{nullptr};
     seqan::hibf::bin_index index{};
 };
 
-[[nodiscard]] inline constexpr emplace_iterator emplacer(seqan::hibf::interleaved_bloom_filter & ibf,
-                                                         seqan::hibf::bin_index const idx)
+template <typename ibf_t>
+[[nodiscard]] inline constexpr emplace_iterator<ibf_t> emplacer(ibf_t & ibf, seqan::hibf::bin_index const idx)
 {
-    return emplace_iterator{ibf, idx};
+    return emplace_iterator<ibf_t>{ibf, idx};
 }
 
 } // namespace raptor
@@ -12,12 +12,17 @@
 #include <seqan3/search/views/minimiser_hash.hpp>
 
 #include <raptor/adjust_seed.hpp>
+#include <raptor/build/build_checkpoint.hpp>
+#include <raptor/build/bulk_emplacer.hpp>
 #include <raptor/build/emplace_iterator.hpp>
 #include <raptor/build/partition_config.hpp>
-#include <raptor/call_parallel_on_bins.hpp>
+#include <raptor/build/partition_spill.hpp>
+#include <raptor/call_parallel_on_bin_slices.hpp>
 #include <raptor/dna4_traits.hpp>
 #include <raptor/file_reader.hpp>
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -37,7 +42,8 @@ public:
         if (arguments->input_is_minimiser)
             reader = file_reader<file_types::minimiser>{};
         else
-            reader = file_reader<file_types::sequence>{arguments->shape, arguments->window_size};
+            reader = file_reader<file_types::sequence>{arguments->shape, arguments->window_size, arguments->sketch};
+        init_bin_range();
     }
 
     explicit index_factory(build_arguments const & args, partition_config const & cfg) :
@@ -47,7 +53,8 @@ public:
         if (arguments->input_is_minimiser)
             reader = file_reader<file_types::minimiser>{}; // GCOVR_EXCL_LINE
         else
-            reader = file_reader<file_types::sequence>{arguments->shape, arguments->window_size};
+            reader = file_reader<file_types::sequence>{arguments->shape, arguments->window_size, arguments->sketch};
+        init_bin_range();
     }
 
     [[nodiscard]] raptor_index<> operator()(size_t const part = 0u) const
@@ -55,50 +62,271 @@ public:
         return construct(part);
     }
 
+    /*!\brief Constructs all parts of a partitioned index while reading the input once.
+     * \param[in] bits_per_part The `build_arguments::bits` of each part.
+     */
+    [[nodiscard]] std::vector<raptor_index<>> construct_all_parts(std::vector<uint64_t> const & bits_per_part) const
+    {
+        assert(arguments != nullptr);
+        assert(config != nullptr);
+        assert(bits_per_part.size() == config->partitions);
+
+        arguments->index_allocation_timer.start();
+        trace_scope index_allocation_trace{"Index allocation", "build"};
+        // The parts are allocated concurrently, hence their bit vectors are zeroed concurrently.
+        std::vector<raptor_index<>> indices(bits_per_part.size());
+        detail::parallel_for_each_section(indices.size(),
+                                          arguments->threads,
+                                          [&](size_t const part)
+                                          {
+                                              indices[part] = raptor_index<>{*arguments, bits_per_part[part]};
+                                          });
+        std::vector<seqan::hibf::interleaved_bloom_filter *> ibfs{};
+        for (raptor_index<> & index : indices)
+            ibfs.push_back(std::addressof(index.ibf()));
+        index_allocation_trace.stop();
+        arguments->index_allocation_timer.stop();
+
+        for_each_slice(
+            [&](auto const & reader, auto const & slice, size_t const bin_number)
+            {
+                // The buffers of all parts together have the size of one default buffer.
+                size_t const block_size = bulk_emplacer::default_block_size / ibfs.size();
+                std::vector<bulk_emplacer> inserters{};
+                inserters.reserve(ibfs.size());
+                for (seqan::hibf::interleaved_bloom_filter * const ibf : ibfs)
+                    inserters.emplace_back(*ibf, seqan::hibf::bin_index{bin_number}, block_size);
+
+                reader.for_each_hash(slice,
+                                     [&](uint64_t const hash)
+                                     {
+                                         inserters[config->hash_partition(hash)].push_back(hash);
+                                     });
+
+                for (bulk_emplacer & inserter : inserters)
+                    inserter.flush();
+            },
+            true);
+
+        return indices;
+    }
+
+    //!\brief Constructs an index with a raptor::blocked_bloom_filter. Parts and checkpoints are not supported.
+    [[nodiscard]] raptor_index<index_structure::blocked_ibf> construct_blocked_ibf() const
+    {
+        assert(arguments != nullptr);
+        assert(config == nullptr);
+
+        arguments->index_allocation_timer.start();
+        trace_scope index_allocation_trace{"Index allocation", "build"};
+        raptor_index<index_structure::blocked_ibf> index{*arguments};
+        index_allocation_trace.stop();
+        arguments->index_allocation_timer.stop();
+
+        auto & ibf = index.ibf();
+        for_each_slice(
+            [&](auto const & reader, auto const & slice, size_t const bin_number)
+            {
+                reader.hash_into(slice, emplacer(ibf, seqan::hibf::bin_index{bin_number}));
+            },
+            true);
+
+        return index;
+    }
+
+    //!\brief Writes the minimisers of all user bins to the spill files of their parts while reading the input once.
+    void spill_all_parts(partition_spill & spill) const
+    {
+        assert(config != nullptr);
+
+        for_each_slice(
+            [&](auto const & reader, auto const & slice, size_t const bin_number)
+            {
+                std::vector<std::vector<uint64_t>> buffers(config->partitions);
+
+                auto flush = [&](size_t const part)
+                {
+                    // Duplicates are removed to reduce the size of the spill files.
+                    std::vector<uint64_t> & buffer = buffers[part];
+                    std::ranges::sort(buffer);
+                    buffer.erase(std::ranges::unique(buffer).begin(), buffer.end());
+                    spill.write(part, bin_number, buffer);
+                    buffer.clear();
+                };
+
+                reader.for_each_hash(slice,
+                                     [&](uint64_t const hash)
+                                     {
+                                         size_t const part = config->hash_partition(hash);
+                                         buffers[part].push_back(hash);
+                                         if (buffers[part].size() == partition_spill::block_size)
+                                             flush(part);
+                                     });
+
+                for (size_t part = 0; part < config->partitions; ++part)
+                    flush(part);
+            },
+            false);
+
+        spill.finish();
+    }
+
+    /*!\brief Constructs a part from the spill files.
+     * \param[in] spill The spill files written by raptor::index_factory::spill_all_parts.
+     * \param[in] part The part to construct.
+     * \param[in] bits The `build_arguments::bits` of the part.
+     */
+    [[nodiscard]] raptor_index<> construct_from_spill(partition_spill const & spill,
+                                                      size_t const part,
+                                                      uint64_t const bits) const
+    {
+        assert(arguments != nullptr);
+
+        arguments->index_allocation_timer.start();
+        trace_scope index_allocation_trace{"Index allocation", "build"};
+        raptor_index<> index{*arguments, bits};
+        index_allocation_trace.stop();
+        arguments->index_allocation_timer.stop();
+
+        auto & ibf = index.ibf();
+        arguments->fill_ibf_timer.start();
+        trace_scope fill_ibf_trace{"Fill IBF", "build", "part", part};
+        spill.for_each_block(part,
+                             arguments->threads,
+                             [&](uint64_t const bin_number, std::span<uint64_t const> const hashes)
+                             {
+                                 bulk_emplacer inserter{ibf, seqan::hibf::bin_index{bin_number}};
+                                 std::ranges::copy(hashes, std::back_inserter(inserter));
+                                 inserter.flush();
+                             });
+        fill_ibf_trace.stop();
+        arguments->fill_ibf_timer.stop();
+
+        return index;
+    }
+
 private:
     build_arguments const * const arguments{nullptr};
     partition_config const * const config{nullptr};
     std::variant<file_reader<file_types::sequence>, file_reader<file_types::minimiser>> reader;
+    // With a bin range, the user bins outside of the range have no files.
+    std::vector<std::vector<std::string>> bin_range_path{};
 
-    raptor_index<> construct(size_t const part) const
+    void init_bin_range()
     {
-        assert(arguments != nullptr);
+        if (!arguments->has_bin_range())
+            return;
 
-        arguments->index_allocation_timer.start();
-        raptor_index<> index{*arguments};
-        arguments->index_allocation_timer.stop();
+        bin_range_path.resize(arguments->bin_path.size());
+        for (size_t bin = arguments->bin_range_begin; bin < arguments->bin_range_end; ++bin)
+            bin_range_path[bin] = arguments->bin_path[bin];
+    }
 
-        auto worker = [&](auto && zipped_view)
+    std::vector<std::vector<std::string>> const & bin_paths() const
+    {
+        return arguments->has_bin_range() ? bin_range_path : arguments->bin_path;
+    }
+
+    template <typename on_slice_t>
+    void for_each_slice(on_slice_t && on_slice, bool const fills_ibf) const
+    {
+        for_each_slice(std::forward<on_slice_t>(on_slice), fills_ibf, bin_paths(), detail::ignore_bin{});
+    }
+
+    /* Calls `on_slice(reader, slice, bin_number)` for all slices of the user bins in `paths` in parallel, and
+     * `on_bin_done(bin_number)` once all slices of a user bin are processed.
+     * The time is added to the user bin I/O timer, and, if `fills_ibf` is true, to the fill IBF timer.
+     */
+    template <typename on_slice_t, typename on_bin_done_t>
+    void for_each_slice(on_slice_t && on_slice,
+                        bool const fills_ibf,
+                        std::vector<std::vector<std::string>> const & paths,
+                        on_bin_done_t && on_bin_done) const
+    {
+        assert(arguments != nullptr);
+
+        auto worker = [&](auto const & reader, auto const & slice, size_t const bin_number)
         {
             seqan::hibf::serial_timer local_timer{};
-            auto & ibf = index.ibf();
+            perf_counter_group const counter_group{arguments->perf_counters};
+            serial_perf_counters local_counters{counter_group};
             local_timer.start();
-            // https://godbolt.org/z/PeKnxzjn1
-            for (auto && zipped : zipped_view)
+            local_counters.start();
+            on_slice(reader, slice, bin_number);
+            local_counters.stop();
+            local_timer.stop();
+            arguments->user_bin_io_timer += local_timer;
+            if (fills_ibf)
+                arguments->fill_ibf_timer += local_timer;
+            arguments->user_bin_io_counters += local_counters;
+        };
+
+        // Large user bins are split into slices that are processed concurrently.
+        std::visit(
+            [&](auto const & reader)
             {
-                std::visit(
-                    [&](auto const & reader)
+                call_parallel_on_bin_slices(
+                    [&](auto const & slice, size_t const bin_number)
                     {
-                        auto && [file_names, bin_number] = zipped;
-
-                        if (config == nullptr)
-                            reader.hash_into(file_names, emplacer(ibf, seqan::hibf::bin_index{bin_number}));
-                        else
-                            reader.hash_into_if(file_names,
-                                                emplacer(ibf, seqan::hibf::bin_index{bin_number}),
-                                                [&](uint64_t const hash)
-                                                {
-                                                    return config->hash_partition(hash) == part;
-                                                });
+                        worker(reader, slice, bin_number);
                     },
-                    reader);
-            }
-            local_timer.stop();
-            arguments->user_bin_io_timer += local_timer;
-            arguments->fill_ibf_timer += local_timer;
+                    reader,
+                    paths,
+                    arguments->threads,
+                    default_slice_size(reader),
+                    on_bin_done);
+            },
+            reader);
+    }
+
+    raptor_index<> construct(size_t const part) const
+    {
+        assert(arguments != nullptr);
+
+        arguments->index_allocation_timer.start();
+        trace_scope index_allocation_trace{"Index allocation", "build"};
+        raptor_index<> index{*arguments};
+        index_allocation_trace.stop();
+        arguments->index_allocation_timer.stop();
+
+        auto & ibf = index.ibf();
+        auto on_slice = [&](auto const & reader, auto const & slice, size_t const bin_number)
+        {
+            bulk_emplacer inserter{ibf, seqan::hibf::bin_index{bin_number}};
+            if (config == nullptr)
+                reader.hash_into(slice, std::back_inserter(inserter));
+            else
+                reader.hash_into_if(slice,
+                                    std::back_inserter(inserter),
+                                    [&](uint64_t const hash)
+                                    {
+                                        return config->hash_partition(hash) == part;
+                                    });
+            inserter.flush();
         };
 
-        call_parallel_on_bins(worker, arguments->bin_path, arguments->threads);
+        if (config != nullptr || !arguments->uses_checkpoint())
+        {
+            for_each_slice(on_slice, true);
+            return index;
+        }
+
+        // The user bins in the checkpoint are already in the IBF.
+        build_checkpoint checkpoint{*arguments, ibf};
+        std::vector<std::vector<std::string>> unfinished_paths{bin_paths()};
+        for (size_t bin_number = 0; bin_number < unfinished_paths.size(); ++bin_number)
+            if (checkpoint.is_finished(bin_number))
+                unfinished_paths[bin_number].clear();
+
+        checkpoint.start();
+        for_each_slice(on_slice,
+                       true,
+                       unfinished_paths,
+                       [&checkpoint](size_t const bin_number)
+                       {
+                           checkpoint.finish_bin(bin_number);
+                       });
+        checkpoint.stop();
 
         return index;
     }
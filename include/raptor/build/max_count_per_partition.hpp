@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,20 @@ namespace raptor
 {
 
 std::vector<size_t> max_count_per_partition(partition_config const & cfg, build_arguments const & arguments);
+
+/*!\brief Returns the k-mers of the largest user bin of each part, for the fewest parts that are accepted.
+ * \details
+ * The numbers of parts `cfg.partitions`, `2 * cfg.partitions`, ..., `max_partitions` are tried in this order. The size
+ * of the result is the number of parts. If no number of parts is accepted, the result for `max_partitions` is returned.
+ *
+ * The input is sketched only once, with `max_partitions` parts. With raptor::hash_partitioning::balanced, part `i` of
+ * `p` parts consists of the parts `i * g`, ..., `(i + 1) * g - 1` of `p * g` parts. Only the largest user bins are read
+ * again for each number of parts that is tried.
+ */
+std::vector<size_t> max_count_per_partition(partition_config const & cfg,
+                                            size_t const max_partitions,
+                                            build_arguments const & arguments,
+                                            std::function<bool(std::vector<size_t> const &)> const & accept);
 std::vector<size_t> max_count_per_partition(partition_config const & cfg, upgrade_arguments const & arguments);
 
 } // namespace raptor
@@ -12,10 +12,28 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <string_view>
+#include <unordered_map>
 
 namespace raptor
 {
 
+//!\brief How the hashes are assigned to the parts of a partitioned index.
+enum class hash_partitioning : uint8_t
+{
+    //!\brief By the lowest bits of the hash. The parts may differ a lot in size. Used by index versions before 7.
+    suffix,
+    //!\brief By equal ranges of the mixed hash. Since the mixed hashes are uniform, the parts have equal sizes.
+    balanced
+};
+
+//!\brief The names of the values of raptor::hash_partitioning.
+inline auto enumeration_names(hash_partitioning)
+{
+    return std::unordered_map<std::string_view, hash_partitioning>{{"suffix", hash_partitioning::suffix},
+                                                                   {"balanced", hash_partitioning::balanced}};
+}
+
 struct partition_config
 {
     partition_config(partition_config const &) = default;
@@ -24,7 +42,9 @@ struct partition_config
     partition_config & operator=(partition_config &&) = default;
     ~partition_config() = default;
 
-    explicit partition_config(size_t const parts) : partitions{parts}
+    explicit partition_config(size_t const parts, hash_partitioning const scheme_ = hash_partitioning::balanced) :
+        partitions{parts},
+        scheme{scheme_}
     {
         size_t const suffixes = next_power_of_four(partitions);
         size_t const suffixes_per_part = suffixes / partitions;
@@ -33,19 +53,35 @@ struct partition_config
     }
 
     size_t partitions{};
+    hash_partitioning scheme{};
     size_t mask{};
     int shift_value{};
 
-    // The number of suffixes is a power of four.
-    // The number of partitions is a power of two.
-    // The number of suffixes is greater than or equal to the number of partitions.
-    // This means that the number of suffixes per partition is always a power of two.
-    // Therefore, we can do a right shift instead of the division in:
-    // (hash & mask) / suffixes_per_part == partition
-    // The compiler cannot optimize the division to a right shift because suffixes_per_part is a runtime variable.
     constexpr size_t hash_partition(uint64_t const hash) const
     {
-        return (hash & mask) >> shift_value;
+        // The number of suffixes is a power of four.
+        // The number of partitions is a power of two.
+        // The number of suffixes is greater than or equal to the number of partitions.
+        // This means that the number of suffixes per partition is always a power of two.
+        // Therefore, we can do a right shift instead of the division in:
+        // (hash & mask) / suffixes_per_part == partition
+        // The compiler cannot optimize the division to a right shift because suffixes_per_part is a runtime variable.
+        if (scheme == hash_partitioning::suffix)
+            return (hash & mask) >> shift_value;
+
+        // The range of the mixed hash is split into `partitions` equal ranges.
+        return static_cast<uint64_t>((static_cast<__uint128_t>(mix(hash)) * partitions) >> 64);
+    }
+
+    //!\brief The finaliser of MurmurHash3. The low bits of a minimiser depend on the last bases of the k-mer.
+    static constexpr uint64_t mix(uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ULL;
+        hash ^= hash >> 33;
+        return hash;
     }
 
     static constexpr size_t next_power_of_four(size_t number)
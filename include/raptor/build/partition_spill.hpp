@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::partition_spill.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace raptor
+{
+
+/*!\brief Temporary files that store the minimisers of each part of a partitioned index.
+ * \details
+ * Each file consists of blocks. A block stores the user bin and up to `block_size` minimisers of one part.
+ * Blocks can be written concurrently and are read in parallel. The files are removed on destruction.
+ */
+class partition_spill
+{
+public:
+    //!\brief The maximum number of minimisers per block.
+    static constexpr size_t block_size{1ULL << 16};
+
+    partition_spill() = delete;
+    partition_spill(partition_spill const &) = delete;
+    partition_spill & operator=(partition_spill const &) = delete;
+    partition_spill(partition_spill &&) = delete;
+    partition_spill & operator=(partition_spill &&) = delete;
+    ~partition_spill();
+
+    /*!\brief Creates one file per part. The file of part `i` is `<prefix>_<i>.spill`.
+     * \param[in] prefix The path prefix of the files.
+     * \param[in] parts The number of parts.
+     */
+    partition_spill(std::filesystem::path const & prefix, size_t const parts);
+
+    //!\brief Appends a block. Thread-safe.
+    void write(size_t const part, uint64_t const bin, std::span<uint64_t const> const hashes);
+
+    //!\brief Flushes and closes all files. Must be called before reading.
+    void finish();
+
+    /*!\brief Calls `callback(bin, hashes)` for each block of the part in parallel.
+     * \details `hashes` is a `std::span<uint64_t const>`. Blocks of the same user bin may be processed concurrently.
+     * \throws std::runtime_error if a block cannot be read. Also rethrows the first exception of `callback`.
+     */
+    template <typename callback_t>
+    void for_each_block(size_t const part, uint8_t const threads, callback_t && callback) const
+    {
+        spill_file const & file = files[part];
+        size_t const number_of_blocks = file.block_offsets.size();
+        std::exception_ptr error{};
+        std::mutex error_mutex{};
+
+#pragma omp parallel num_threads(threads)
+        {
+            std::ifstream stream{file.path, std::ios::binary};
+            std::vector<uint64_t> hashes{};
+
+#pragma omp for schedule(dynamic)
+            for (size_t i = 0; i < number_of_blocks; ++i)
+            {
+                try
+                {
+                    uint64_t const bin = read_block(file, stream, file.block_offsets[i], hashes);
+                    callback(bin, std::span<uint64_t const>{hashes});
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> const guard{error_mutex};
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    struct spill_file
+    {
+        std::filesystem::path path{};
+        std::ofstream stream{};
+        std::mutex mutex{};
+        std::vector<uint64_t> block_offsets{};
+        uint64_t size{};
+    };
+
+    std::vector<spill_file> files{};
+
+    static uint64_t read_block(spill_file const & file,
+                               std::ifstream & stream,
+                               uint64_t const offset,
+                               std::vector<uint64_t> & hashes);
+};
+
+} // namespace raptor
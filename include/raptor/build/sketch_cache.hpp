@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::sketch_cache.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <seqan3/search/kmer_index/shape.hpp>
+
+#include <hibf/sketch/hyperloglog.hpp>
+
+#include <raptor/build/partition_config.hpp>
+#include <raptor/sketch.hpp>
+
+namespace raptor
+{
+
+/*!\brief Stores HyperLogLog sketches of user bins on disk, one file per user bin.
+ * \details
+ * An entry is identified by the paths, modification times, and sizes of the files of the user bin, as well as the
+ * shape, window size, sketch, sketch_bits, number of partitions, and partitioning. If any of them changes, the entry
+ * is not used.
+ * Hence, determining the size of an index can be skipped when, e.g., only the FPR or the number of hash functions
+ * changes.
+ * Different user bins may be loaded and stored concurrently. A default-constructed cache is disabled.
+ */
+class sketch_cache
+{
+public:
+    //!\brief The number of bits of the sketches.
+    static constexpr uint8_t sketch_bits{15u};
+
+    //!\brief The value that marks an unknown exact count.
+    static constexpr uint64_t unknown_count{std::numeric_limits<uint64_t>::max()};
+
+    struct entry
+    {
+        //!\brief One sketch per partition.
+        std::vector<seqan::hibf::sketch::hyperloglog> sketches{};
+        //!\brief The exact number of k-mers per partition. `unknown_count` if not computed.
+        std::vector<uint64_t> exact_counts{};
+    };
+
+    sketch_cache() = default;
+    sketch_cache(sketch_cache const &) = default;
+    sketch_cache & operator=(sketch_cache const &) = default;
+    sketch_cache(sketch_cache &&) = default;
+    sketch_cache & operator=(sketch_cache &&) = default;
+    ~sketch_cache() = default;
+
+    /*!\brief Creates a cache in `directory`. The directory is created if it does not exist.
+     * \param[in] directory The cache directory. If empty, the cache is disabled.
+     * \param[in] shape The shape.
+     * \param[in] window_size The window size.
+     * \param[in] partitioning The partitions, i.e., sketches per user bin, and how hashes are assigned to them.
+     * \param[in] sketch How the k-mers are chosen.
+     */
+    sketch_cache(std::filesystem::path directory,
+                 seqan3::shape const & shape,
+                 uint32_t const window_size,
+                 partition_config const & partitioning,
+                 sketch_kind const sketch = sketch_kind::minimiser);
+
+    bool is_enabled() const noexcept
+    {
+        return !directory.empty();
+    }
+
+    //!\brief Returns the entry of the user bin if it exists and is up to date.
+    std::optional<entry> load(std::vector<std::string> const & user_bin) const;
+
+    //!\brief Stores the entry of the user bin. Does nothing if the cache is disabled.
+    void store(std::vector<std::string> const & user_bin, entry const & value) const;
+
+private:
+    std::filesystem::path directory{};
+    std::string parameters{};
+    size_t partitions{};
+
+    std::string key(std::vector<std::string> const & user_bin) const;
+    std::filesystem::path file_path(std::string const & key) const;
+};
+
+} // namespace raptor
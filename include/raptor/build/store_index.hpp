@@ -10,20 +10,21 @@
 #pragma once
 
 #include <filesystem>
-#include <fstream>
 
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
 #include <raptor/strong_types.hpp>
 
 namespace raptor
 {
 
 template <typename data_t>
-static inline void store_index(std::filesystem::path const & path, raptor_index<data_t> && index)
+static inline void store_index(std::filesystem::path const & path,
+                               raptor_index<data_t> && index,
+                               uint8_t const threads = 1u,
+                               index_compression const compression = index_compression::none)
 {
-    std::ofstream os{path, std::ios::binary};
-    cereal::BinaryOutputArchive oarchive{os};
-    oarchive(index);
+    write_index_container(path, index, threads, compression);
 }
 
 } // namespace raptor
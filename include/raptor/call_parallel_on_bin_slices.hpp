@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::call_parallel_on_bin_slices.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <omp.h>
+#include <span>
+#include <vector>
+
+#include <raptor/file_reader.hpp>
+#include <raptor/trace.hpp>
+
+namespace raptor
+{
+
+//!\brief The default number of bases per slice of a sequence file.
+inline constexpr uint64_t default_bases_per_slice{1ULL << 24};
+
+//!\brief The default number of minimisers per slice of a minimiser file.
+inline constexpr uint64_t default_minimisers_per_slice{1ULL << 22};
+
+//!\brief The default slice size for files read by the reader.
+template <file_types file_type>
+constexpr uint64_t default_slice_size(file_reader<file_type> const &) noexcept
+{
+    return file_type == file_types::sequence ? default_bases_per_slice : default_minimisers_per_slice;
+}
+
+namespace detail
+{
+
+//!\brief The default for the `on_bin_done` callback of raptor::call_parallel_on_bin_slices.
+struct ignore_bin
+{
+    void operator()(size_t const) const noexcept
+    {}
+};
+
+struct bin_file
+{
+    size_t bin_number{};
+    std::string const * filename{nullptr};
+    uint64_t size{};
+};
+
+// Returns all files of all user bins, the largest file first.
+inline std::vector<bin_file> files_by_size(std::vector<std::vector<std::string>> const & bin_paths)
+{
+    std::vector<bin_file> result{};
+    for (size_t bin_number = 0; bin_number < bin_paths.size(); ++bin_number)
+    {
+        for (std::string const & filename : bin_paths[bin_number])
+        {
+            // A missing file is reported when it is read.
+            std::error_code ec{};
+            uint64_t const size = std::filesystem::file_size(filename, ec);
+            result.push_back({.bin_number = bin_number, .filename = std::addressof(filename), .size = ec ? 0u : size});
+        }
+    }
+
+    std::ranges::stable_sort(result,
+                             [](bin_file const & lhs, bin_file const & rhs)
+                             {
+                                 return lhs.size > rhs.size;
+                             });
+    return result;
+}
+
+/* Reads the sequence file and calls the worker on slices of about `bases_per_slice` bases in OpenMP tasks.
+ * Short records are collected into one slice. Long records are split into slices that overlap by
+ * `window_size - 1` bases; each window is contained in exactly one slice. Hence, the minimisers at the split points
+ * are the same as for the whole record. The last slice of short records is processed by the calling thread.
+ * `pending` counts the files of the user bin that are being read and the slices that are not yet processed. The
+ * thread that decrements it to 0 calls `on_bin_done`.
+ */
+template <typename algorithm_t, typename on_bin_done_t>
+void call_on_sequence_slices(algorithm_t & worker,
+                             bin_file const & file,
+                             uint32_t const window_size,
+                             uint64_t const bases_per_slice,
+                             std::atomic<size_t> & pending,
+                             on_bin_done_t & on_bin_done)
+{
+    using sequence_t = std::vector<seqan3::dna4>;
+    using batch_t = std::vector<sequence_t>;
+
+    size_t const bin_number = file.bin_number;
+    uint64_t const overlap = window_size > 0u ? window_size - 1u : 0u;
+    // Bounds the memory used by sequences that have been read but not processed.
+    uint64_t const max_pending_bases = 4u * omp_get_num_threads() * bases_per_slice;
+    uint64_t pending_bases{};
+
+    auto done = [&pending, &on_bin_done, bin_number]()
+    {
+        if (pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            on_bin_done(bin_number);
+    };
+
+    auto spawn = [&pending_bases, max_pending_bases, &pending, done](auto task, uint64_t const bases)
+    {
+        pending.fetch_add(1u, std::memory_order_relaxed);
+        auto task_and_done = [task, done]()
+        {
+            task();
+            done();
+        };
+#pragma omp task firstprivate(task_and_done)
+        task_and_done();
+
+        if (pending_bases += bases; pending_bases >= max_pending_bases)
+        {
+#pragma omp taskwait
+            pending_bases = 0u;
+        }
+    };
+
+    auto hash_batch = [&worker, bin_number](batch_t const & batch)
+    {
+        trace_scope const slice_trace{"Slice", "worker", "bin", bin_number, "records", batch.size()};
+        for (sequence_t const & sequence : batch)
+            std::invoke(worker, std::span<seqan3::dna4 const>{sequence}, bin_number);
+    };
+
+    file_reader<file_types::sequence>::sequence_file_t fin{*file.filename};
+    auto batch = std::make_shared<batch_t>();
+    uint64_t batch_bases{};
+
+    for (auto && record : fin)
+    {
+        sequence_t & sequence = record.sequence();
+        uint64_t const size = sequence.size();
+
+        if (size <= bases_per_slice + overlap)
+        {
+            batch->push_back(std::move(sequence));
+            if (batch_bases += size; batch_bases >= bases_per_slice)
+            {
+                spawn(
+                    [batch, hash_batch]()
+                    {
+                        hash_batch(*batch);
+                    },
+                    batch_bases);
+                batch = std::make_shared<batch_t>();
+                batch_bases = 0u;
+            }
+            continue;
+        }
+
+        auto const shared_sequence = std::make_shared<sequence_t const>(std::move(sequence));
+        for (uint64_t begin = 0; begin + overlap < size; begin += bases_per_slice)
+        {
+            uint64_t const end = std::min(size, begin + bases_per_slice + overlap);
+            spawn(
+                [shared_sequence, begin, end, bin_number, &worker]()
+                {
+                    trace_scope const slice_trace{"Slice", "worker", "bin", bin_number, "begin", begin};
+                    std::span<seqan3::dna4 const> const slice{shared_sequence->data() + begin, end - begin};
+                    std::invoke(worker, slice, bin_number);
+                },
+                end - begin);
+        }
+    }
+
+    hash_batch(*batch);
+    done();
+}
+
+} // namespace detail
+
+/*!\brief Calls the worker on slices of the files of all user bins in parallel.
+ * \details
+ * The worker is called as `worker(slice, bin_number)`, where `slice` is a `std::span<seqan3::dna4 const>` for
+ * sequence files, and a raptor::minimiser_file_slice for minimiser files. The slices can be passed to
+ * raptor::file_reader::hash_into. Slices of the same user bin may be processed concurrently.
+ *
+ * In contrast to raptor::call_parallel_on_bins, a large user bin is processed by multiple threads.
+ * The largest files are processed first. Minimiser files are split into slices of `slice_size` minimisers.
+ * Sequence files are read by one thread each, and slices of about `slice_size` bases are processed in OpenMP tasks
+ * by threads that are otherwise idle.
+ *
+ * `on_bin_done(bin_number)` is called once all slices of a user bin have been processed, by the thread that
+ * processed the last slice. User bins without files are done immediately.
+ */
+template <file_types file_type, typename algorithm_t, typename on_bin_done_t = detail::ignore_bin>
+void call_parallel_on_bin_slices(algorithm_t && worker,
+                                 file_reader<file_type> const & reader,
+                                 std::vector<std::vector<std::string>> const & bin_paths,
+                                 uint8_t const threads,
+                                 uint64_t const slice_size = file_type == file_types::sequence
+                                                               ? default_bases_per_slice
+                                                               : default_minimisers_per_slice,
+                                 on_bin_done_t && on_bin_done = {})
+{
+    std::vector<detail::bin_file> const files = detail::files_by_size(bin_paths);
+    // The number of files (sequence) or slices (minimiser) of each user bin that are not yet processed.
+    std::vector<std::atomic<size_t>> pending(bin_paths.size());
+
+    if constexpr (file_type == file_types::minimiser)
+    {
+        // Minimiser files can be split without reading them.
+        std::vector<std::pair<size_t, minimiser_file_slice>> slices{};
+        for (detail::bin_file const & file : files)
+        {
+            uint64_t const count = minimiser_file_input{*file.filename}.size();
+            uint64_t first{};
+            do
+            {
+                slices.emplace_back(file.bin_number,
+                                    minimiser_file_slice{.filename = file.filename,
+                                                         .first = first,
+                                                         .count = std::min(slice_size, count - first)});
+                first += slice_size;
+            }
+            while (first < count);
+        }
+
+        for (auto const & [bin_number, slice] : slices)
+            pending[bin_number].fetch_add(1u, std::memory_order_relaxed);
+        for (size_t bin_number = 0; bin_number < bin_paths.size(); ++bin_number)
+            if (pending[bin_number].load(std::memory_order_relaxed) == 0u)
+                on_bin_done(bin_number);
+
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+        for (size_t i = 0; i < slices.size(); ++i)
+        {
+            auto const & [bin_number, slice] = slices[i];
+            trace_scope const slice_trace{"Slice", "worker", "bin", bin_number, "first", slice.first};
+            std::invoke(worker, slice, bin_number);
+            if (pending[bin_number].fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+                on_bin_done(bin_number);
+        }
+    }
+    else
+    {
+        for (size_t bin_number = 0; bin_number < bin_paths.size(); ++bin_number)
+        {
+            pending[bin_number].store(bin_paths[bin_number].size(), std::memory_order_relaxed);
+            if (bin_paths[bin_number].empty())
+                on_bin_done(bin_number);
+        }
+
+        // Threads that finished their files execute the pending tasks of other threads.
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            size_t const bin_number = files[i].bin_number;
+            trace_scope const file_trace{"File", "worker", "bin", bin_number, "bytes", files[i].size};
+            detail::call_on_sequence_slices(worker,
+                                            files[i],
+                                            reader.window_size(),
+                                            slice_size,
+                                            pending[bin_number],
+                                            on_bin_done);
+        }
+    }
+}
+
+} // namespace raptor
@@ -19,6 +19,8 @@
 #include <hibf/contrib/std/zip_view.hpp>
 #include <hibf/misc/divide_and_ceil.hpp>
 
+#include <raptor/trace.hpp>
+
 namespace raptor
 {
 
@@ -41,6 +43,9 @@ void call_parallel_on_bins(algorithm_t && worker,
 #pragma omp parallel for schedule(dynamic) num_threads(threads)
     for (size_t i = 0; i < number_of_chunks; ++i)
     {
+        size_t const first_bin = i * chunk_size;
+        size_t const bins = std::min(chunk_size, number_of_bins - first_bin);
+        trace_scope const chunk_trace{"Chunk", "worker", "first_bin", first_bin, "bins", bins};
         std::invoke(worker, chunked_view[i]);
     }
 }
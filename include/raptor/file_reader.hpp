@@ -9,11 +9,15 @@
 
 #pragma once
 
+#include <span>
+
 #include <seqan3/io/sequence_file/input.hpp>
 #include <seqan3/search/views/minimiser_hash.hpp>
 
 #include <raptor/adjust_seed.hpp>
 #include <raptor/dna4_traits.hpp>
+#include <raptor/minimiser_file.hpp>
+#include <raptor/sketch.hpp>
 
 namespace raptor
 {
@@ -24,6 +28,14 @@ enum class file_types : uint8_t
     minimiser
 };
 
+//!\brief A range of minimisers in a minimiser file.
+struct minimiser_file_slice
+{
+    std::string const * filename{nullptr};
+    uint64_t first{};
+    uint64_t count{};
+};
+
 template <file_types file_type>
 class file_reader
 {};
@@ -39,11 +51,23 @@ public:
     file_reader & operator=(file_reader &&) = default;
     ~file_reader() = default;
 
-    explicit file_reader(seqan3::shape const shape, uint32_t const window_size) :
+    explicit file_reader(seqan3::shape const shape,
+                         uint32_t const window_size,
+                         sketch_kind const sketch = sketch_kind::minimiser) :
+        window{window_size},
+        sketch{sketch},
         minimiser_view{seqan3::views::minimiser_hash(shape,
                                                      seqan3::window_size{window_size},
                                                      seqan3::seed{adjust_seed(shape.count())})}
-    {}
+    {
+        if (sketch == sketch_kind::syncmer)
+            syncmer_view = syncmer_hash{shape.size(), window_size};
+    }
+
+    uint32_t window_size() const noexcept
+    {
+        return window;
+    }
 
     template <std::output_iterator<uint64_t> it_t>
     void hash_into(std::vector<std::string> const & filenames, it_t target) const
@@ -57,7 +81,24 @@ public:
     {
         sequence_file_t fin{filename};
         for (auto && record : fin)
-            std::ranges::copy(record.sequence() | minimiser_view, target);
+            hash_into(std::span<seqan3::dna4 const>{record.sequence()}, target);
+    }
+
+    template <std::output_iterator<uint64_t> it_t>
+    void hash_into(std::span<seqan3::dna4 const> const sequence, it_t target) const
+    {
+        if (sketch == sketch_kind::minimiser)
+        {
+            std::ranges::copy(sequence | minimiser_view, target);
+            return;
+        }
+
+        syncmer_view.for_each(sequence,
+                              [&target](uint64_t const value)
+                              {
+                                  *target = value;
+                                  ++target;
+                              });
     }
 
     template <std::output_iterator<uint64_t> it_t>
@@ -72,7 +113,27 @@ public:
     {
         sequence_file_t fin{filename};
         for (auto && record : fin)
-            std::ranges::copy_if(record.sequence() | minimiser_view, target, pred);
+            hash_into_if(std::span<seqan3::dna4 const>{record.sequence()}, target, pred);
+    }
+
+    template <std::output_iterator<uint64_t> it_t>
+    void hash_into_if(std::span<seqan3::dna4 const> const sequence, it_t target, auto && pred) const
+    {
+        if (sketch == sketch_kind::minimiser)
+        {
+            std::ranges::copy_if(sequence | minimiser_view, target, pred);
+            return;
+        }
+
+        syncmer_view.for_each(sequence,
+                              [&target, &pred](uint64_t const value)
+                              {
+                                  if (pred(value))
+                                  {
+                                      *target = value;
+                                      ++target;
+                                  }
+                              });
     }
 
     void for_each_hash(std::vector<std::string> const & filenames, auto && callback) const
@@ -85,11 +146,23 @@ public:
     {
         sequence_file_t fin{filename};
         for (auto && record : fin)
-            std::ranges::for_each(record.sequence() | minimiser_view, callback);
+            for_each_hash(std::span<seqan3::dna4 const>{record.sequence()}, callback);
+    }
+
+    void for_each_hash(std::span<seqan3::dna4 const> const sequence, auto && callback) const
+    {
+        if (sketch == sketch_kind::minimiser)
+            std::ranges::for_each(sequence | minimiser_view, callback);
+        else
+            syncmer_view.for_each(sequence, callback);
     }
 
-private:
     using sequence_file_t = seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::seq>>;
+
+private:
+    uint32_t window{};
+    sketch_kind sketch{};
+    syncmer_hash syncmer_view{};
     using view_t = decltype(seqan3::views::minimiser_hash(seqan3::shape{}, seqan3::window_size{}, seqan3::seed{}));
     view_t minimiser_view = seqan3::views::minimiser_hash(seqan3::shape{}, seqan3::window_size{}, seqan3::seed{});
 };
@@ -97,13 +170,6 @@ private:
 template <>
 class file_reader<file_types::minimiser>
 {
-    [[noreturn]] void io_error(std::string const & filepath, int const err = errno) const
-    {
-        std::ostringstream oss;
-        oss << "Failed to open file: " << std::quoted(filepath);
-        throw std::system_error(err, std::generic_category(), oss.str());
-    }
-
 public:
     file_reader() = default;
     file_reader(file_reader const &) = default;
@@ -112,7 +178,7 @@ public:
     file_reader & operator=(file_reader &&) = default;
     ~file_reader() = default;
 
-    explicit file_reader(seqan3::shape const, uint32_t const)
+    explicit file_reader(seqan3::shape const, uint32_t const, sketch_kind const = sketch_kind::minimiser)
     {}
 
     template <std::output_iterator<uint64_t> it_t>
@@ -125,16 +191,23 @@ public:
     template <std::output_iterator<uint64_t> it_t>
     void hash_into(std::string const & filename, it_t target) const
     {
-        std::ifstream fin{filename, std::ios::binary};
-        if (!fin.is_open()) [[unlikely]]
-            io_error(filename);
+        for_each_hash(filename,
+                      [&target](uint64_t const value)
+                      {
+                          *target = value;
+                          ++target;
+                      });
+    }
 
-        uint64_t value;
-        while (fin.read(reinterpret_cast<char *>(&value), sizeof(value)))
-        {
-            *target = value;
-            ++target;
-        }
+    template <std::output_iterator<uint64_t> it_t>
+    void hash_into(minimiser_file_slice const & slice, it_t target) const
+    {
+        for_each_hash(slice,
+                      [&target](uint64_t const value)
+                      {
+                          *target = value;
+                          ++target;
+                      });
     }
 
     template <std::output_iterator<uint64_t> it_t>
@@ -147,17 +220,29 @@ public:
     template <std::output_iterator<uint64_t> it_t>
     void hash_into_if(std::string const & filename, it_t target, auto && pred) const
     {
-        std::ifstream fin{filename, std::ios::binary};
-        if (!fin.is_open()) [[unlikely]]
-            io_error(filename);
+        for_each_hash(filename,
+                      [&target, &pred](uint64_t const value)
+                      {
+                          if (pred(value))
+                          {
+                              *target = value;
+                              ++target;
+                          }
+                      });
+    }
 
-        uint64_t value;
-        while (fin.read(reinterpret_cast<char *>(&value), sizeof(value)))
-            if (pred(value))
-            {
-                *target = value;
-                ++target;
-            }
+    template <std::output_iterator<uint64_t> it_t>
+    void hash_into_if(minimiser_file_slice const & slice, it_t target, auto && pred) const
+    {
+        for_each_hash(slice,
+                      [&target, &pred](uint64_t const value)
+                      {
+                          if (pred(value))
+                          {
+                              *target = value;
+                              ++target;
+                          }
+                      });
     }
 
     void for_each_hash(std::vector<std::string> const & filenames, auto && callback) const
@@ -166,15 +251,17 @@ public:
             for_each_hash(filename, callback);
     }
 
+    // Both the compressed and the raw format are supported; see raptor::minimiser_file_header.
     void for_each_hash(std::string const & filename, auto && callback) const
     {
-        std::ifstream fin{filename, std::ios::binary};
-        if (!fin.is_open()) [[unlikely]]
-            io_error(filename);
+        minimiser_file_input input{filename};
+        input.for_each(0u, input.size(), callback);
+    }
 
-        uint64_t value;
-        while (fin.read(reinterpret_cast<char *>(&value), sizeof(value)))
-            callback(value);
+    void for_each_hash(minimiser_file_slice const & slice, auto && callback) const
+    {
+        assert(slice.filename != nullptr);
+        minimiser_file_input{*slice.filename}.for_each(slice.first, slice.count, callback);
     }
 };
 
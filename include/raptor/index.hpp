@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cassert>
 
+#include <cereal/types/common.hpp>
 #include <cereal/types/string.hpp>
 
 #include <sharg/exceptions.hpp>
@@ -19,6 +20,10 @@
 #include <hibf/hierarchical_interleaved_bloom_filter.hpp>
 
 #include <raptor/argument_parsing/build_arguments.hpp>
+#include <raptor/bin_path_table.hpp>
+#include <raptor/blocked_bloom_filter.hpp>
+#include <raptor/build/partition_config.hpp>
+#include <raptor/sketch.hpp>
 #include <raptor/strong_types.hpp>
 
 namespace raptor
@@ -29,6 +34,7 @@ namespace index_structure
 
 using ibf = seqan::hibf::interleaved_bloom_filter;
 using hibf = seqan::hibf::hierarchical_interleaved_bloom_filter;
+using blocked_ibf = raptor::blocked_bloom_filter;
 
 template <typename index_t>
 concept is_ibf = std::same_as<index_t, index_structure::ibf>;
@@ -37,7 +43,10 @@ template <typename index_t>
 concept is_hibf = std::same_as<index_t, index_structure::hibf>;
 
 template <typename index_t>
-concept is_valid = is_ibf<index_t> || is_hibf<index_t>;
+concept is_blocked_ibf = std::same_as<index_t, index_structure::blocked_ibf>;
+
+template <typename index_t>
+concept is_valid = is_ibf<index_t> || is_hibf<index_t> || is_blocked_ibf<index_t>;
 
 } // namespace index_structure
 
@@ -52,9 +61,12 @@ private:
 
     uint64_t window_size_{};
     seqan3::shape shape_{};
+    sketch_kind sketch_{};
     uint8_t parts_{};
-    std::vector<std::vector<std::string>> bin_path_{};
+    hash_partitioning partitioning_{hash_partitioning::suffix};
+    bin_path_table bin_path_{};
     bool is_hibf_{index_structure::is_hibf<data_t>};
+    bool is_blocked_ibf_{index_structure::is_blocked_ibf<data_t>};
     double fpr_{};
     seqan::hibf::config config_{};
     data_t ibf_{};
@@ -74,7 +86,14 @@ private:
     seqan::hibf::bit_vector was_resized_{};
 
 public:
-    static constexpr uint32_t version{3u};
+    static constexpr uint32_t version{7u};
+    /*!\brief Indices of this and later versions are read, too.
+     * \details
+     * Versions 3 and 4 store the bin paths as nested vectors instead of a raptor::bin_path_table. Version 3 cannot
+     * contain a raptor::blocked_bloom_filter. Versions before 6 do not store the sketch; they contain minimisers.
+     * Versions before 7 do not store the partitioning; their parts use raptor::hash_partitioning::suffix.
+     */
+    static constexpr uint32_t oldest_supported_version{3u};
 
     raptor_index() = default;
     raptor_index(raptor_index const &) = default;
@@ -86,15 +105,17 @@ public:
     explicit raptor_index(window const window_size,
                           seqan3::shape const shape,
                           uint8_t const parts,
-                          std::vector<std::vector<std::string>> const & bin_path,
+                          bin_path_table bin_path,
                           seqan::hibf::config const & config,
-                          data_t && ibf)
+                          data_t && ibf,
+                          sketch_kind const sketch = sketch_kind::minimiser)
         requires index_structure::is_hibf<data_t>
         :
         window_size_{window_size.v},
         shape_{shape},
+        sketch_{sketch},
         parts_{parts},
-        bin_path_{bin_path},
+        bin_path_{std::move(bin_path)},
         fpr_{config.maximum_fpr},
         config_{config},
         ibf_{std::move(ibf)},
@@ -103,16 +124,23 @@ public:
     {}
 
     explicit raptor_index(build_arguments const & arguments)
-        requires index_structure::is_ibf<data_t>
+        requires (!index_structure::is_hibf<data_t>)
+        :
+        raptor_index{arguments, arguments.bits}
+    {}
+
+    //!\brief Uses `bits` instead of `build_arguments::bits`, e.g., to construct the parts concurrently.
+    raptor_index(build_arguments const & arguments, uint64_t const bits)
+        requires (!index_structure::is_hibf<data_t>)
         :
         window_size_{arguments.window_size},
         shape_{arguments.shape},
+        sketch_{arguments.sketch},
         parts_{arguments.parts},
+        partitioning_{hash_partitioning::balanced},
         bin_path_{arguments.bin_path},
         fpr_{arguments.fpr},
-        ibf_{seqan::hibf::bin_count{arguments.bins},
-             seqan::hibf::bin_size{arguments.bits / arguments.parts},
-             seqan::hibf::hash_function_count{arguments.hash}}
+        ibf_{make_ibf(arguments, bits)}
     {}
 
     uint64_t window_size() const
@@ -125,26 +153,42 @@ public:
         return shape_;
     }
 
+    sketch_kind sketch() const
+    {
+        return sketch_;
+    }
+
     uint8_t parts() const
     {
         return parts_;
     }
 
+    hash_partitioning partitioning() const
+    {
+        return partitioning_;
+    }
+
     void append_bin_path(std::vector<std::string> const & path)
     {
         bin_path_.push_back(path);
     }
 
-    void replace_bin_path(std::vector<std::vector<std::string>> path)
+    void replace_bin_path(bin_path_table path)
     {
         bin_path_ = std::move(path);
     }
 
-    std::vector<std::vector<std::string>> const & bin_path() const
+    bin_path_table const & bin_path() const &
     {
         return bin_path_;
     }
 
+    //!\brief Moves the bin paths out of a temporary index, e.g., one that only holds the parameters.
+    bin_path_table bin_path() &&
+    {
+        return std::move(bin_path_);
+    }
+
     double fpr() const
     {
         return fpr_;
@@ -161,6 +205,11 @@ public:
         return is_hibf_;
     }
 
+    bool is_blocked_ibf() const
+    {
+        return is_blocked_ibf_;
+    }
+
     data_t & ibf()
     {
         return ibf_;
@@ -224,16 +273,22 @@ public:
     {
         uint32_t parsed_version{raptor_index<>::version};
         archive(parsed_version);
-        if (parsed_version == raptor_index<>::version)
+        if (is_supported(parsed_version))
         {
             try
             {
                 archive(window_size_);
                 archive(shape_);
+                if (parsed_version >= 6u)
+                    archive(sketch_);
                 archive(parts_);
-                archive(bin_path_);
+                if (parsed_version >= 7u)
+                    archive(partitioning_);
+                serialise_bin_path(archive, parsed_version);
                 archive(fpr_);
                 archive(is_hibf_);
+                if (parsed_version != oldest_supported_version)
+                    archive(is_blocked_ibf_);
                 archive(config_);
                 archive(original_number_of_ibfs_);
                 archive(was_resized_);
@@ -265,16 +320,22 @@ public:
     {
         uint32_t parsed_version{};
         archive(parsed_version);
-        if (parsed_version == version)
+        if (is_supported(parsed_version))
         {
             try
             {
                 archive(window_size_);
                 archive(shape_);
+                if (parsed_version >= 6u)
+                    archive(sketch_);
                 archive(parts_);
-                archive(bin_path_);
+                if (parsed_version >= 7u)
+                    archive(partitioning_);
+                serialise_bin_path(archive, parsed_version);
                 archive(fpr_);
                 archive(is_hibf_);
+                if (parsed_version != oldest_supported_version)
+                    archive(is_blocked_ibf_);
                 archive(config_);
             }
             // GCOVR_EXCL_START
@@ -290,6 +351,42 @@ public:
         }
     }
     //!\endcond
+
+private:
+    // A raptor::blocked_bloom_filter zeroes its bit vector with the threads of the build.
+    static data_t make_ibf(build_arguments const & arguments, uint64_t const bits)
+        requires (!index_structure::is_hibf<data_t>)
+    {
+        seqan::hibf::bin_count const bins{arguments.bins};
+        seqan::hibf::bin_size const size{bits / arguments.parts};
+        seqan::hibf::hash_function_count const hash{arguments.hash};
+
+        if constexpr (index_structure::is_blocked_ibf<data_t>)
+            return data_t{bins, size, hash, arguments.threads};
+        else
+            return data_t{bins, size, hash};
+    }
+
+    static constexpr bool is_supported(uint32_t const parsed_version)
+    {
+        return parsed_version >= oldest_supported_version && parsed_version <= version;
+    }
+
+    //!\brief Versions before 5 store the bin paths as nested vectors. These are only read, never written.
+    template <seqan3::cereal_archive archive_t>
+    void serialise_bin_path(archive_t & archive, uint32_t const parsed_version)
+    {
+        if (parsed_version < 5u)
+        {
+            std::vector<std::vector<std::string>> bin_path{};
+            archive(bin_path);
+            bin_path_ = bin_path_table{bin_path};
+        }
+        else
+        {
+            archive(bin_path_);
+        }
+    }
 };
 
 } // namespace raptor
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::index_compression.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <lz4.h>
+#include <zstd.h>
+
+namespace raptor
+{
+
+/*!\brief The compression of the bit vectors in an index.
+ * \details
+ * LZ4 decompresses faster, Zstandard compresses better.
+ */
+enum class index_compression : uint8_t
+{
+    none,
+    lz4,
+    zstd
+};
+
+//!\brief The names of the values of raptor::index_compression for the command line.
+inline auto enumeration_names(index_compression)
+{
+    return std::unordered_map<std::string_view, index_compression>{{"none", index_compression::none},
+                                                                   {"lz4", index_compression::lz4},
+                                                                   {"zstd", index_compression::zstd}};
+}
+
+namespace detail
+{
+
+// The uncompressed bytes of a block. Blocks are compressed and decompressed independently.
+inline constexpr uint64_t compression_block_bytes{1ULL << 22};
+// Level 3 is the default of the zstd command line tool.
+inline constexpr int zstd_level{3};
+
+//!\brief Returns the compressed `data`. `size` must not exceed raptor::detail::compression_block_bytes.
+inline std::string compress_block(index_compression const compression, char const * const data, size_t const size)
+{
+    std::string result{};
+    if (compression == index_compression::lz4)
+    {
+        result.resize(LZ4_compressBound(static_cast<int>(size)));
+        int const bytes =
+            LZ4_compress_default(data, result.data(), static_cast<int>(size), static_cast<int>(result.size()));
+        if (bytes <= 0)
+            throw std::runtime_error{"Cannot compress index."}; // GCOVR_EXCL_LINE
+        result.resize(bytes);
+    }
+    else
+    {
+        result.resize(ZSTD_compressBound(size));
+        size_t const bytes = ZSTD_compress(result.data(), result.size(), data, size, zstd_level);
+        if (ZSTD_isError(bytes))
+            throw std::runtime_error{"Cannot compress index."}; // GCOVR_EXCL_LINE
+        result.resize(bytes);
+    }
+    return result;
+}
+
+//!\brief Decompresses `source` into the `target_size` bytes at `target`.
+inline void decompress_block(index_compression const compression,
+                             char const * const source,
+                             size_t const source_size,
+                             char * const target,
+                             size_t const target_size)
+{
+    bool success{};
+    if (compression == index_compression::lz4)
+    {
+        success = source_size <= static_cast<size_t>(std::numeric_limits<int>::max())
+               && LZ4_decompress_safe(source, target, static_cast<int>(source_size), static_cast<int>(target_size))
+                      == static_cast<int>(target_size);
+    }
+    else
+    {
+        size_t const bytes = ZSTD_decompress(target, target_size, source, source_size);
+        success = !ZSTD_isError(bytes) && bytes == target_size;
+    }
+
+    if (!success)
+        throw std::runtime_error{"Cannot read index: A compressed block is corrupted."};
+}
+
+} // namespace detail
+
+} // namespace raptor
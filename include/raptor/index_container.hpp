@@ -0,0 +1,954 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::write_index_container and raptor::read_index_container.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+
+#include <hibf/misc/next_multiple_of_64.hpp>
+
+#include <raptor/index.hpp>
+#include <raptor/index_compression.hpp>
+#include <raptor/index_metadata.hpp>
+
+namespace raptor
+{
+
+/*!\brief A section of an index container.
+ * \details
+ * An index container consists of
+ * ```
+ * magic                 8 bytes, "RAPTORIX"
+ * compression           uint64_t, a raptor::index_compression
+ * number of sections    uint64_t
+ * section table         one raptor::index_section per section
+ * metadata              "RAPTORM3" and a raptor::index_metadata
+ * sections              each section starts at a multiple of 64 bytes
+ * ```
+ * The metadata has a fixed layout and is read by raptor::read_index_metadata without reading any section.
+ * The first section is the cereal archive of the raptor::raptor_index without its bit vectors. For the IBF, the
+ * archive is followed by the bin size, and the second section is the bit vector. For the HIBF, there is one section
+ * per IBF of `ibf_vector`, each holding the cereal archive of the IBF.
+ * Since the sections are independent, they are read and written with `pread` and `pwrite` by multiple threads.
+ *
+ * If the index is compressed, all sections but the first one consist of the uncompressed size (uint64_t), the
+ * compressed size of each block (uint64_t), and the blocks. Each block holds
+ * raptor::detail::compression_block_bytes uncompressed bytes, except for the last one. Since the blocks are
+ * independent, a bit vector is decompressed by multiple threads.
+ * Files without the magic are cereal archives of a raptor::raptor_index, as written by previous versions.
+ */
+struct index_section
+{
+    uint64_t offset{};
+    uint64_t size{};
+
+    bool operator==(index_section const &) const = default;
+};
+
+namespace detail
+{
+
+inline constexpr std::array<char, 8> index_container_magic{'R', 'A', 'P', 'T', 'O', 'R', 'I', 'X'};
+inline constexpr uint64_t index_section_alignment{64u};
+// The bytes a thread reads or writes at once for a bit vector.
+inline constexpr uint64_t index_chunk_bytes{1ULL << 26};
+
+inline uint64_t align_section(uint64_t const offset)
+{
+    return (offset + index_section_alignment - 1u) / index_section_alignment * index_section_alignment;
+}
+
+//!\brief An open file that is read and written at offsets. Thread-safe.
+class index_file
+{
+public:
+    index_file() = delete;
+    index_file(index_file const &) = delete;
+    index_file(index_file &&) = delete;
+    index_file & operator=(index_file const &) = delete;
+    index_file & operator=(index_file &&) = delete;
+
+    index_file(std::filesystem::path const & path, int const flags) :
+        path_{path},
+        descriptor{::open(path.c_str(), flags, 0644)}
+    {
+        if (descriptor == -1)
+            throw std::system_error{errno, std::generic_category(), "Cannot open " + path.string()};
+    }
+
+    ~index_file()
+    {
+        ::close(descriptor);
+    }
+
+    std::filesystem::path const & path() const
+    {
+        return path_;
+    }
+
+    uint64_t size() const
+    {
+        return std::filesystem::file_size(path_);
+    }
+
+    void read_at(void * const data, uint64_t bytes, uint64_t offset) const
+    {
+        char * target = static_cast<char *>(data);
+        while (bytes > 0u)
+        {
+            ssize_t const result = ::pread(descriptor, target, std::min<uint64_t>(bytes, 1ULL << 30), offset);
+            if (result == -1 && errno == EINTR)
+                continue; // GCOVR_EXCL_LINE
+            if (result == -1)
+                throw std::system_error{errno, std::generic_category(), "Cannot read " + path_.string()};
+            if (result == 0)
+                throw std::runtime_error{"Cannot read index: " + path_.string() + " is truncated."};
+            target += result;
+            bytes -= result;
+            offset += result;
+        }
+    }
+
+    void write_at(void const * const data, uint64_t bytes, uint64_t offset) const
+    {
+        char const * source = static_cast<char const *>(data);
+        while (bytes > 0u)
+        {
+            ssize_t const result = ::pwrite(descriptor, source, std::min<uint64_t>(bytes, 1ULL << 30), offset);
+            if (result == -1 && errno == EINTR)
+                continue; // GCOVR_EXCL_LINE
+            if (result == -1)
+                throw std::system_error{errno, std::generic_category(), "Cannot write " + path_.string()};
+            source += result;
+            bytes -= result;
+            offset += result;
+        }
+    }
+
+    void resize(uint64_t const bytes) const
+    {
+        if (::ftruncate(descriptor, bytes) == -1)
+            throw std::system_error{errno, std::generic_category(), "Cannot write " + path_.string()};
+    }
+
+private:
+    std::filesystem::path path_{};
+    int descriptor{-1};
+};
+
+//!\brief Reads a section of an index_file. Large reads bypass the buffer.
+class section_reader : public std::streambuf
+{
+public:
+    section_reader(index_file const & file, index_section const & section) :
+        file{std::addressof(file)},
+        position{section.offset},
+        end{section.offset + section.size}
+    {}
+
+protected:
+    int_type underflow() override
+    {
+        if (position == end)
+            return traits_type::eof();
+
+        uint64_t const bytes = std::min<uint64_t>(buffer.size(), end - position);
+        file->read_at(buffer.data(), bytes, position);
+        position += bytes;
+        setg(buffer.data(), buffer.data(), buffer.data() + bytes);
+        return traits_type::to_int_type(buffer[0]);
+    }
+
+    std::streamsize xsgetn(char * target, std::streamsize const count) override
+    {
+        std::streamsize const buffered = std::min<std::streamsize>(count, egptr() - gptr());
+        if (buffered > 0)
+        {
+            std::memcpy(target, gptr(), buffered);
+            gbump(static_cast<int>(buffered));
+        }
+
+        std::streamsize const remaining = count - buffered;
+        if (remaining < static_cast<std::streamsize>(buffer.size()))
+            return buffered + std::streambuf::xsgetn(target + buffered, remaining);
+
+        uint64_t const bytes = std::min<uint64_t>(remaining, end - position);
+        file->read_at(target + buffered, bytes, position);
+        position += bytes;
+        return buffered + bytes;
+    }
+
+private:
+    index_file const * file{nullptr};
+    uint64_t position{};
+    uint64_t end{};
+    std::vector<char> buffer = std::vector<char>(1ULL << 20);
+};
+
+//!\brief Writes to an index_file, starting at an offset. Large writes bypass the buffer.
+class section_writer : public std::streambuf
+{
+public:
+    section_writer(index_file const & file, uint64_t const offset) :
+        file{std::addressof(file)},
+        begin{offset},
+        position{offset}
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    //!\brief The number of bytes written so far, including buffered ones.
+    uint64_t size() const
+    {
+        return position - begin + (pptr() - pbase());
+    }
+
+protected:
+    int_type overflow(int_type const character) override
+    {
+        flush_buffer();
+        if (!traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(char const * source, std::streamsize const count) override
+    {
+        if (count < static_cast<std::streamsize>(buffer.size()))
+            return std::streambuf::xsputn(source, count);
+
+        flush_buffer();
+        file->write_at(source, count, position);
+        position += count;
+        return count;
+    }
+
+    int sync() override
+    {
+        flush_buffer();
+        return 0;
+    }
+
+private:
+    index_file const * file{nullptr};
+    uint64_t begin{};
+    uint64_t position{};
+    std::vector<char> buffer = std::vector<char>(1ULL << 20);
+
+    void flush_buffer()
+    {
+        uint64_t const bytes = pptr() - pbase();
+        file->write_at(pbase(), bytes, position);
+        position += bytes;
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+};
+
+//!\brief Counts the bytes written to it.
+class byte_counter : public std::streambuf
+{
+public:
+    uint64_t size() const
+    {
+        return bytes;
+    }
+
+protected:
+    int_type overflow(int_type const character) override
+    {
+        ++bytes;
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(char const *, std::streamsize const count) override
+    {
+        bytes += count;
+        return count;
+    }
+
+private:
+    uint64_t bytes{};
+};
+
+//!\brief Calls `function(i)` for all `i` in `[0, count)` in parallel. The first exception is rethrown.
+template <typename function_t>
+void parallel_for_each_section(size_t const count, uint8_t const threads, function_t && function)
+{
+    std::exception_ptr error{};
+    std::mutex error_mutex{};
+
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (size_t i = 0; i < count; ++i)
+    {
+        try
+        {
+            function(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> const guard{error_mutex};
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+//!\brief Reads or writes a bit vector of `bytes` bytes in chunks in parallel.
+template <typename transfer_t>
+void transfer_chunks(uint64_t const bytes, uint8_t const threads, transfer_t && transfer)
+{
+    size_t const chunks = (bytes + index_chunk_bytes - 1u) / index_chunk_bytes;
+    parallel_for_each_section(chunks,
+                              threads,
+                              [&](size_t const chunk)
+                              {
+                                  uint64_t const offset = chunk * index_chunk_bytes;
+                                  transfer(offset, std::min(index_chunk_bytes, bytes - offset));
+                              });
+}
+
+// The magic, the compression, and the number of sections.
+inline constexpr uint64_t index_header_bytes{index_container_magic.size() + 2u * sizeof(uint64_t)};
+
+inline index_compression read_compression(index_file const & file)
+{
+    uint64_t compression{};
+    file.read_at(&compression, sizeof(compression), index_container_magic.size());
+    if (compression > static_cast<uint64_t>(index_compression::zstd))
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is not a Raptor index."};
+    return static_cast<index_compression>(compression);
+}
+
+inline std::vector<index_section> read_section_table(index_file const & file)
+{
+    std::array<char, 8> magic{};
+    uint64_t number_of_sections{};
+    file.read_at(magic.data(), magic.size(), 0u);
+    file.read_at(&number_of_sections, sizeof(number_of_sections), index_header_bytes - sizeof(number_of_sections));
+
+    uint64_t const file_size = file.size();
+    uint64_t const table_offset = index_header_bytes;
+    if (magic != index_container_magic || number_of_sections == 0u
+        || number_of_sections > (file_size - table_offset) / sizeof(index_section))
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is not a Raptor index."};
+
+    std::vector<index_section> sections(number_of_sections);
+    file.read_at(sections.data(), number_of_sections * sizeof(index_section), table_offset);
+
+    for (index_section const & section : sections)
+        if (section.offset > file_size || section.size > file_size - section.offset)
+            throw std::runtime_error{"Cannot read index: " + file.path().string() + " is truncated."};
+
+    return sections;
+}
+
+// The metadata follows the section table.
+inline uint64_t metadata_offset(uint64_t const number_of_sections)
+{
+    return index_header_bytes + number_of_sections * sizeof(index_section);
+}
+
+// Returns the sections, each starting at a multiple of 64 bytes, for sections of the given sizes.
+inline std::vector<index_section> layout_sections(std::vector<uint64_t> const & sizes, index_metadata const & metadata)
+{
+    std::vector<index_section> sections(sizes.size());
+    uint64_t offset = metadata_offset(sizes.size()) + metadata.size_in_bytes();
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        offset = align_section(offset);
+        sections[i] = {.offset = offset, .size = sizes[i]};
+        offset += sizes[i];
+    }
+    return sections;
+}
+
+inline void write_metadata(index_file const & file, uint64_t const number_of_sections, index_metadata const & metadata)
+{
+    uint64_t const offset = metadata_offset(number_of_sections);
+    file.write_at(index_metadata::magic.data(), index_metadata::magic.size(), offset);
+    file.write_at(&metadata.fixed, sizeof(metadata.fixed), offset + index_metadata::magic.size());
+    file.write_at(metadata.ibfs.data(),
+                  metadata.ibfs.size() * sizeof(index_metadata::ibf_type),
+                  offset + index_metadata::magic.size() + sizeof(metadata.fixed));
+}
+
+//!\brief Returns the metadata, or `std::nullopt` if the container has none.
+inline std::optional<index_metadata> read_metadata(index_file const & file, std::vector<index_section> const & sections)
+{
+    uint64_t const offset = metadata_offset(sections.size());
+    uint64_t const available = sections[0].offset - std::min(offset, sections[0].offset);
+
+    index_metadata metadata{};
+    std::array<char, 8> magic{};
+    if (available < metadata.size_in_bytes())
+        return std::nullopt;
+    file.read_at(magic.data(), magic.size(), offset);
+    if (magic != index_metadata::magic)
+        return std::nullopt;
+
+    file.read_at(&metadata.fixed, sizeof(metadata.fixed), offset + magic.size());
+    if (metadata.fixed.number_of_ibfs > available / sizeof(index_metadata::ibf_type))
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is corrupted."};
+    metadata.ibfs.resize(metadata.fixed.number_of_ibfs);
+    if (metadata.size_in_bytes() > available)
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is corrupted."};
+    file.read_at(metadata.ibfs.data(),
+                 metadata.ibfs.size() * sizeof(index_metadata::ibf_type),
+                 offset + magic.size() + sizeof(metadata.fixed));
+    return metadata;
+}
+
+inline void write_section_table(index_file const & file,
+                                std::vector<index_section> const & sections,
+                                index_compression const compression,
+                                index_metadata const & metadata)
+{
+    std::array<uint64_t, 2> const header{static_cast<uint64_t>(compression), sections.size()};
+    index_section const & last = sections.back();
+    file.resize(last.offset + last.size);
+    file.write_at(index_container_magic.data(), index_container_magic.size(), 0u);
+    file.write_at(header.data(), sizeof(header), index_container_magic.size());
+    file.write_at(sections.data(), sections.size() * sizeof(index_section), index_header_bytes);
+    write_metadata(file, sections.size(), metadata);
+}
+
+inline uint64_t number_of_blocks(uint64_t const bytes)
+{
+    return (bytes + compression_block_bytes - 1u) / compression_block_bytes;
+}
+
+//!\brief The content of a section, compressed in independent blocks.
+struct compressed_section
+{
+    uint64_t raw_size{};
+    std::vector<std::string> blocks{};
+
+    uint64_t size() const
+    {
+        uint64_t result = sizeof(uint64_t) * (1u + blocks.size());
+        for (std::string const & block : blocks)
+            result += block.size();
+        return result;
+    }
+
+    void write(index_file const & file, uint64_t const offset, uint8_t const threads) const
+    {
+        std::vector<uint64_t> header{raw_size};
+        std::vector<uint64_t> block_offsets(blocks.size());
+        uint64_t block_offset = offset + sizeof(uint64_t) * (1u + blocks.size());
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            header.push_back(blocks[i].size());
+            block_offsets[i] = block_offset;
+            block_offset += blocks[i].size();
+        }
+
+        file.write_at(header.data(), header.size() * sizeof(uint64_t), offset);
+        parallel_for_each_section(blocks.size(),
+                                  threads,
+                                  [&](size_t const i)
+                                  {
+                                      file.write_at(blocks[i].data(), blocks[i].size(), block_offsets[i]);
+                                  });
+    }
+};
+
+inline compressed_section compress_section(index_compression const compression,
+                                           char const * const data,
+                                           uint64_t const bytes,
+                                           uint8_t const threads)
+{
+    compressed_section result{.raw_size = bytes, .blocks = std::vector<std::string>(number_of_blocks(bytes))};
+    parallel_for_each_section(result.blocks.size(),
+                              threads,
+                              [&](size_t const block)
+                              {
+                                  uint64_t const offset = block * compression_block_bytes;
+                                  result.blocks[block] = compress_block(compression,
+                                                                        data + offset,
+                                                                        std::min(compression_block_bytes,
+                                                                                 bytes - offset));
+                              });
+    return result;
+}
+
+//!\brief The uncompressed size of a compressed section.
+inline uint64_t decompressed_size(index_file const & file, index_section const & section)
+{
+    uint64_t raw_size{};
+    if (section.size < sizeof(raw_size))
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is corrupted."};
+    file.read_at(&raw_size, sizeof(raw_size), section.offset);
+    return raw_size;
+}
+
+//!\brief Decompresses a section into the `raw_size` bytes at `target`, one block per thread at a time.
+inline void decompress_section(index_file const & file,
+                               index_section const & section,
+                               index_compression const compression,
+                               char * const target,
+                               uint64_t const raw_size,
+                               uint8_t const threads)
+{
+    std::vector<uint64_t> block_sizes(number_of_blocks(raw_size));
+    uint64_t const header_bytes = sizeof(uint64_t) * (1u + block_sizes.size());
+    if (decompressed_size(file, section) != raw_size || section.size < header_bytes)
+        throw std::runtime_error{"Cannot read index: " + file.path().string() + " is corrupted."};
+    file.read_at(block_sizes.data(), block_sizes.size() * sizeof(uint64_t), section.offset + sizeof(uint64_t));
+
+    std::vector<uint64_t> block_offsets(block_sizes.size());
+    uint64_t remaining = section.size - header_bytes;
+    for (size_t i = 0; i < block_sizes.size(); ++i)
+    {
+        if (block_sizes[i] > remaining)
+            throw std::runtime_error{"Cannot read index: " + file.path().string() + " is corrupted."};
+        block_offsets[i] = section.offset + section.size - remaining;
+        remaining -= block_sizes[i];
+    }
+
+    parallel_for_each_section(block_sizes.size(),
+                              threads,
+                              [&](size_t const block)
+                              {
+                                  std::string compressed(block_sizes[block], '\0');
+                                  file.read_at(compressed.data(), compressed.size(), block_offsets[block]);
+                                  uint64_t const offset = block * compression_block_bytes;
+                                  decompress_block(compression,
+                                                   compressed.data(),
+                                                   compressed.size(),
+                                                   target + offset,
+                                                   std::min(compression_block_bytes, raw_size - offset));
+                              });
+}
+
+//!\brief Reads `value` from a section holding its cereal archive.
+template <typename value_t>
+void read_cereal_section(index_file const & file,
+                         index_section const & section,
+                         index_compression const compression,
+                         value_t & value)
+{
+    if (compression == index_compression::none)
+    {
+        section_reader reader{file, section};
+        std::istream stream{&reader};
+        stream.exceptions(std::ios::badbit);
+        cereal::BinaryInputArchive iarchive{stream};
+        iarchive(value);
+        return;
+    }
+
+    std::string buffer(decompressed_size(file, section), '\0');
+    decompress_section(file, section, compression, buffer.data(), buffer.size(), 1u);
+    std::istringstream stream{std::move(buffer)};
+    stream.exceptions(std::ios::badbit);
+    cereal::BinaryInputArchive iarchive{stream};
+    iarchive(value);
+}
+
+// The size of the bit vector of an IBF in bytes.
+template <typename ibf_t>
+uint64_t bit_vector_bytes(ibf_t const & ibf)
+{
+    if constexpr (index_structure::is_blocked_ibf<ibf_t>)
+        return ibf.bit_size() / 8u;
+    else
+        return seqan::hibf::next_multiple_of_64(ibf.bin_count()) * ibf.bin_size() / 8u;
+}
+
+// The number of set bits in the bit vector of an IBF, counted in chunks in parallel.
+template <typename ibf_t>
+uint64_t count_set_bits(ibf_t const & ibf, uint8_t const threads)
+{
+    uint64_t const * const words = reinterpret_cast<uint64_t const *>(ibf.data());
+    std::atomic<uint64_t> result{};
+    transfer_chunks(bit_vector_bytes(ibf),
+                    threads,
+                    [&](uint64_t const offset, uint64_t const size)
+                    {
+                        uint64_t count{};
+                        for (uint64_t const word : std::span{words + offset / 8u, size / 8u})
+                            count += std::popcount(word);
+                        result.fetch_add(count, std::memory_order_relaxed);
+                    });
+    return result.load();
+}
+
+template <typename ibf_t>
+index_metadata::ibf_type describe_ibf(ibf_t const & ibf, uint64_t const level, uint8_t const threads)
+{
+    return {.bin_count = ibf.bin_count(),
+            .bit_size = bit_vector_bytes(ibf) * 8u,
+            .level = level,
+            .set_bits = count_set_bits(ibf, threads)};
+}
+
+template <typename data_t>
+index_metadata make_metadata(raptor_index<data_t> const & index, uint8_t const threads)
+{
+    index_metadata metadata{};
+    metadata.fixed = {.index_version = raptor_index<>::version,
+                      .window_size = index.window_size(),
+                      .shape = index.shape().to_ulong(),
+                      .shape_size = index.shape().size(),
+                      .parts = index.parts(),
+                      .number_of_user_bins = index.bin_path().size(),
+                      .hash_function_count = {},
+                      .fpr = index.fpr(),
+                      .is_hibf = index.is_hibf(),
+                      .is_blocked_ibf = index.is_blocked_ibf(),
+                      .sketch = std::to_underlying(index.sketch()),
+                      .partitioning = std::to_underlying(index.partitioning()),
+                      .number_of_ibfs = {}};
+
+    if constexpr (index_structure::is_hibf<data_t>)
+    {
+        auto const & ibf_vector = index.ibf().ibf_vector;
+        auto const & next_ibf_id = index.ibf().next_ibf_id;
+
+        // A bin that is not merged points to its own IBF.
+        std::vector<uint64_t> levels(ibf_vector.size());
+        std::vector<bool> visited(ibf_vector.size());
+        std::vector<size_t> stack{0u};
+        visited[0] = true;
+        while (!stack.empty())
+        {
+            size_t const ibf_idx = stack.back();
+            stack.pop_back();
+            for (size_t const child : next_ibf_id[ibf_idx])
+            {
+                if (visited[child])
+                    continue;
+                visited[child] = true;
+                levels[child] = levels[ibf_idx] + 1u;
+                stack.push_back(child);
+            }
+        }
+
+        metadata.ibfs.resize(ibf_vector.size());
+        parallel_for_each_section(ibf_vector.size(),
+                                  threads,
+                                  [&](size_t const i)
+                                  {
+                                      metadata.ibfs[i] = describe_ibf(ibf_vector[i], levels[i], 1u);
+                                  });
+        metadata.fixed.hash_function_count = ibf_vector[0].hash_function_count();
+    }
+    else
+    {
+        metadata.ibfs.push_back(describe_ibf(index.ibf(), 0u, threads));
+        metadata.fixed.hash_function_count = index.ibf().hash_function_count();
+    }
+
+    metadata.fixed.number_of_ibfs = metadata.ibfs.size();
+    return metadata;
+}
+
+} // namespace detail
+
+//!\brief Whether the file is an index container. Otherwise, it is an index written by a previous version.
+inline bool is_index_container(std::filesystem::path const & path)
+{
+    std::array<char, 8> magic{};
+    std::ifstream is{path, std::ios::binary};
+    is.read(magic.data(), magic.size());
+    return is.good() && magic == detail::index_container_magic;
+}
+
+//!\brief The compression of an index. Indices written by previous versions are not compressed.
+inline index_compression read_index_compression(std::filesystem::path const & path)
+{
+    if (!is_index_container(path))
+        return index_compression::none;
+
+    detail::index_file const file{path, O_RDONLY};
+    return detail::read_compression(file);
+}
+
+/*!\brief Reads the metadata of an index without reading the index.
+ * \returns The metadata, or `std::nullopt` if the index was written by a previous version.
+ */
+inline std::optional<index_metadata> read_index_metadata(std::filesystem::path const & path)
+{
+    if (!is_index_container(path))
+        return std::nullopt;
+
+    detail::index_file const file{path, O_RDONLY};
+    return detail::read_metadata(file, detail::read_section_table(file));
+}
+
+//!\brief Writes the index to `path` in the index container format, using `threads` threads.
+template <typename data_t>
+void write_index_container(std::filesystem::path const & path,
+                           raptor_index<data_t> & index,
+                           uint8_t const threads,
+                           index_compression const compression = index_compression::none)
+{
+    detail::index_file const file{path, O_WRONLY | O_CREAT | O_TRUNC};
+    index_metadata const metadata = detail::make_metadata(index, threads);
+    std::string shell{};
+
+    auto serialise_shell = [&index, &shell](auto &&... additional_values)
+    {
+        std::ostringstream stream{};
+        cereal::BinaryOutputArchive oarchive{stream};
+        oarchive(index, additional_values...);
+        shell = std::move(stream).str();
+    };
+
+    if constexpr (index_structure::is_hibf<data_t>)
+    {
+        // The IBFs are written to their own sections.
+        auto & ibf_vector = index.ibf().ibf_vector;
+        auto ibfs = std::move(ibf_vector);
+        ibf_vector.clear();
+        serialise_shell();
+        ibf_vector = std::move(ibfs);
+
+        std::vector<uint64_t> sizes(ibf_vector.size() + 1u);
+        sizes[0] = shell.size();
+
+        if (compression != index_compression::none)
+        {
+            // Each IBF is compressed by one thread.
+            std::vector<detail::compressed_section> compressed(ibf_vector.size());
+            detail::parallel_for_each_section(ibf_vector.size(),
+                                              threads,
+                                              [&](size_t const i)
+                                              {
+                                                  std::ostringstream stream{};
+                                                  {
+                                                      cereal::BinaryOutputArchive oarchive{stream};
+                                                      oarchive(ibf_vector[i]);
+                                                  }
+                                                  std::string const serialised = std::move(stream).str();
+                                                  compressed[i] = detail::compress_section(compression,
+                                                                                           serialised.data(),
+                                                                                           serialised.size(),
+                                                                                           1u);
+                                                  sizes[i + 1u] = compressed[i].size();
+                                              });
+
+            std::vector<index_section> const sections = detail::layout_sections(sizes, metadata);
+            detail::write_section_table(file, sections, compression, metadata);
+            file.write_at(shell.data(), shell.size(), sections[0].offset);
+            detail::parallel_for_each_section(ibf_vector.size(),
+                                              threads,
+                                              [&](size_t const i)
+                                              {
+                                                  compressed[i].write(file, sections[i + 1u].offset, 1u);
+                                              });
+            return;
+        }
+
+        detail::parallel_for_each_section(ibf_vector.size(),
+                                          threads,
+                                          [&](size_t const i)
+                                          {
+                                              detail::byte_counter counter{};
+                                              std::ostream stream{&counter};
+                                              cereal::BinaryOutputArchive oarchive{stream};
+                                              oarchive(ibf_vector[i]);
+                                              sizes[i + 1u] = counter.size();
+                                          });
+
+        std::vector<index_section> const sections = detail::layout_sections(sizes, metadata);
+        detail::write_section_table(file, sections, compression, metadata);
+        file.write_at(shell.data(), shell.size(), sections[0].offset);
+        detail::parallel_for_each_section(ibf_vector.size(),
+                                          threads,
+                                          [&](size_t const i)
+                                          {
+                                              detail::section_writer writer{file, sections[i + 1u].offset};
+                                              std::ostream stream{&writer};
+                                              stream.exceptions(std::ios::badbit);
+                                              {
+                                                  cereal::BinaryOutputArchive oarchive{stream};
+                                                  oarchive(ibf_vector[i]);
+                                              }
+                                              stream.flush();
+                                              assert(writer.size() == sections[i + 1u].size);
+                                          });
+    }
+    else
+    {
+        // The shell has an IBF with one row, and the bin size is stored after it.
+        data_t ibf = std::move(index.ibf());
+        uint64_t const bin_size = ibf.bin_size();
+        index.ibf() = data_t{seqan::hibf::bin_count{ibf.bin_count()},
+                             seqan::hibf::bin_size{1u},
+                             seqan::hibf::hash_function_count{ibf.hash_function_count()}};
+        serialise_shell(bin_size);
+        index.ibf() = std::move(ibf);
+
+        uint64_t const bytes = detail::bit_vector_bytes(index.ibf());
+        char const * const data = reinterpret_cast<char const *>(index.ibf().data());
+
+        if (compression != index_compression::none)
+        {
+            detail::compressed_section const compressed = detail::compress_section(compression, data, bytes, threads);
+            std::vector<index_section> const sections =
+                detail::layout_sections({shell.size(), compressed.size()}, metadata);
+            detail::write_section_table(file, sections, compression, metadata);
+            file.write_at(shell.data(), shell.size(), sections[0].offset);
+            compressed.write(file, sections[1].offset, threads);
+            return;
+        }
+
+        std::vector<index_section> const sections = detail::layout_sections({shell.size(), bytes}, metadata);
+        detail::write_section_table(file, sections, compression, metadata);
+        file.write_at(shell.data(), shell.size(), sections[0].offset);
+
+        detail::transfer_chunks(bytes,
+                                threads,
+                                [&](uint64_t const offset, uint64_t const size)
+                                {
+                                    file.write_at(data + offset, size, sections[1].offset + offset);
+                                });
+    }
+}
+
+//!\brief Reads the index from `path`, using `threads` threads. Indices written by previous versions are supported.
+template <typename data_t>
+void read_index_container(raptor_index<data_t> & index, std::filesystem::path const & path, uint8_t const threads)
+{
+    if (!is_index_container(path))
+    {
+        std::ifstream is{path, std::ios::binary};
+        cereal::BinaryInputArchive iarchive{is};
+        iarchive(index);
+        return;
+    }
+
+    detail::index_file const file{path, O_RDONLY};
+    index_compression const compression = detail::read_compression(file);
+    std::vector<index_section> const sections = detail::read_section_table(file);
+    detail::section_reader reader{file, sections[0]};
+    std::istream stream{&reader};
+    stream.exceptions(std::ios::badbit);
+    cereal::BinaryInputArchive iarchive{stream};
+    iarchive(index);
+
+    if constexpr (index_structure::is_hibf<data_t>)
+    {
+        auto & ibf_vector = index.ibf().ibf_vector;
+        ibf_vector.resize(sections.size() - 1u);
+
+        // The largest IBFs are read first.
+        std::vector<size_t> order(ibf_vector.size());
+        std::iota(order.begin(), order.end(), size_t{});
+        std::ranges::stable_sort(order,
+                                 [&sections](size_t const lhs, size_t const rhs)
+                                 {
+                                     return sections[lhs + 1u].size > sections[rhs + 1u].size;
+                                 });
+
+        detail::parallel_for_each_section(ibf_vector.size(),
+                                          threads,
+                                          [&](size_t const i)
+                                          {
+                                              size_t const ibf_idx = order[i];
+                                              detail::read_cereal_section(file,
+                                                                          sections[ibf_idx + 1u],
+                                                                          compression,
+                                                                          ibf_vector[ibf_idx]);
+                                          });
+    }
+    else
+    {
+        uint64_t bin_size{};
+        iarchive(bin_size);
+
+        data_t & ibf = index.ibf();
+        seqan::hibf::bin_count const bins{ibf.bin_count()};
+        seqan::hibf::hash_function_count const hash{ibf.hash_function_count()};
+        // The bit vector is overwritten below. Without zeroing, its pages are first touched by the reading threads.
+        // seqan::hibf::interleaved_bloom_filter always zeroes its bit vector, on this thread.
+        if constexpr (index_structure::is_blocked_ibf<data_t>)
+            ibf = data_t{bins, seqan::hibf::bin_size{bin_size}, hash, blocked_bloom_filter::uninitialised};
+        else
+            ibf = data_t{bins, seqan::hibf::bin_size{bin_size}, hash};
+
+        uint64_t const bytes = detail::bit_vector_bytes(ibf);
+        char * const data = reinterpret_cast<char *>(ibf.data());
+        if (sections.size() != 2u)
+            throw std::runtime_error{"Cannot read index: " + path.string() + " is corrupted."};
+
+        if (compression != index_compression::none)
+        {
+            detail::decompress_section(file, sections[1], compression, data, bytes, threads);
+            return;
+        }
+
+        if (sections[1].size != bytes)
+            throw std::runtime_error{"Cannot read index: " + path.string() + " is corrupted."};
+
+        detail::transfer_chunks(bytes,
+                                threads,
+                                [&](uint64_t const offset, uint64_t const size)
+                                {
+                                    file.read_at(data + offset, size, sections[1].offset + offset);
+                                });
+    }
+}
+
+//!\brief Reads the parameters of the index, but not the IBFs. See raptor::raptor_index::load_parameters.
+template <typename data_t>
+void read_index_parameters(raptor_index<data_t> & index, std::filesystem::path const & path)
+{
+    if (!is_index_container(path))
+    {
+        std::ifstream is{path, std::ios::binary};
+        cereal::BinaryInputArchive iarchive{is};
+        index.load_parameters(iarchive);
+        return;
+    }
+
+    detail::index_file const file{path, O_RDONLY};
+    std::vector<index_section> const sections = detail::read_section_table(file);
+    detail::section_reader reader{file, sections[0]};
+    std::istream stream{&reader};
+    stream.exceptions(std::ios::badbit);
+    cereal::BinaryInputArchive iarchive{stream};
+    index.load_parameters(iarchive);
+}
+
+} // namespace raptor
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::index_metadata.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace raptor
+{
+
+/*!\brief A summary of an index that is stored in a fixed layout in front of the index.
+ * \details
+ * The metadata is written by raptor::write_index_container and read by raptor::read_index_metadata without reading
+ * any other part of the index. All fields have 8 bytes.
+ */
+struct index_metadata
+{
+    //!\brief The dimensions and the occupancy of one IBF. For the IBF index, there is exactly one.
+    struct ibf_type
+    {
+        //!\brief The number of technical bins.
+        uint64_t bin_count{};
+        //!\brief The size of the bit vector in bits.
+        uint64_t bit_size{};
+        //!\brief The level in the HIBF. The top-level IBF has level 0.
+        uint64_t level{};
+        //!\brief The number of bits that are set.
+        uint64_t set_bits{};
+
+        bool operator==(ibf_type const &) const = default;
+    };
+
+    //!\brief The fields with a fixed size.
+    struct fixed_type
+    {
+        //!\brief The version of raptor::raptor_index.
+        uint64_t index_version{};
+        uint64_t window_size{};
+        //!\brief The shape, one bit per position. The least significant bit is the last position.
+        uint64_t shape{};
+        uint64_t shape_size{};
+        uint64_t parts{};
+        uint64_t number_of_user_bins{};
+        uint64_t hash_function_count{};
+        double fpr{};
+        uint64_t is_hibf{};
+        uint64_t is_blocked_ibf{};
+        //!\brief A raptor::sketch_kind.
+        uint64_t sketch{};
+        //!\brief A raptor::hash_partitioning. Only relevant if there are multiple parts.
+        uint64_t partitioning{};
+        //!\brief The number of raptor::index_metadata::ibf_type that follow.
+        uint64_t number_of_ibfs{};
+
+        bool operator==(fixed_type const &) const = default;
+    };
+
+    //!\brief Changes with the layout. Metadata with a different layout is not read.
+    static constexpr std::array<char, 8> magic{'R', 'A', 'P', 'T', 'O', 'R', 'M', '3'};
+
+    fixed_type fixed{};
+    std::vector<ibf_type> ibfs{};
+
+    //!\brief The size of the metadata in the file.
+    uint64_t size_in_bytes() const noexcept
+    {
+        return magic.size() + sizeof(fixed_type) + ibfs.size() * sizeof(ibf_type);
+    }
+
+    uint64_t bit_size() const noexcept
+    {
+        uint64_t result{};
+        for (ibf_type const & ibf : ibfs)
+            result += ibf.bit_size;
+        return result;
+    }
+
+    uint64_t set_bits() const noexcept
+    {
+        uint64_t result{};
+        for (ibf_type const & ibf : ibfs)
+            result += ibf.set_bits;
+        return result;
+    }
+
+    //!\brief The shape as a pattern of 0 and 1.
+    std::string shape_string() const
+    {
+        std::string result(fixed.shape_size, '0');
+        for (size_t i = 0; i < fixed.shape_size; ++i)
+            if ((fixed.shape >> i) & 1u)
+                result[fixed.shape_size - 1u - i] = '1';
+        return result;
+    }
+
+    bool operator==(index_metadata const &) const = default;
+};
+
+static_assert(sizeof(index_metadata::ibf_type) == 4u * sizeof(uint64_t));
+static_assert(sizeof(index_metadata::fixed_type) == 13u * sizeof(uint64_t));
+
+} // namespace raptor
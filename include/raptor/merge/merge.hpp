@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::raptor_merge.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <raptor/argument_parsing/merge_arguments.hpp>
+
+namespace raptor
+{
+
+void raptor_merge(merge_arguments const & arguments);
+
+} // namespace raptor
@@ -0,0 +1,447 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::minimiser_file_input, raptor::minimiser_file_output, and raptor::write_minimiser_file.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define RAPTOR_HAS_MMAP 1
+#else
+#    define RAPTOR_HAS_MMAP 0 // GCOVR_EXCL_LINE
+#endif
+
+#include <raptor/sketch.hpp>
+
+namespace raptor
+{
+
+/*!\brief The header of a minimiser file in the compressed format (version 3).
+ * \details
+ * Layout of a file:
+ * 1. `magic`, followed by the members of this struct in declaration order, each in little endian.
+ * 2. The blocks. Each block stores up to `values_per_block` sorted minimisers: the first minimiser as 8 bytes,
+ *    followed by the differences to the respective previous minimiser as LEB128 varints.
+ * 3. The block index at `index_offset`: the file offset of each block as 8 bytes.
+ *
+ * Version 2 has `previous_magic` and no `sketch`; its values are minimisers.
+ * Files without a magic are in the raw format (version 1): unsorted minimisers, 8 bytes each, with the shape,
+ * window size, cutoff, and count in a separate `.header` file.
+ */
+struct minimiser_file_header
+{
+    static constexpr std::array<char, 8> magic{'R', 'A', 'P', 'T', 'M', 'I', 'N', '3'};
+    static constexpr std::array<char, 8> previous_magic{'R', 'A', 'P', 'T', 'M', 'I', 'N', '2'};
+    static constexpr uint64_t default_values_per_block{4096u};
+    //!\brief The size of the magic and the header in bytes.
+    static constexpr size_t size_in_bytes{magic.size() + 8u + 8u + 4u + 1u + 1u + 8u + 8u + 8u};
+    //!\brief The size of the magic and the header of version 2 in bytes.
+    static constexpr size_t previous_size_in_bytes{size_in_bytes - 1u};
+
+    uint64_t count{};
+    uint64_t shape{}; // The shape as bit pattern, e.g., 0b1101.
+    uint32_t window_size{};
+    uint8_t cutoff{};
+    sketch_kind sketch{};
+    uint64_t values_per_block{default_values_per_block};
+    uint64_t number_of_blocks{};
+    uint64_t index_offset{};
+};
+
+namespace detail
+{
+
+inline void write_varint(std::vector<char> & buffer, uint64_t value)
+{
+    while (value >= 0x80u)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7Fu) | 0x80u));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+inline uint64_t read_varint(char const *& it)
+{
+    uint64_t value{};
+    for (int shift = 0;; shift += 7)
+    {
+        uint8_t const byte = static_cast<uint8_t>(*it++);
+        value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+        if (!(byte & 0x80u))
+            return value;
+    }
+}
+
+template <typename value_t>
+void write_value(std::ostream & stream, value_t const value)
+{
+    stream.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+template <typename value_t>
+void read_value(char const *& it, value_t & value)
+{
+    std::memcpy(&value, it, sizeof(value));
+    it += sizeof(value);
+}
+
+[[noreturn]] inline void minimiser_file_error(std::filesystem::path const & path, int const err = errno)
+{
+    std::ostringstream oss;
+    oss << "Failed to open file: " << std::quoted(path.string());
+    throw std::system_error(err, std::generic_category(), oss.str());
+}
+
+} // namespace detail
+
+/*!\brief Writes minimisers in the compressed format, one minimiser at a time.
+ * \details
+ * The minimisers must be pushed in ascending order and must not contain duplicates. Only one block is kept in memory.
+ * The file is complete after calling `close()`.
+ */
+class minimiser_file_output
+{
+public:
+    minimiser_file_output() = delete;
+    minimiser_file_output(minimiser_file_output const &) = delete;
+    minimiser_file_output & operator=(minimiser_file_output const &) = delete;
+    minimiser_file_output(minimiser_file_output &&) = default;
+    minimiser_file_output & operator=(minimiser_file_output &&) = default;
+    ~minimiser_file_output() = default;
+
+    /*!\brief Creates the file.
+     * \param[in] path The output file.
+     * \param[in] header The shape, window size, cutoff, and sketch. The other members are set when closing the file.
+     */
+    minimiser_file_output(std::filesystem::path const & path, minimiser_file_header header) :
+        header_{std::move(header)},
+        stream{path, std::ios::binary}
+    {
+        assert(header_.values_per_block > 0u);
+        header_.count = 0u;
+
+        if (!stream.is_open())
+            detail::minimiser_file_error(path); // GCOVR_EXCL_LINE
+
+        write_header(); // The index offset is known after writing the blocks.
+        block.reserve(header_.values_per_block);
+    }
+
+    void push_back(uint64_t const value)
+    {
+        assert(block.empty() || block.back() < value);
+
+        block.push_back(value);
+        if (block.size() == header_.values_per_block)
+            write_block();
+    }
+
+    //!\brief Writes the last block, the block index, and the header.
+    void close()
+    {
+        write_block();
+        header_.number_of_blocks = block_offsets.size();
+        header_.index_offset = offset;
+        stream.write(reinterpret_cast<char const *>(block_offsets.data()), block_offsets.size() * sizeof(uint64_t));
+        stream.seekp(0);
+        write_header();
+        stream.close();
+    }
+
+private:
+    minimiser_file_header header_{};
+    std::ofstream stream{};
+    std::vector<uint64_t> block{};
+    std::vector<char> buffer{};
+    std::vector<uint64_t> block_offsets{};
+    uint64_t offset{minimiser_file_header::size_in_bytes};
+
+    void write_header()
+    {
+        stream.write(minimiser_file_header::magic.data(), minimiser_file_header::magic.size());
+        detail::write_value(stream, header_.count);
+        detail::write_value(stream, header_.shape);
+        detail::write_value(stream, header_.window_size);
+        detail::write_value(stream, header_.cutoff);
+        detail::write_value(stream, header_.sketch);
+        detail::write_value(stream, header_.values_per_block);
+        detail::write_value(stream, header_.number_of_blocks);
+        detail::write_value(stream, header_.index_offset);
+    }
+
+    void write_block()
+    {
+        if (block.empty())
+            return;
+
+        buffer.clear();
+        buffer.resize(sizeof(uint64_t));
+        std::memcpy(buffer.data(), &block[0], sizeof(uint64_t));
+        for (size_t i = 1; i < block.size(); ++i)
+            detail::write_varint(buffer, block[i] - block[i - 1u]);
+
+        block_offsets.push_back(offset);
+        stream.write(buffer.data(), buffer.size());
+        offset += buffer.size();
+        header_.count += block.size();
+        block.clear();
+    }
+};
+
+/*!\brief Writes minimisers in the compressed format.
+ * \param[in] path The output file.
+ * \param[in] values The minimisers. Must be sorted and must not contain duplicates.
+ * \param[in] header The shape, window size, cutoff, and sketch. The other members are set by this function.
+ */
+inline void write_minimiser_file(std::filesystem::path const & path,
+                                 std::span<uint64_t const> const values,
+                                 minimiser_file_header header)
+{
+    assert(std::ranges::is_sorted(values));
+
+    minimiser_file_output output{path, std::move(header)};
+    for (uint64_t const value : values)
+        output.push_back(value);
+    output.close();
+}
+
+/*!\brief Reads minimiser files in the compressed and in the raw format.
+ * \details
+ * If available, the file is mapped into memory and advised for sequential access. Otherwise, the file is read in
+ * large chunks. In both cases, minimisers are decoded into a buffer and the callback is invoked by iterating over a
+ * `std::span<uint64_t const>`.
+ * Throws a std::system_error if the file cannot be opened.
+ */
+class minimiser_file_input
+{
+public:
+    //!\brief The number of minimisers of the raw format that are processed at once.
+    static constexpr uint64_t raw_values_per_chunk{1ULL << 16};
+
+    minimiser_file_input() = delete;
+    minimiser_file_input(minimiser_file_input const &) = delete;
+    minimiser_file_input & operator=(minimiser_file_input const &) = delete;
+    minimiser_file_input(minimiser_file_input &&) = default;
+    minimiser_file_input & operator=(minimiser_file_input &&) = default;
+    ~minimiser_file_input() = default;
+
+    explicit minimiser_file_input(std::filesystem::path const & path)
+    {
+#if RAPTOR_HAS_MMAP
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) [[unlikely]]
+            detail::minimiser_file_error(path);
+
+        struct stat status{};
+        if (::fstat(fd, &status) == -1) [[unlikely]]
+        {
+            int const err = errno;                   // GCOVR_EXCL_LINE
+            ::close(fd);                             // GCOVR_EXCL_LINE
+            detail::minimiser_file_error(path, err); // GCOVR_EXCL_LINE
+        }
+        file_size = static_cast<uint64_t>(status.st_size);
+
+        if (file_size > 0u)
+        {
+            void * const address = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            int const err = errno;
+            ::close(fd);
+            if (address == MAP_FAILED) [[unlikely]]
+                detail::minimiser_file_error(path, err); // GCOVR_EXCL_LINE
+            ::madvise(address, file_size, MADV_SEQUENTIAL);
+            mapping = mapping_t{static_cast<char const *>(address), unmapper{file_size}};
+        }
+        else
+        {
+            ::close(fd);
+        }
+#else
+        stream.open(path, std::ios::binary);
+        if (!stream.is_open()) [[unlikely]]
+            detail::minimiser_file_error(path);
+        file_size = std::filesystem::file_size(path);
+#endif
+
+        constexpr size_t magic_size = minimiser_file_header::magic.size();
+        if (file_size >= minimiser_file_header::previous_size_in_bytes)
+        {
+            char const * it = bytes(0u, minimiser_file_header::previous_size_in_bytes).data();
+            bool const is_current = std::equal(it, it + magic_size, minimiser_file_header::magic.begin())
+                                 && file_size >= minimiser_file_header::size_in_bytes;
+            bool const is_previous = std::equal(it, it + magic_size, minimiser_file_header::previous_magic.begin());
+            if (is_current || is_previous)
+            {
+                if (is_current)
+                    it = bytes(0u, minimiser_file_header::size_in_bytes).data();
+                it += magic_size;
+                minimiser_file_header & result = header_.emplace();
+                detail::read_value(it, result.count);
+                detail::read_value(it, result.shape);
+                detail::read_value(it, result.window_size);
+                detail::read_value(it, result.cutoff);
+                if (is_current)
+                    detail::read_value(it, result.sketch);
+                detail::read_value(it, result.values_per_block);
+                detail::read_value(it, result.number_of_blocks);
+                detail::read_value(it, result.index_offset);
+                count = result.count;
+                return;
+            }
+        }
+
+        count = file_size / sizeof(uint64_t);
+    }
+
+    //!\brief Whether the file is in the compressed format.
+    bool is_compressed() const noexcept
+    {
+        return header_.has_value();
+    }
+
+    //!\brief The header. Only available for the compressed format.
+    std::optional<minimiser_file_header> const & header() const noexcept
+    {
+        return header_;
+    }
+
+    //!\brief The number of minimisers in the file.
+    uint64_t size() const noexcept
+    {
+        return count;
+    }
+
+    //!\brief Calls `callback(minimiser)` for the minimisers in `[first, first + length)`.
+    void for_each(uint64_t const first, uint64_t const length, auto && callback)
+    {
+        uint64_t const last = std::min(count, first + std::min(length, count));
+        if (first >= last)
+            return;
+
+        auto invoke = [&callback](std::span<uint64_t const> const values)
+        {
+            for (uint64_t const value : values)
+                callback(value);
+        };
+
+        if (!is_compressed())
+        {
+#if RAPTOR_HAS_MMAP
+            // The mapping is page-aligned, hence the values can be used in place.
+            std::span<char const> const raw = bytes(first * sizeof(uint64_t), (last - first) * sizeof(uint64_t));
+            if (reinterpret_cast<std::uintptr_t>(raw.data()) % alignof(uint64_t) == 0u)
+            {
+                invoke(std::span<uint64_t const>{reinterpret_cast<uint64_t const *>(raw.data()), last - first});
+                return;
+            }
+#endif
+            // Otherwise, the values are copied chunk by chunk.
+            for (uint64_t begin = first; begin < last; begin += raw_values_per_chunk)
+            {
+                uint64_t const end = std::min(last, begin + raw_values_per_chunk);
+                std::span<char const> const chunk = bytes(begin * sizeof(uint64_t), (end - begin) * sizeof(uint64_t));
+                values.resize(end - begin);
+                std::memcpy(values.data(), chunk.data(), chunk.size());
+                invoke(values);
+            }
+            return;
+        }
+
+        minimiser_file_header const & header = *header_;
+        uint64_t const first_block = first / header.values_per_block;
+        uint64_t const last_block = (last - 1u) / header.values_per_block;
+
+        // The offsets of the blocks, followed by the end of the last block.
+        uint64_t const index_entries = std::min(last_block + 2u, header.number_of_blocks) - first_block;
+        std::vector<uint64_t> offsets(index_entries);
+        std::span<char const> const index =
+            bytes(header.index_offset + first_block * sizeof(uint64_t), index_entries * sizeof(uint64_t));
+        std::memcpy(offsets.data(), index.data(), index.size());
+        if (last_block + 1u == header.number_of_blocks)
+            offsets.push_back(header.index_offset);
+
+        uint64_t position = first_block * header.values_per_block;
+        for (size_t block = 0; block < offsets.size() - 1u; ++block)
+        {
+            uint64_t const block_size = std::min(header.values_per_block, count - position);
+            char const * it = bytes(offsets[block], offsets[block + 1u] - offsets[block]).data();
+
+            values.resize(block_size);
+            std::memcpy(values.data(), it, sizeof(uint64_t));
+            it += sizeof(uint64_t);
+            for (size_t i = 1; i < block_size; ++i)
+                values[i] = values[i - 1u] + detail::read_varint(it);
+
+            // Only the first and the last block may be partially requested.
+            uint64_t const skip = first > position ? first - position : 0u;
+            uint64_t const keep = std::min(block_size, last - position);
+            invoke(std::span<uint64_t const>{values}.subspan(skip, keep - skip));
+            position += block_size;
+        }
+    }
+
+private:
+#if RAPTOR_HAS_MMAP
+    struct unmapper
+    {
+        size_t size{};
+
+        void operator()(char const * const address) const noexcept
+        {
+            ::munmap(const_cast<char *>(address), size);
+        }
+    };
+
+    using mapping_t = std::unique_ptr<char const, unmapper>;
+
+    mapping_t mapping{nullptr, unmapper{}};
+#else
+    std::ifstream stream{};
+    std::vector<char> buffer{};
+#endif
+    std::optional<minimiser_file_header> header_{};
+    uint64_t file_size{};
+    uint64_t count{};
+    std::vector<uint64_t> values{};
+
+    // Returns `length` bytes starting at `offset`. Only valid until the next call.
+    std::span<char const> bytes(uint64_t const offset, uint64_t const length)
+    {
+        assert(offset + length <= file_size);
+#if RAPTOR_HAS_MMAP
+        return {mapping.get() + offset, length};
+#else
+        buffer.resize(length);
+        stream.seekg(offset);
+        stream.read(buffer.data(), length);
+        return {buffer.data(), length};
+#endif
+    }
+};
+
+} // namespace raptor
@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::perf_counter_group, raptor::serial_perf_counters, and raptor::concurrent_perf_counters.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+#if __has_include(<linux/perf_event.h>)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    define RAPTOR_HAS_PERF_EVENT 1
+#else
+#    define RAPTOR_HAS_PERF_EVENT 0 // GCOVR_EXCL_LINE
+#endif
+
+namespace raptor
+{
+
+/*!\brief A group of hardware performance counters of the calling thread.
+ * \details
+ * Uses `perf_event_open` to count cycles, instructions, last level cache misses, and data TLB misses. Only events in
+ * user space are counted.
+ * If `perf_event_open` is not available, e.g., because of `/proc/sys/kernel/perf_event_paranoid` or missing
+ * permissions in a container, or if a single event is not supported by the CPU, the affected counters are not
+ * available and reading them is a no-op.
+ * The counters measure the thread that constructed the group. Hence, a group must be constructed and read on the
+ * same thread.
+ */
+class perf_counter_group
+{
+public:
+    static constexpr size_t number_of_events{4u};
+    static constexpr std::array<std::string_view, number_of_events> event_names{"cycles",
+                                                                                "instructions",
+                                                                                "llc_misses",
+                                                                                "dtlb_misses"};
+
+    using values_t = std::array<uint64_t, number_of_events>;
+
+    perf_counter_group() = default;
+    perf_counter_group(perf_counter_group const &) = delete;             // File descriptors
+    perf_counter_group & operator=(perf_counter_group const &) = delete; // File descriptors
+    perf_counter_group(perf_counter_group &&) = delete;                  // File descriptors
+    perf_counter_group & operator=(perf_counter_group &&) = delete;      // File descriptors
+
+    ~perf_counter_group()
+    {
+#if RAPTOR_HAS_PERF_EVENT
+        for (int const fd : fds)
+            if (fd != -1)
+                close(fd);
+#endif
+    }
+
+    explicit perf_counter_group(bool const enabled)
+    {
+#if RAPTOR_HAS_PERF_EVENT
+        if (!enabled)
+            return;
+
+        constexpr uint64_t dtlb_read_miss = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        constexpr std::array<std::pair<uint32_t, uint64_t>, number_of_events> events{
+            {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+             {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+             {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+             {PERF_TYPE_HW_CACHE, dtlb_read_miss}}};
+
+        for (size_t i = 0; i < number_of_events; ++i)
+        {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(perf_event_attr);
+            attributes.type = events[i].first;
+            attributes.config = events[i].second;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+
+            // pid = 0, cpu = -1: The calling thread on any CPU.
+            long const fd = syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0);
+            if (fd == -1)
+                continue;
+
+            fds[i] = static_cast<int>(fd);
+            if (ioctl(fds[i], PERF_EVENT_IOC_ID, &ids[i]) == -1)
+            {
+                close(fds[i]); // GCOVR_EXCL_LINE
+                fds[i] = -1;   // GCOVR_EXCL_LINE
+                continue;      // GCOVR_EXCL_LINE
+            }
+
+            if (leader == -1)
+                leader = fds[i];
+        }
+#else
+        (void)enabled; // GCOVR_EXCL_LINE
+#endif
+    }
+
+    bool is_available() const noexcept
+    {
+        return leader != -1;
+    }
+
+    bool is_available(size_t const event) const noexcept
+    {
+        return fds[event] != -1;
+    }
+
+    //!\brief Reads the current values. Returns `false` if the counters are not available.
+    bool read(values_t & values) const noexcept
+    {
+#if RAPTOR_HAS_PERF_EVENT
+        if (leader == -1)
+            return false;
+
+        struct
+        {
+            uint64_t number_of_values;
+            struct
+            {
+                uint64_t value;
+                uint64_t id;
+            } entries[number_of_events];
+        } data{};
+
+        if (::read(leader, &data, sizeof(data)) <= 0)
+            return false; // GCOVR_EXCL_LINE
+
+        for (size_t i = 0; i < data.number_of_values && i < number_of_events; ++i)
+            for (size_t event = 0; event < number_of_events; ++event)
+                if (fds[event] != -1 && ids[event] == data.entries[i].id)
+                    values[event] = data.entries[i].value;
+
+        return true;
+#else
+        (void)values;  // GCOVR_EXCL_LINE
+        return false;  // GCOVR_EXCL_LINE
+#endif
+    }
+
+private:
+    std::array<int, number_of_events> fds{-1, -1, -1, -1};
+    std::array<uint64_t, number_of_events> ids{};
+    int leader{-1};
+};
+
+/*!\brief Accumulates the hardware performance counters between start() and stop().
+ * \details
+ * The counterpart of seqan::hibf::serial_timer. Multiple objects may share a raptor::perf_counter_group, e.g., one
+ * per stage. All operations are no-ops if the counters are not available.
+ */
+class serial_perf_counters
+{
+public:
+    serial_perf_counters() = delete;
+    serial_perf_counters(serial_perf_counters const &) = default;
+    serial_perf_counters & operator=(serial_perf_counters const &) = delete; // Reference member
+    serial_perf_counters(serial_perf_counters &&) = default;
+    serial_perf_counters & operator=(serial_perf_counters &&) = delete; // Reference member
+    ~serial_perf_counters() = default;
+
+    explicit serial_perf_counters(perf_counter_group const & group) : group{group}
+    {}
+
+    void start() noexcept
+    {
+        group.read(start_values);
+    }
+
+    void stop() noexcept
+    {
+        perf_counter_group::values_t stop_values{};
+        if (!group.read(stop_values))
+            return;
+
+        for (size_t event = 0; event < perf_counter_group::number_of_events; ++event)
+            totals[event] += stop_values[event] - start_values[event];
+    }
+
+    perf_counter_group const & counter_group() const noexcept
+    {
+        return group;
+    }
+
+    uint64_t value(size_t const event) const noexcept
+    {
+        return totals[event];
+    }
+
+private:
+    perf_counter_group const & group;
+    perf_counter_group::values_t start_values{};
+    perf_counter_group::values_t totals{};
+};
+
+/*!\brief Thread-safe sum of raptor::serial_perf_counters.
+ * \details
+ * The counterpart of seqan::hibf::concurrent_timer. Like the timers, the counts are not copied upon copy
+ * construction/assignment.
+ */
+class concurrent_perf_counters
+{
+public:
+    concurrent_perf_counters() = default;
+    concurrent_perf_counters(concurrent_perf_counters const &)
+    {}
+    concurrent_perf_counters & operator=(concurrent_perf_counters const &)
+    {
+        return *this;
+    }
+    ~concurrent_perf_counters() = default;
+
+    concurrent_perf_counters & operator+=(serial_perf_counters const & other) noexcept
+    {
+        for (size_t event = 0; event < perf_counter_group::number_of_events; ++event)
+        {
+            if (other.counter_group().is_available(event))
+            {
+                totals[event].fetch_add(other.value(event), std::memory_order_relaxed);
+                available[event].store(true, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    bool is_available(size_t const event) const noexcept
+    {
+        return available[event].load(std::memory_order_relaxed);
+    }
+
+    uint64_t value(size_t const event) const noexcept
+    {
+        return totals[event].load(std::memory_order_relaxed);
+    }
+
+    /*!\brief Prints the counters as part of the timing tree.
+     * \param[in,out] stream The output stream.
+     * \param[in] prefix The prefix of each line, e.g., the indentation in the tree.
+     */
+    void print(std::ostream & stream, std::string_view const prefix) const
+    {
+        constexpr std::array<std::string_view, perf_counter_group::number_of_events> labels{"Cycles",
+                                                                                            "Instructions",
+                                                                                            "LLC misses",
+                                                                                            "dTLB misses"};
+
+        for (size_t event = 0; event < perf_counter_group::number_of_events; ++event)
+        {
+            stream << prefix << (event + 1u == perf_counter_group::number_of_events ? "└── " : "├── ")
+                   << labels[event] << ": ";
+            if (is_available(event))
+                stream << value(event);
+            else
+                stream << "Not available";
+
+            // Instructions per cycle
+            if (event == 1u && is_available(0u) && is_available(1u) && value(0u) > 0u)
+                stream << " (IPC " << static_cast<double>(value(1u)) / value(0u) << ')';
+            stream << '\n';
+        }
+    }
+
+    //!\brief Writes the column names for the TSV timing file. Each name is preceded by a tab.
+    static void write_header(std::ostream & stream, std::string_view const stage)
+    {
+        for (std::string_view const name : perf_counter_group::event_names)
+            stream << '\t' << stage << '_' << name;
+    }
+
+    //!\brief Writes the values for the TSV timing file. Each value is preceded by a tab.
+    void write_values(std::ostream & stream) const
+    {
+        for (size_t event = 0; event < perf_counter_group::number_of_events; ++event)
+        {
+            if (is_available(event))
+                stream << '\t' << value(event);
+            else
+                stream << "\tNA";
+        }
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, perf_counter_group::number_of_events> totals{};
+    std::array<std::atomic<bool>, perf_counter_group::number_of_events> available{};
+};
+
+} // namespace raptor
@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::minimiser_counter.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace raptor
+{
+
+/*!\brief Counts the occurrences of minimisers within a memory limit.
+ * \details
+ * Minimisers are collected in a buffer. When the buffer is full, it is sorted and written to a temporary file as a
+ * run of (minimiser, occurrences) pairs. Afterwards, the runs are merged. If no run was written, the buffer is
+ * processed in memory.
+ * At most `max_fan_in` runs are merged at once, hence at most `max_fan_in + 1` files are open. If there are more runs,
+ * they are first merged into fewer runs. The runs are read and written in chunks that together fit into the memory
+ * limit.
+ * The result is the same as counting with a hash table. Like in raptor::compute_minimiser, occurrences are capped at
+ * 254 because the biggest cutoff is 254.
+ * The temporary files are removed on destruction.
+ */
+class minimiser_counter
+{
+public:
+    //!\brief The size of an entry of a run in bytes: The minimiser and its occurrences.
+    static constexpr size_t entry_size{sizeof(uint64_t) + sizeof(uint8_t)};
+    //!\brief The default maximum number of runs that are merged at once.
+    static constexpr size_t default_max_fan_in{16u};
+
+    minimiser_counter() = delete;
+    minimiser_counter(minimiser_counter const &) = delete;
+    minimiser_counter & operator=(minimiser_counter const &) = delete;
+    minimiser_counter(minimiser_counter &&) = delete;
+    minimiser_counter & operator=(minimiser_counter &&) = delete;
+    ~minimiser_counter();
+
+    /*!\brief Creates a counter.
+     * \param[in] run_prefix The path prefix of the temporary files. Run `i` is written to `<run_prefix>_<i>`.
+     * \param[in] memory The size of the buffer in bytes. At least one minimiser is buffered.
+     * \param[in] max_fan_in The maximum number of runs that are merged at once. At least 2.
+     */
+    minimiser_counter(std::filesystem::path run_prefix,
+                      uint64_t const memory,
+                      size_t const max_fan_in = default_max_fan_in);
+
+    void add(uint64_t const minimiser)
+    {
+        buffer.push_back(minimiser);
+        if (buffer.size() == capacity) [[unlikely]]
+            spill();
+    }
+
+    //!\brief The number of runs written to disk, excluding the runs written while merging.
+    size_t number_of_runs() const noexcept
+    {
+        return spilled_runs;
+    }
+
+    /*!\brief Calls `callback(minimiser)` in ascending order for each minimiser with at least `cutoff` occurrences.
+     * \details Must be called at most once.
+     */
+    template <typename callback_t>
+    void for_each(uint8_t const cutoff, callback_t && callback)
+    {
+        if (run_paths.empty())
+        {
+            std::ranges::sort(buffer);
+            for (auto it = buffer.begin(); it != buffer.end();)
+            {
+                uint64_t const minimiser = *it;
+                size_t occurrences{};
+                for (; it != buffer.end() && *it == minimiser; ++it)
+                    ++occurrences;
+
+                if (std::min<size_t>(254u, occurrences) >= cutoff)
+                    callback(minimiser);
+            }
+            buffer = {}; // Free memory.
+            return;
+        }
+
+        spill();
+        buffer = {}; // Free memory.
+
+        while (run_paths.size() > max_fan_in)
+            merge_runs();
+
+        merge(run_paths,
+              [&](uint64_t const minimiser, uint8_t const occurrences)
+              {
+                  if (occurrences >= cutoff)
+                      callback(minimiser);
+              });
+    }
+
+private:
+    //!\brief Reads the entries of a run in chunks.
+    struct run_reader
+    {
+        std::ifstream stream{};
+        std::vector<char> chunk{};
+        size_t position{};
+        size_t end{};
+        uint64_t minimiser{};
+        uint8_t occurrences{};
+
+        void open(std::filesystem::path const & path, size_t const chunk_entries);
+
+        //!\brief Reads the next entry. Returns false if there is none.
+        bool next();
+    };
+
+    //!\brief Writes the entries of a run in chunks.
+    struct run_writer
+    {
+        std::filesystem::path path{};
+        std::ofstream stream{};
+        std::vector<char> chunk{};
+        size_t chunk_bytes{};
+
+        void open(std::filesystem::path const & path, size_t const chunk_entries);
+
+        void push_back(uint64_t const minimiser, uint8_t const occurrences);
+
+        //!\brief Writes the remaining entries and closes the file.
+        void close();
+    };
+
+    std::filesystem::path run_prefix{};
+    std::vector<std::filesystem::path> run_paths{};
+    size_t capacity{};
+    size_t max_fan_in{};
+    size_t chunk_entries{};
+    size_t spilled_runs{};
+    size_t next_run{};
+    std::vector<uint64_t> buffer{};
+
+    //!\brief Returns the path of a new run and adds it to `run_paths`.
+    std::filesystem::path const & new_run();
+
+    //!\brief Sorts the buffer and writes it as run.
+    void spill();
+
+    //!\brief Merges the first `max_fan_in` runs into a new run and removes them.
+    void merge_runs();
+
+    //!\brief Calls `callback(minimiser, occurrences)` in ascending order for each minimiser in the runs.
+    template <typename callback_t>
+    void merge(std::span<std::filesystem::path const> const runs, callback_t && callback) const
+    {
+        std::vector<run_reader> readers(runs.size());
+        using entry_t = std::pair<uint64_t, size_t>; // (minimiser, run)
+        std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> queue{};
+        for (size_t run = 0; run < readers.size(); ++run)
+        {
+            readers[run].open(runs[run], chunk_entries);
+            if (readers[run].next())
+                queue.emplace(readers[run].minimiser, run);
+        }
+
+        while (!queue.empty())
+        {
+            uint64_t const minimiser = queue.top().first;
+            size_t occurrences{};
+            do
+            {
+                size_t const run = queue.top().second;
+                queue.pop();
+                occurrences += readers[run].occurrences;
+                if (readers[run].next())
+                    queue.emplace(readers[run].minimiser, run);
+            }
+            while (!queue.empty() && queue.top().first == minimiser);
+
+            callback(minimiser, static_cast<uint8_t>(std::min<size_t>(254u, occurrences)));
+        }
+    }
+};
+
+} // namespace raptor
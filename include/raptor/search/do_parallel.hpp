@@ -16,6 +16,8 @@
 
 #include <hibf/misc/divide_and_ceil.hpp>
 
+#include <raptor/trace.hpp>
+
 namespace raptor
 {
 
@@ -30,6 +32,7 @@ void do_parallel(algorithm_t && worker, size_t const num_records, size_t const t
     {
         size_t const start = chunk_size * i;
         size_t const extent = i == (number_of_chunks - 1) ? num_records - i * chunk_size : chunk_size;
+        trace_scope const chunk_trace{"Chunk", "worker", "start", start, "extent", extent};
         std::invoke(worker, start, extent);
     }
 }
@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::latency_histogram and raptor::stage_latencies.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace raptor
+{
+
+/*!\brief A histogram of latencies in nanoseconds with logarithmic-linear buckets.
+ * \details
+ * Similar to an HDR histogram: Each power of two is split into 32 linear buckets. Hence, a reported percentile differs
+ * by less than 1/32 (about 3%) from the exact value. Values below 32 are exact.
+ * Buckets are allocated on demand; a histogram of latencies below one second has at most 832 buckets.
+ */
+class latency_histogram
+{
+public:
+    latency_histogram() = default;
+    latency_histogram(latency_histogram const &) = default;
+    latency_histogram & operator=(latency_histogram const &) = default;
+    latency_histogram(latency_histogram &&) = default;
+    latency_histogram & operator=(latency_histogram &&) = default;
+    ~latency_histogram() = default;
+
+    void record(uint64_t const value)
+    {
+        size_t const index = bucket_index(value);
+        if (index >= counts.size())
+            counts.resize(index + 1u);
+        ++counts[index];
+        ++total_count;
+        max_value = std::max(max_value, value);
+    }
+
+    latency_histogram & operator+=(latency_histogram const & other)
+    {
+        if (other.counts.size() > counts.size())
+            counts.resize(other.counts.size());
+        for (size_t i = 0; i < other.counts.size(); ++i)
+            counts[i] += other.counts[i];
+        total_count += other.total_count;
+        max_value = std::max(max_value, other.max_value);
+        return *this;
+    }
+
+    uint64_t count() const noexcept
+    {
+        return total_count;
+    }
+
+    uint64_t max() const noexcept
+    {
+        return max_value;
+    }
+
+    /*!\brief Returns the given percentile.
+     * \param[in] percentile The percentile in `[0, 100]`.
+     * \returns An upper bound for the value at the given percentile. 0 if the histogram is empty.
+     */
+    uint64_t percentile(double const percentile) const noexcept
+    {
+        if (total_count == 0u)
+            return 0u;
+
+        double const clamped = std::clamp(percentile, 0.0, 100.0);
+        uint64_t const rank = std::max<uint64_t>(1u, std::ceil(clamped / 100.0 * total_count));
+        uint64_t cumulative_count{};
+
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            cumulative_count += counts[i];
+            if (cumulative_count >= rank)
+                return std::min(bucket_upper_bound(i), max_value);
+        }
+
+        return max_value; // GCOVR_EXCL_LINE
+    }
+
+private:
+    static constexpr size_t sub_bucket_bits{5u};
+    static constexpr size_t sub_buckets{1ULL << sub_bucket_bits};
+
+    std::vector<uint64_t> counts{};
+    uint64_t total_count{};
+    uint64_t max_value{};
+
+    static constexpr size_t bucket_index(uint64_t const value) noexcept
+    {
+        if (value < sub_buckets)
+            return value;
+
+        // `value >> shift` is in [sub_buckets, 2 * sub_buckets).
+        size_t const shift = std::bit_width(value) - (sub_bucket_bits + 1u);
+        return (shift + 1u) * sub_buckets + ((value >> shift) - sub_buckets);
+    }
+
+    static constexpr uint64_t bucket_upper_bound(size_t const index) noexcept
+    {
+        if (index < sub_buckets)
+            return index;
+
+        size_t const shift = index / sub_buckets - 1u;
+        uint64_t const mantissa = index % sub_buckets + sub_buckets;
+        return ((mantissa + 1u) << shift) - 1u;
+    }
+};
+
+//!\brief The search stages for which latencies are recorded.
+enum class latency_stage : uint8_t
+{
+    compute_minimiser,
+    query_ibf,
+    generate_results
+};
+
+/*!\brief Per-query latencies of each search stage, in total and per query length.
+ * \details
+ * Queries are grouped by the bit width of their length, i.e., `[2^(i-1), 2^i)`.
+ * Recording is a no-op if the object was not enabled.
+ */
+class stage_latencies
+{
+public:
+    static constexpr size_t number_of_stages{3u};
+    static constexpr std::array<std::string_view, number_of_stages> stage_names{"compute_minimiser",
+                                                                                "query_ibf",
+                                                                                "generate_results"};
+
+    stage_latencies() = default;
+    stage_latencies(stage_latencies const &) = default;
+    stage_latencies & operator=(stage_latencies const &) = default;
+    stage_latencies(stage_latencies &&) = default;
+    stage_latencies & operator=(stage_latencies &&) = default;
+    ~stage_latencies() = default;
+
+    explicit stage_latencies(bool const enabled) : enabled{enabled}
+    {}
+
+    //!\brief Sets the length of the query whose stages are recorded next.
+    void set_query_length(size_t const query_length) noexcept
+    {
+        length_class = std::bit_width(query_length);
+    }
+
+    void start() noexcept
+    {
+        if (enabled)
+            checkpoint = std::chrono::steady_clock::now();
+    }
+
+    void stop(latency_stage const stage)
+    {
+        if (!enabled)
+            return;
+
+        auto const duration = std::chrono::steady_clock::now() - checkpoint;
+        uint64_t const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        size_t const stage_index = static_cast<size_t>(stage);
+
+        total[stage_index].record(nanoseconds);
+
+        std::vector<latency_histogram> & histograms = per_length[stage_index];
+        if (histograms.size() <= length_class)
+            histograms.resize(length_class + 1u);
+        histograms[length_class].record(nanoseconds);
+    }
+
+    stage_latencies & operator+=(stage_latencies const & other)
+    {
+        for (size_t stage = 0; stage < number_of_stages; ++stage)
+        {
+            total[stage] += other.total[stage];
+
+            std::vector<latency_histogram> & histograms = per_length[stage];
+            std::vector<latency_histogram> const & other_histograms = other.per_length[stage];
+            if (histograms.size() < other_histograms.size())
+                histograms.resize(other_histograms.size());
+            for (size_t i = 0; i < other_histograms.size(); ++i)
+                histograms[i] += other_histograms[i];
+        }
+        return *this;
+    }
+
+    latency_histogram const & histogram(latency_stage const stage) const noexcept
+    {
+        return total[static_cast<size_t>(stage)];
+    }
+
+    //!\brief The histograms per length class. Position `i` contains queries of length `[2^(i-1), 2^i)`.
+    std::vector<latency_histogram> const & histograms_per_length(latency_stage const stage) const noexcept
+    {
+        return per_length[static_cast<size_t>(stage)];
+    }
+
+private:
+    bool enabled{false};
+    size_t length_class{};
+    std::chrono::steady_clock::time_point checkpoint{};
+    std::array<latency_histogram, number_of_stages> total{};
+    std::array<std::vector<latency_histogram>, number_of_stages> per_length{};
+};
+
+/*!\brief A thread-safe accumulator of raptor::stage_latencies.
+ * \details
+ * Like seqan::hibf::concurrent_timer, the recorded data is not copied upon copy construction/assignment.
+ */
+class concurrent_stage_latencies
+{
+public:
+    concurrent_stage_latencies() = default;
+    concurrent_stage_latencies(concurrent_stage_latencies const &)
+    {}
+    concurrent_stage_latencies & operator=(concurrent_stage_latencies const &)
+    {
+        return *this;
+    }
+    ~concurrent_stage_latencies() = default;
+
+    concurrent_stage_latencies & operator+=(stage_latencies const & other)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        latencies += other;
+        return *this;
+    }
+
+    //!\brief Not synchronised. Must not be called while other threads are merging.
+    stage_latencies const & get() const noexcept
+    {
+        return latencies;
+    }
+
+private:
+    std::mutex mutex{};
+    stage_latencies latencies{};
+};
+
+} // namespace raptor
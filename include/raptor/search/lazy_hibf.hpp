@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::lazy_hibf.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <vector>
+
+#include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+
+namespace raptor
+{
+
+/*!\brief An HIBF whose lower-level IBFs are read from the index on first access.
+ * \details
+ * raptor::lazy_hibf::load reads the parameters, the bookkeeping of the HIBF (`next_ibf_id`, `ibf_bin_to_user_bin_id`),
+ * and the top-level IBF. The other IBFs of `ibf_vector` stay empty until a query reaches them via a merged bin. Then,
+ * the IBF is read from its section of the index container. Hence, only the subtrees that are hit occupy memory.
+ *
+ * Multiple threads may use membership agents concurrently. Each IBF is read exactly once; threads that need an IBF
+ * while it is read wait for it.
+ * Indices written by previous versions have no sections, and are read completely by raptor::lazy_hibf::load.
+ */
+class lazy_hibf
+{
+public:
+    class membership_agent_type;
+
+    lazy_hibf() = default;
+    lazy_hibf(lazy_hibf const &) = delete;
+    lazy_hibf(lazy_hibf &&) = default;
+    lazy_hibf & operator=(lazy_hibf const &) = delete;
+    lazy_hibf & operator=(lazy_hibf &&) = default;
+    ~lazy_hibf() = default;
+
+    //!\brief Reads the index without the lower-level IBFs.
+    void load(std::filesystem::path const & path)
+    {
+        if (!is_index_container(path))
+        {
+            read_index_container(index_, path, 1u);
+            states = std::make_unique<ibf_state[]>(index_.ibf().ibf_vector.size());
+            for (size_t i = 0; i < index_.ibf().ibf_vector.size(); ++i)
+                states[i].is_loaded.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        file = std::make_unique<detail::index_file>(path, O_RDONLY);
+        compression = detail::read_compression(*file);
+        sections = detail::read_section_table(*file);
+        // The first section is never compressed.
+        detail::read_cereal_section(*file, sections[0], index_compression::none, index_);
+
+        index_.ibf().ibf_vector.resize(sections.size() - 1u);
+        states = std::make_unique<ibf_state[]>(sections.size() - 1u);
+        fault_in(0u);
+    }
+
+    membership_agent_type membership_agent();
+
+    //!\brief The index. IBFs that were not accessed yet are empty.
+    raptor_index<index_structure::hibf> const & index() const noexcept
+    {
+        return index_;
+    }
+
+    size_t hash_function_count() const
+    {
+        return index_.ibf().ibf_vector[0].hash_function_count();
+    }
+
+    //!\brief The number of IBFs that have been read so far.
+    size_t number_of_loaded_ibfs() const
+    {
+        size_t count{};
+        for (size_t i = 0; i < index_.ibf().ibf_vector.size(); ++i)
+            count += states[i].is_loaded.load(std::memory_order_acquire);
+        return count;
+    }
+
+private:
+    struct ibf_state
+    {
+        std::once_flag once{};
+        std::atomic<bool> is_loaded{false};
+    };
+
+    raptor_index<index_structure::hibf> index_{};
+    std::unique_ptr<detail::index_file> file{};
+    index_compression compression{};
+    std::vector<index_section> sections{};
+    std::unique_ptr<ibf_state[]> states{};
+
+    //!\brief Reads the IBF `ibf_idx` if it has not been read yet. Thread-safe.
+    seqan::hibf::interleaved_bloom_filter const & fault_in(size_t const ibf_idx)
+    {
+        auto & ibf = index_.ibf().ibf_vector[ibf_idx];
+        ibf_state & state = states[ibf_idx];
+        if (state.is_loaded.load(std::memory_order_acquire))
+            return ibf;
+
+        // If reading throws, the next access tries again.
+        std::call_once(state.once,
+                       [&]()
+                       {
+                           detail::read_cereal_section(*file, sections[ibf_idx + 1u], compression, ibf);
+                           state.is_loaded.store(true, std::memory_order_release);
+                       });
+        return ibf;
+    }
+};
+
+/*!\brief Determines the user bins of a raptor::lazy_hibf that contain a query.
+ * \details
+ * Provides the same interface and results as the membership agent of
+ * seqan::hibf::hierarchical_interleaved_bloom_filter. The traversal is the same, but the IBFs are read via
+ * raptor::lazy_hibf before they are queried.
+ */
+class lazy_hibf::membership_agent_type
+{
+public:
+    membership_agent_type() = default;
+    membership_agent_type(membership_agent_type const &) = default;
+    membership_agent_type(membership_agent_type &&) = default;
+    membership_agent_type & operator=(membership_agent_type const &) = default;
+    membership_agent_type & operator=(membership_agent_type &&) = default;
+    ~membership_agent_type() = default;
+
+    explicit membership_agent_type(lazy_hibf & hibf) : hibf{std::addressof(hibf)}
+    {}
+
+    //!\brief Returns the sorted user bins that contain at least `threshold` of the `values`.
+    template <std::ranges::forward_range value_range_t>
+    [[nodiscard]] std::vector<uint64_t> const & membership_for(value_range_t && values, size_t const threshold) &
+    {
+        assert(hibf != nullptr);
+        result.clear();
+        membership_for_impl(values, 0u, threshold);
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // `membership_for` must not be called on a temporary agent.
+    template <std::ranges::forward_range value_range_t>
+    [[nodiscard]] std::vector<uint64_t> const & membership_for(value_range_t && values,
+                                                               size_t const threshold) && = delete;
+
+private:
+    lazy_hibf * hibf{nullptr};
+    std::vector<uint64_t> result{};
+
+    template <std::ranges::forward_range value_range_t>
+    void membership_for_impl(value_range_t && values, size_t const ibf_idx, size_t const threshold)
+    {
+        auto const & user_bin_ids = hibf->index_.ibf().ibf_bin_to_user_bin_id[ibf_idx];
+        auto const & next_ibf_ids = hibf->index_.ibf().next_ibf_id[ibf_idx];
+        auto agent = hibf->fault_in(ibf_idx).template counting_agent<uint16_t>();
+        auto & counts = agent.bulk_count(values);
+
+        size_t sum{};
+        for (size_t bin = 0; bin < counts.size(); ++bin)
+        {
+            sum += counts[bin];
+            uint64_t const user_bin = user_bin_ids[bin];
+
+            if (user_bin == seqan::hibf::bin_kind::merged)
+            {
+                if (sum >= threshold)
+                    membership_for_impl(values, next_ibf_ids[bin], threshold);
+                sum = 0u;
+            }
+            else if (user_bin == seqan::hibf::bin_kind::deleted)
+            {
+                sum = 0u;
+            }
+            else if (bin + 1u == counts.size() || user_bin != user_bin_ids[bin + 1u]) // Last bin of a split bin.
+            {
+                if (sum >= threshold)
+                    result.push_back(user_bin);
+                sum = 0u;
+            }
+        }
+    }
+};
+
+inline lazy_hibf::membership_agent_type lazy_hibf::membership_agent()
+{
+    return membership_agent_type{*this};
+}
+
+} // namespace raptor
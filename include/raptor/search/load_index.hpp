@@ -10,10 +10,12 @@
 #pragma once
 
 #include <chrono>
-#include <fstream>
 
 #include <raptor/argument_parsing/search_arguments.hpp>
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/search/lazy_hibf.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -22,12 +24,14 @@ namespace detail
 {
 
 template <typename index_t>
-void load_index(index_t & index, std::filesystem::path const & path)
+void load_index(index_t & index, std::filesystem::path const & path, uint8_t const threads)
 {
-    std::ifstream is{path, std::ios::binary};
-    cereal::BinaryInputArchive iarchive{is};
+    read_index_container(index, path, threads);
+}
 
-    iarchive(index);
+inline void load_index(lazy_hibf & index, std::filesystem::path const & path, uint8_t const)
+{
+    index.load(path);
 }
 
 } // namespace detail
@@ -38,7 +42,9 @@ void load_index(index_t & index, search_arguments const & arguments, size_t cons
     std::filesystem::path index_file{arguments.index_file};
     index_file += "_" + std::to_string(part);
     arguments.load_index_timer.start();
-    detail::load_index(index, index_file);
+    trace_scope load_index_trace{"Load index", "search"};
+    detail::load_index(index, index_file, arguments.threads);
+    load_index_trace.stop();
     arguments.load_index_timer.stop();
 }
 
@@ -46,7 +52,9 @@ template <typename index_t>
 void load_index(index_t & index, search_arguments const & arguments)
 {
     arguments.load_index_timer.start();
-    detail::load_index(index, arguments.index_file);
+    trace_scope load_index_trace{"Load index", "search"};
+    detail::load_index(index, arguments.index_file, arguments.threads);
+    load_index_trace.stop();
     arguments.load_index_timer.stop();
 }
 
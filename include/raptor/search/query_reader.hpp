@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::query_reader.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+
+#include <raptor/dna4_traits.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+//!\brief Provides the (decompressed) content of a file block by block. Implemented in query_reader.cpp.
+class byte_source;
+
+} // namespace detail
+
+//!\brief A query as read by raptor::query_reader.
+struct query_record
+{
+    std::string id{};
+    std::vector<seqan3::dna4> sequence{};
+};
+
+/*!\brief Reads a query file using multiple threads.
+ * \details
+ * FASTA and FASTQ files are read block by block. Each block is split at record boundaries and the records are parsed
+ * in parallel. BGZF blocks are decompressed in parallel. Plain gzip files are decompressed by a dedicated thread,
+ * while the previous block is parsed.
+ * Other formats and compressions are read via seqan3::sequence_file_input.
+ */
+class query_reader
+{
+public:
+    query_reader() = delete;
+    query_reader(query_reader const &) = delete;
+    query_reader & operator=(query_reader const &) = delete;
+    query_reader(query_reader &&) = delete;
+    query_reader & operator=(query_reader &&) = delete;
+    ~query_reader();
+
+    query_reader(std::filesystem::path const & file_path, uint8_t const threads);
+
+    /*!\brief Reads the next records.
+     * \param[out] records The records. Existing elements are reused, the size is adjusted to the number of records.
+     * \param[in] max_records The maximal number of records to read.
+     * \returns `false` if there were no more records to read.
+     */
+    bool read_chunk(std::vector<query_record> & records, size_t const max_records);
+
+    //!\brief The length of the shortest query read so far. 0 if no query was read.
+    uint64_t min_sequence_length() const noexcept
+    {
+        return max_length == 0u ? 0u : min_length;
+    }
+
+    //!\brief The length of the longest query read so far.
+    uint64_t max_sequence_length() const noexcept
+    {
+        return max_length;
+    }
+
+private:
+    using fallback_file_t =
+        seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::id, seqan3::field::seq>>;
+
+    std::unique_ptr<detail::byte_source> source{};
+    std::unique_ptr<fallback_file_t> fallback_file{};
+    std::string buffer{};
+    size_t buffer_position{};
+    std::vector<std::pair<size_t, size_t>> record_spans{};
+    bool is_fastq{false};
+    bool source_exhausted{false};
+    uint8_t threads{1u};
+    uint64_t min_length{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_length{};
+
+    size_t read_records(std::vector<query_record> & records, size_t const max_records);
+    void find_records(size_t const max_records);
+    void parse_records(std::vector<query_record> & records, size_t const offset);
+    size_t read_fallback(std::vector<query_record> & records, size_t const max_records);
+};
+
+/*!\brief Estimates the distribution of query lengths without reading the whole file.
+ * \param[in] file_path The query file.
+ * \param[in] threads The number of threads to use.
+ * \returns The sorted lengths of the sampled queries.
+ * \details
+ * The sample consists of the first records of the file. If the file has more records, records from windows at
+ * random positions are added. The start of a record within such a window is found by resynchronising on the record
+ * structure. Plain gzip files do not support random access, and only the first records are sampled.
+ * The sample covers all records if the file is small.
+ */
+std::vector<uint64_t> sample_query_lengths(std::filesystem::path const & file_path, uint8_t const threads);
+
+} // namespace raptor
@@ -12,16 +12,13 @@
 #include <future>
 #include <random>
 
-#include <seqan3/search/views/minimiser_hash.hpp>
-
-#include <hibf/contrib/std/chunk_view.hpp>
-
-#include <raptor/adjust_seed.hpp>
-#include <raptor/dna4_traits.hpp>
+#include <raptor/file_reader.hpp>
 #include <raptor/search/do_parallel.hpp>
 #include <raptor/search/load_index.hpp>
+#include <raptor/search/query_reader.hpp>
 #include <raptor/search/sync_out.hpp>
 #include <raptor/threshold/threshold.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -29,7 +26,8 @@ namespace raptor
 template <typename index_t>
 void search_singular_ibf(search_arguments const & arguments, index_t && index)
 {
-    constexpr bool is_ibf = std::same_as<index_t, raptor_index<index_structure::ibf>>;
+    constexpr bool is_lazy_hibf = std::same_as<index_t, lazy_hibf>;
+    constexpr bool is_hibf = is_lazy_hibf || std::same_as<index_t, raptor_index<index_structure::hibf>>;
 
     auto cereal_future = std::async(std::launch::async,
                                     [&]()
@@ -37,10 +35,8 @@ void search_singular_ibf(search_arguments const & arguments, index_t && index)
                                         load_index(index, arguments);
                                     });
 
-    seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::id, seqan3::field::seq>> fin{
-        arguments.query_file};
-    using record_type = typename decltype(fin)::record_type;
-    std::vector<record_type> records{};
+    query_reader reader{arguments.query_file, arguments.threads};
+    std::vector<query_record> records{};
 
     sync_out synced_out{arguments};
 
@@ -51,16 +47,25 @@ void search_singular_ibf(search_arguments const & arguments, index_t && index)
         seqan::hibf::serial_timer local_compute_minimiser_timer{};
         seqan::hibf::serial_timer local_query_ibf_timer{};
         seqan::hibf::serial_timer local_generate_results_timer{};
+        perf_counter_group const counter_group{arguments.perf_counters};
+        serial_perf_counters local_compute_minimiser_counters{counter_group};
+        serial_perf_counters local_query_ibf_counters{counter_group};
+        serial_perf_counters local_generate_results_counters{counter_group};
+        stage_latencies local_stage_latency{arguments.latency_histograms};
 
-        auto agent = index.ibf().membership_agent();
+        auto agent = [&index]()
+        {
+            if constexpr (is_lazy_hibf)
+                return index.membership_agent();
+            else
+                return index.ibf().membership_agent();
+        }();
 
         std::string result_string{};
         std::array<char, std::numeric_limits<uint64_t>::digits10 + 1> buffer{};
         std::vector<uint64_t> minimiser;
 
-        auto hash_adaptor = seqan3::views::minimiser_hash(arguments.shape,
-                                                          seqan3::window_size{arguments.window_size},
-                                                          seqan3::seed{adjust_seed(arguments.shape_weight)});
+        file_reader<file_types::sequence> const hash_reader{arguments.shape, arguments.window_size, arguments.sketch};
 
         for (auto && [id, seq] : std::span{records.data() + start, extent})
         {
@@ -68,18 +73,30 @@ void search_singular_ibf(search_arguments const & arguments, index_t && index)
             result_string += id;
             result_string += '\t';
 
-            auto minimiser_view = seq | hash_adaptor | std::views::common;
+            local_stage_latency.set_query_length(seq.size());
+
             local_compute_minimiser_timer.start();
-            minimiser.assign(minimiser_view.begin(), minimiser_view.end());
+            local_compute_minimiser_counters.start();
+            local_stage_latency.start();
+            minimiser.clear();
+            hash_reader.hash_into(seq, std::back_inserter(minimiser));
+            local_stage_latency.stop(latency_stage::compute_minimiser);
+            local_compute_minimiser_counters.stop();
             local_compute_minimiser_timer.stop();
 
             size_t const minimiser_count{minimiser.size()};
             size_t const threshold = thresholder.get(minimiser_count);
 
             local_query_ibf_timer.start();
+            local_query_ibf_counters.start();
+            local_stage_latency.start();
             auto & user_bin_ids = agent.membership_for(minimiser, threshold);
+            local_stage_latency.stop(latency_stage::query_ibf);
+            local_query_ibf_counters.stop();
             local_query_ibf_timer.stop();
             local_generate_results_timer.start();
+            local_generate_results_counters.start();
+            local_stage_latency.start();
             for (auto && user_bin : user_bin_ids)
             {
                 auto conv = std::to_chars(buffer.data(), buffer.data() + buffer.size(), user_bin);
@@ -95,38 +112,57 @@ void search_singular_ibf(search_arguments const & arguments, index_t && index)
                 result_string += '\n';
 
             synced_out.write(result_string);
+            local_stage_latency.stop(latency_stage::generate_results);
+            local_generate_results_counters.stop();
             local_generate_results_timer.stop();
         }
 
         arguments.compute_minimiser_timer += local_compute_minimiser_timer;
         arguments.query_ibf_timer += local_query_ibf_timer;
         arguments.generate_results_timer += local_generate_results_timer;
+        arguments.stage_latency += local_stage_latency;
+        arguments.compute_minimiser_counters += local_compute_minimiser_counters;
+        arguments.query_ibf_counters += local_query_ibf_counters;
+        arguments.generate_results_counters += local_generate_results_counters;
     };
 
     auto write_header = [&]()
     {
-        if constexpr (is_ibf)
-            return synced_out.write_header(arguments, index.ibf().hash_function_count());
-        else
+        if constexpr (is_lazy_hibf)
+            return synced_out.write_header(arguments, index.hash_function_count());
+        else if constexpr (is_hibf)
             return synced_out.write_header(arguments, index.ibf().ibf_vector[0].hash_function_count());
+        else
+            return synced_out.write_header(arguments, index.ibf().hash_function_count());
     };
 
-    for (auto && chunked_records : fin | seqan::stl::views::chunk((1ULL << 20) * 10))
+    while (true)
     {
-        records.clear();
         arguments.query_file_io_timer.start();
-        std::ranges::move(chunked_records, std::back_inserter(records));
+        trace_scope query_file_io_trace{"Query file I/O", "search"};
+        if (!reader.read_chunk(records, (1ULL << 20) * 10))
+        {
+            query_file_io_trace.stop();
+            arguments.query_file_io_timer.stop();
+            break;
+        }
         // Very fast, improves parallel processing when chunks of the query belong to the same bin.
         std::ranges::shuffle(records, std::mt19937_64{0u});
+        query_file_io_trace.stop();
         arguments.query_file_io_timer.stop();
 
         cereal_future.get();
         [[maybe_unused]] static bool header_written = write_header(); // called exactly once
 
         arguments.parallel_search_timer.start();
+        trace_scope parallel_search_trace{"Parallel search", "search"};
         do_parallel(worker, records.size(), arguments.threads);
+        parallel_search_trace.stop();
         arguments.parallel_search_timer.stop();
     }
+
+    arguments.min_query_length = reader.min_sequence_length();
+    arguments.max_query_length = reader.max_sequence_length();
 }
 
 } // namespace raptor
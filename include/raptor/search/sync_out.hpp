@@ -12,8 +12,7 @@
 #include <filesystem>
 #include <fstream>
 #include <mutex>
-
-#include <hibf/contrib/std/join_with_view.hpp>
+#include <string_view>
 
 #include <raptor/argument_parsing/search_arguments.hpp>
 
@@ -68,8 +67,12 @@ public:
         for (auto const & file_list : arguments.bin_path)
         {
             file << '#' << user_bin_id << '\t';
-            for (auto const elem : seqan::stl::views::join_with(file_list, ','))
-                file << elem;
+            std::string_view separator{};
+            for (std::string_view const path : file_list)
+            {
+                file << separator << path;
+                separator = ",";
+            }
             file << '\n';
             ++user_bin_id;
         }
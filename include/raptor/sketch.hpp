@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::sketch_kind and raptor::syncmer_hash.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+
+#include <raptor/adjust_seed.hpp>
+
+namespace raptor
+{
+
+/*!\brief How the k-mers that are stored in an index are chosen.
+ * \details
+ * A window minimiser is the smallest k-mer of a window. Whether a k-mer is an open syncmer only depends on the k-mer
+ * itself, hence an error only affects the k-mers that contain it.
+ */
+enum class sketch_kind : uint8_t
+{
+    minimiser,
+    syncmer
+};
+
+//!\brief The names of the values of raptor::sketch_kind for the command line.
+inline auto enumeration_names(sketch_kind)
+{
+    return std::unordered_map<std::string_view, sketch_kind>{{"minimiser", sketch_kind::minimiser},
+                                                             {"syncmer", sketch_kind::syncmer}};
+}
+
+/*!\brief Computes the open syncmers of a sequence.
+ * \details
+ * A k-mer is an open syncmer if its smallest s-mer is at one of the two middle positions of its `k - s + 1` s-mers.
+ * The s-mers are canonical, and the middle positions are symmetric. Hence, a sequence and its reverse complement
+ * have the same syncmers. The value of a syncmer is the value that raptor uses for minimisers: the smaller of the
+ * k-mer and its reverse complement, each XOR the seed.
+ *
+ * The s-mer size is derived from the window size: the expected density of syncmers, `2 / (k - s + 1)`, matches the
+ * density of minimisers, `2 / (w - k + 2)`. If the window size equals the k-mer size, all k-mers are syncmers.
+ * Only ungapped k-mers are supported.
+ */
+class syncmer_hash
+{
+public:
+    //!\brief The smallest k-mer size. Smaller k-mers do not have an even number of s-mers of at least two bases.
+    static constexpr uint8_t min_kmer_size{3u};
+
+    syncmer_hash() = default;
+    syncmer_hash(syncmer_hash const &) = default;
+    syncmer_hash(syncmer_hash &&) = default;
+    syncmer_hash & operator=(syncmer_hash const &) = default;
+    syncmer_hash & operator=(syncmer_hash &&) = default;
+    ~syncmer_hash() = default;
+
+    syncmer_hash(uint8_t const kmer_size, uint32_t const window_size) :
+        kmer_size_{kmer_size},
+        smer_size_{smer_size(kmer_size, window_size)},
+        kmer_seed{adjust_seed(kmer_size)},
+        smer_seed{adjust_seed(smer_size_)}
+    {
+        assert(kmer_size >= min_kmer_size && kmer_size <= 32u);
+        uint8_t const smers = kmer_size_ - smer_size_ + 1u;
+        assert(smer_size_ >= 2u && smers % 2u == 0u);
+        first_position = (smers - 1u) / 2u;
+        second_position = smers - 1u - first_position;
+    }
+
+    //!\brief The s-mer size for the given k-mer and window size.
+    static constexpr uint8_t smer_size(uint8_t const kmer_size, uint32_t const window_size) noexcept
+    {
+        assert(window_size >= kmer_size);
+        assert(kmer_size >= min_kmer_size);
+        // The number of s-mers per k-mer: w - k + 2, rounded up to be even. With an odd number, the two middle
+        // positions would coincide. The s-mers have at least two bases, hence there are at most k - 1 s-mers.
+        uint64_t const max_smers = (kmer_size - 1u) / 2u * 2u;
+        uint64_t const smers = std::min<uint64_t>((window_size - kmer_size + 3u) / 2u * 2u, max_smers);
+        return kmer_size - smers + 1u;
+    }
+
+    uint8_t kmer_size() const noexcept
+    {
+        return kmer_size_;
+    }
+
+    uint8_t smer_size() const noexcept
+    {
+        return smer_size_;
+    }
+
+    //!\brief Calls `callback` with the value of each syncmer of `sequence`.
+    template <typename callback_t>
+    void for_each(std::span<seqan3::dna4 const> const sequence, callback_t && callback) const
+    {
+        assert(kmer_size_ > 0u); // Forgot to initialise?
+        uint8_t const smers = kmer_size_ - smer_size_ + 1u;
+        uint64_t const kmer_mask = mask(kmer_size_);
+        uint64_t const smer_mask = mask(smer_size_);
+        uint8_t const kmer_shift = 2u * (kmer_size_ - 1u);
+        uint8_t const smer_shift = 2u * (smer_size_ - 1u);
+
+        uint64_t forward_kmer{};
+        uint64_t reverse_kmer{};
+        uint64_t forward_smer{};
+        uint64_t reverse_smer{};
+        // The s-mer starting at position p is stored at p % smers. Once a k-mer is complete, these are its s-mers.
+        std::array<uint64_t, 32> smer_values{};
+
+        for (size_t i = 0; i < sequence.size(); ++i)
+        {
+            uint64_t const rank = seqan3::to_rank(sequence[i]);
+            forward_kmer = ((forward_kmer << 2) | rank) & kmer_mask;
+            reverse_kmer = (reverse_kmer >> 2) | ((3u - rank) << kmer_shift);
+            forward_smer = ((forward_smer << 2) | rank) & smer_mask;
+            reverse_smer = (reverse_smer >> 2) | ((3u - rank) << smer_shift);
+
+            size_t const length = i + 1u;
+            if (length >= smer_size_)
+                smer_values[(length - smer_size_) % smers] =
+                    std::min(forward_smer ^ smer_seed, reverse_smer ^ smer_seed);
+
+            if (length < kmer_size_)
+                continue;
+
+            size_t const kmer_begin = length - kmer_size_;
+            uint64_t const minimum = *std::ranges::min_element(smer_values.begin(), smer_values.begin() + smers);
+            if (smer_values[(kmer_begin + first_position) % smers] == minimum
+                || smer_values[(kmer_begin + second_position) % smers] == minimum)
+                callback(std::min(forward_kmer ^ kmer_seed, reverse_kmer ^ kmer_seed));
+        }
+    }
+
+private:
+    uint8_t kmer_size_{};
+    uint8_t smer_size_{};
+    uint8_t first_position{};
+    uint8_t second_position{};
+    uint64_t kmer_seed{};
+    uint64_t smer_seed{};
+
+    static constexpr uint64_t mask(uint8_t const size) noexcept
+    {
+        return size == 32u ? std::numeric_limits<uint64_t>::max() : (uint64_t{1} << (2u * size)) - 1u;
+    }
+};
+
+} // namespace raptor
@@ -11,10 +11,18 @@
 
 #include <seqan3/search/kmer_index/shape.hpp>
 
+#include <raptor/sketch.hpp>
+
 namespace raptor::threshold
 {
 
-[[nodiscard]] std::vector<double>
-one_indirect_error_model(size_t const query_length, size_t const window_size, seqan3::shape const shape);
+/*!\brief The log probabilities that one error affects `i` minimisers indirectly, i.e., minimisers not containing it.
+ * \details
+ * Whether a k-mer is a syncmer only depends on the k-mer itself. Hence, syncmers are never affected indirectly.
+ */
+[[nodiscard]] std::vector<double> one_indirect_error_model(size_t const query_length,
+                                                           size_t const window_size,
+                                                           seqan3::shape const shape,
+                                                           sketch_kind const sketch = sketch_kind::minimiser);
 
 } // namespace raptor::threshold
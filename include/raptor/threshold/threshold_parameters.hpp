@@ -13,6 +13,8 @@
 
 #include <seqan3/search/kmer_index/shape.hpp>
 
+#include <raptor/sketch.hpp>
+
 namespace raptor::threshold
 {
 
@@ -21,6 +23,7 @@ struct threshold_parameters
     // Basic.
     uint32_t window_size{};
     seqan3::shape shape{};
+    sketch_kind sketch{};
     uint64_t query_length{};
 
     // Threshold.
@@ -33,6 +36,33 @@ struct threshold_parameters
     // Cache results.
     bool cache_thresholds{};
     std::filesystem::path output_directory{};
+
+    /*!\brief The smallest number of minimisers a query can have.
+     * \details
+     * Each window contains a minimiser. Syncmers do not have such a guarantee; a query may have none.
+     */
+    size_t minimal_number_of_minimisers() const noexcept
+    {
+        if (sketch == sketch_kind::syncmer)
+            return 1u;
+
+        size_t const kmers_per_window = window_size - shape.size() + 1u;
+        size_t const kmers_per_pattern = query_length - shape.size() + 1u;
+        return kmers_per_pattern / kmers_per_window;
+    }
+
+    /*!\brief The largest number of minimisers a query can have.
+     * \details
+     * For syncmers, each k-mer may be a syncmer. The error model needs at least one k-mer that is not a syncmer;
+     * queries consisting of syncmers only use the threshold of one syncmer less.
+     */
+    size_t maximal_number_of_minimisers() const noexcept
+    {
+        if (sketch == sketch_kind::syncmer)
+            return query_length - shape.size();
+
+        return query_length - window_size + 1u;
+    }
 };
 
 } // namespace raptor::threshold
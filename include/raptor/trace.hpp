@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Provides raptor::trace_scope.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+struct trace_event
+{
+    std::string_view name{};
+    std::string_view category{};
+    int64_t begin{};    // Nanoseconds since the trace was enabled.
+    int64_t duration{}; // Nanoseconds.
+    std::string_view first_argument_name{};
+    uint64_t first_argument{};
+    std::string_view second_argument_name{};
+    uint64_t second_argument{};
+};
+
+// The events of one thread. Only accessed by the owning thread while tracing.
+struct trace_buffer
+{
+    size_t thread_id{};
+    bool is_main_thread{};
+    std::vector<trace_event> events{};
+};
+
+class trace_registry
+{
+public:
+    static trace_registry & instance()
+    {
+        static trace_registry registry{};
+        return registry;
+    }
+
+    void enable()
+    {
+        main_thread = std::this_thread::get_id();
+        local_buffer(); // The main thread has thread ID 1.
+        epoch = std::chrono::steady_clock::now();
+        enabled.store(true, std::memory_order_release);
+    }
+
+    bool is_enabled() const noexcept
+    {
+        return enabled.load(std::memory_order_acquire);
+    }
+
+    int64_t now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    // The buffers are shared with the registry such that they outlive threads, e.g., of std::async.
+    trace_buffer & local_buffer()
+    {
+        thread_local std::shared_ptr<trace_buffer> buffer = [this]()
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            auto result = std::make_shared<trace_buffer>();
+            result->thread_id = buffers.size() + 1u;
+            result->is_main_thread = std::this_thread::get_id() == main_thread;
+            buffers.push_back(result);
+            return result;
+        }();
+        return *buffer;
+    }
+
+    //!\brief Must not be called while other threads record events.
+    void write(std::filesystem::path const & path) const
+    {
+        std::ofstream output_stream{path};
+        output_stream << std::fixed << std::setprecision(3);
+        output_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        output_stream << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"raptor"}})";
+
+        std::lock_guard<std::mutex> lock{mutex};
+        for (auto const & buffer : buffers)
+        {
+            output_stream << ",\n"
+                          << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->thread_id
+                          << R"(,"args":{"name":")";
+            if (buffer->is_main_thread)
+                output_stream << "main";
+            else
+                output_stream << "thread " << buffer->thread_id;
+            output_stream << "\"}}";
+
+            for (trace_event const & event : buffer->events)
+            {
+                // Chrome trace events use microseconds.
+                output_stream << ",\n"
+                              << R"({"name":")" << event.name << R"(","cat":")" << event.category
+                              << R"(","ph":"X","pid":1,"tid":)" << buffer->thread_id
+                              << R"(,"ts":)" << event.begin / 1000.0 << R"(,"dur":)" << event.duration / 1000.0;
+                if (!event.first_argument_name.empty())
+                {
+                    output_stream << R"(,"args":{")" << event.first_argument_name << "\":" << event.first_argument;
+                    if (!event.second_argument_name.empty())
+                        output_stream << ",\"" << event.second_argument_name << "\":" << event.second_argument;
+                    output_stream << '}';
+                }
+                output_stream << '}';
+            }
+        }
+        output_stream << "\n]}\n";
+    }
+
+private:
+    trace_registry() = default;
+
+    std::atomic<bool> enabled{false};
+    std::thread::id main_thread{};
+    std::chrono::steady_clock::time_point epoch{};
+    mutable std::mutex mutex{};
+    std::vector<std::shared_ptr<trace_buffer>> buffers{};
+};
+
+} // namespace detail
+
+//!\brief Enables recording of trace events. Should be called by the main thread before any event is recorded.
+inline void enable_tracing()
+{
+    detail::trace_registry::instance().enable();
+}
+
+/*!\brief Writes all recorded events to a file in the Chrome trace event format.
+ * \details
+ * The file can be viewed with, e.g., https://ui.perfetto.dev or chrome://tracing.
+ * Must not be called while other threads record events.
+ */
+inline void write_trace(std::filesystem::path const & path)
+{
+    detail::trace_registry::instance().write(path);
+}
+
+/*!\brief Records a trace event that spans the lifetime of the object, or until stop() is called.
+ * \details
+ * Events are stored in a buffer of the calling thread; there is no synchronisation between threads.
+ * If tracing is not enabled, no event is recorded.
+ * Names and categories are not escaped and must outlive the trace, e.g., string literals.
+ */
+class trace_scope
+{
+public:
+    trace_scope() = delete;
+    trace_scope(trace_scope const &) = delete;
+    trace_scope & operator=(trace_scope const &) = delete;
+    trace_scope(trace_scope &&) = delete;
+    trace_scope & operator=(trace_scope &&) = delete;
+
+    ~trace_scope()
+    {
+        stop();
+    }
+
+    explicit trace_scope(std::string_view const name,
+                         std::string_view const category,
+                         std::string_view const first_argument_name = {},
+                         uint64_t const first_argument = 0u,
+                         std::string_view const second_argument_name = {},
+                         uint64_t const second_argument = 0u) noexcept
+    {
+        detail::trace_registry const & registry = detail::trace_registry::instance();
+        if (!registry.is_enabled())
+            return;
+
+        active = true;
+        event = {.name = name,
+                 .category = category,
+                 .begin = registry.now(),
+                 .first_argument_name = first_argument_name,
+                 .first_argument = first_argument,
+                 .second_argument_name = second_argument_name,
+                 .second_argument = second_argument};
+    }
+
+    //!\brief Ends the event. Further calls have no effect.
+    void stop()
+    {
+        if (!active)
+            return;
+
+        active = false;
+        detail::trace_registry & registry = detail::trace_registry::instance();
+        event.duration = registry.now() - event.begin;
+        registry.local_buffer().events.push_back(event);
+    }
+
+private:
+    bool active{false};
+    detail::trace_event event{};
+};
+
+} // namespace raptor
@@ -47,7 +47,16 @@ void build_arguments::print_timings() const
     std::cerr << "├── Index allocation [s]: " << index_allocation_timer.in_seconds() << '\n';
     std::cerr << "├── User bin I/O\n";
     std::cerr << "│   ├── Max [s]: " << user_bin_io_timer.max_in_seconds() << '\n';
-    std::cerr << "│   └── Avg [s]: " << user_bin_io_timer.avg_in_seconds() << '\n';
+    if (perf_counters)
+    {
+        std::cerr << "│   ├── Avg [s]: " << user_bin_io_timer.avg_in_seconds() << '\n';
+        std::cerr << "│   └── Hardware counters\n";
+        user_bin_io_counters.print(std::cerr, "│       ");
+    }
+    else
+    {
+        std::cerr << "│   └── Avg [s]: " << user_bin_io_timer.avg_in_seconds() << '\n';
+    }
     std::cerr << "├── Merge kmer sets I/O\n";
 
     if (is_hibf)
@@ -65,6 +74,8 @@ void build_arguments::print_timings() const
     std::cerr << "│   ├── Max [s]: " << fill_ibf_timer.max_in_seconds() << '\n';
     std::cerr << "│   └── Avg [s]: " << fill_ibf_timer.avg_in_seconds() << '\n';
     std::cerr << "└── Store index [s]: " << store_index_timer.in_seconds() << '\n';
+    std::cerr << "    └── Throughput [MiB/s]: "
+              << index_throughput_in_MiB_per_second(out_path, parts, store_index_timer.in_seconds()) << '\n';
 }
 
 void build_arguments::write_timings_to_file() const
@@ -86,7 +97,11 @@ void build_arguments::write_timings_to_file() const
                   << "merge_kmer_sets_avg_in_seconds\t"
                   << "fill_ibf_max_in_seconds\t"
                   << "fill_ibf_avg_in_seconds\t"
-                  << "store_index_in_seconds\n";
+                  << "store_index_in_seconds\t"
+                  << "store_index_throughput_in_mebibytes_per_second";
+    if (perf_counters)
+        concurrent_perf_counters::write_header(output_stream, "user_bin_io");
+    output_stream << '\n';
 
     if (long const peak_ram_KiB = peak_ram_in_KiB(); peak_ram_KiB != -1L)
         output_stream << peak_ram_KiB << '\t';
@@ -132,7 +147,11 @@ void build_arguments::write_timings_to_file() const
 
     output_stream << fill_ibf_timer.max_in_seconds() << '\t';
     output_stream << fill_ibf_timer.avg_in_seconds() << '\t';
-    output_stream << store_index_timer.in_seconds() << '\n';
+    output_stream << store_index_timer.in_seconds() << '\t';
+    output_stream << index_throughput_in_MiB_per_second(out_path, parts, store_index_timer.in_seconds());
+    if (perf_counters)
+        user_bin_io_counters.write_values(output_stream);
+    output_stream << '\n';
 }
 
 } // namespace raptor
@@ -21,6 +21,8 @@
 #include <raptor/argument_parsing/shared.hpp>
 #include <raptor/argument_parsing/validators.hpp>
 #include <raptor/build/raptor_build.hpp>
+#include <raptor/minimiser_file.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -79,7 +81,18 @@ inline void parse_shape_from_minimiser(sharg::parser & parser, build_arguments &
         throw sharg::parser_error{"You cannot set --kmer when using minimiser files as input."};
     if (parser.is_option_set("window"))
         throw sharg::parser_error{"You cannot set --window when using minimiser files as input."};
+    if (parser.is_option_set("sketch"))
+        throw sharg::parser_error{"You cannot set --sketch when using minimiser files as input."};
 
+    if (minimiser_file_input const input{arguments.bin_path[0][0]}; input.is_compressed())
+    {
+        arguments.window_size = input.header()->window_size;
+        arguments.shape = seqan3::shape{seqan3::bin_literal{input.header()->shape}};
+        arguments.sketch = input.header()->sketch;
+        return;
+    }
+
+    // Minimiser files of previous versions store the shape and window size in a separate header file.
     std::filesystem::path header_file_path = arguments.bin_path[0][0];
     header_file_path.replace_extension("header");
     std::ifstream file_stream{header_file_path};
@@ -102,13 +115,23 @@ void init_build_parser(sharg::parser & parser, build_arguments & arguments)
     parser.info.examples.emplace_back("raptor build --input bins.list --kmer 19 --window 23 --fpr 0.05 --output "
                                       "raptor.index");
     parser.info.examples.emplace_back("raptor build --input bins.list --shape 11011 --window 8 --output raptor.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --kmer 19 --window 23 --sketch syncmer --output "
+                                      "raptor.index");
     parser.info.examples.emplace_back("raptor build --input bins.list --kmer 32 --window 32 --hash 3 --parts 4 "
                                       "--output raptor.index");
     parser.info.examples.emplace_back("raptor build --input minimiser.list --fpr 0.05 --output raptor.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --blocked --output raptor.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --compress zstd --output raptor.index");
     parser.info.examples.emplace_back("raptor build --input raptor.layout --output raptor.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --memory-limit 16384 --output raptor.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --bin-range 0:1000 --output shard_0.index");
+    parser.info.examples.emplace_back("raptor build --input bins.list --checkpoint-interval 3600 --resume --output "
+                                      "raptor.index");
     parser.info.synopsis.emplace_back("raptor build --input <file> --output <file> [--threads <number>] [--quiet] "
-                                      "[--kmer <number>|--shape <01-pattern>] [--window <number>] [--fpr <number>] "
-                                      "[--hash <number>] [--parts <number>]");
+                                      "[--kmer <number>|--shape <01-pattern>] [--window <number>] "
+                                      "[--sketch minimiser|syncmer] [--fpr <number>] [--hash <number>] [--blocked] "
+                                      "[--compress none|lz4|zstd] [--parts <number>] [--bin-range <A:B>] "
+                                      "[--memory-limit <number>] [--checkpoint-interval <seconds>] [--resume]");
 
     parser.add_subsection("General options");
     parser.add_option(
@@ -139,6 +162,15 @@ void init_build_parser(sharg::parser & parser, build_arguments & arguments)
                                     .long_id = "timing-output",
                                     .description = "Write time and memory usage to specified file (TSV format).",
                                     .validator = output_file_validator{}});
+    parser.add_flag(arguments.perf_counters,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "perf-counters",
+                                  .description = "Measure cycles, instructions, last level cache misses, and data TLB "
+                                                 "misses while reading the user bins and filling the index. The "
+                                                 "counters are added to the timings. Counters that cannot be "
+                                                 "measured, e.g., due to missing permissions for perf_event_open, are "
+                                                 "reported as not available."});
+    add_trace_option(parser, arguments.trace_file);
 
     parser.add_subsection("k-mer options");
     parser.add_option(
@@ -162,6 +194,16 @@ void init_build_parser(sharg::parser & parser, build_arguments & arguments)
                           "The shape to use for k-mers. Mutually exclusive with --kmer. Parsed from right to left.",
                       .default_message = "11111111111111111111 (a k-mer of size 20), or read from layout file",
                       .validator = sharg::regex_validator{"[01]+"}});
+    parser.add_option(arguments.sketch,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "sketch",
+                                    .description = "How the k-mers are chosen. minimiser: The smallest k-mer of each "
+                                                   "window. syncmer: Open syncmers, chosen by their smallest s-mer. "
+                                                   "The s-mer size is chosen such that there are about as many "
+                                                   "syncmers as minimisers for the window size. An error only affects "
+                                                   "the syncmers that contain it. Requires an ungapped shape of at "
+                                                   "least 3 bases.",
+                                    .default_message = "minimiser, or read from minimiser files"});
 
     parser.add_subsection("Index options");
     parser.add_option(arguments.fpr,
@@ -176,11 +218,77 @@ void init_build_parser(sharg::parser & parser, build_arguments & arguments)
                                     .description = "The number of hash functions to use.",
                                     .default_message = std::to_string(arguments.hash) + ", or read from layout file",
                                     .validator = sharg::arithmetic_range_validator{1, 5}});
+    parser.add_flag(arguments.is_blocked_ibf,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "blocked",
+                                  .description = "Place all hash positions of a minimiser in one block of about 4 KiB. "
+                                                 "Queries touch fewer memory pages, but the index is slightly larger "
+                                                 "for the same false positive rate. Only available for unpartitioned "
+                                                 "IBFs."});
+    parser.add_option(arguments.compression,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "compress",
+                                    .description = "Compress the bit vectors of the stored index. The index is "
+                                                   "compressed and decompressed in blocks of 4 MiB, using all threads. "
+                                                   "lz4 loads faster, zstd produces smaller files. Compressed indices "
+                                                   "cannot be merged. Not available with \\fB--bin-range\\fP.",
+                                    .default_message = "none"});
     parser.add_option(arguments.parts,
                       sharg::config{.short_id = '\0',
                                     .long_id = "parts",
                                     .description = "Splits the index in this many parts. Not available for the HIBF.",
                                     .validator = power_of_two_validator{}});
+    parser.add_flag(arguments.spill_parts,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "spill-parts",
+                                  .description = "Only relevant if \\fB--parts\\fP is greater than 1. The input is "
+                                                 "always read once. By default, all parts are kept in memory if they "
+                                                 "fit into half of the physical memory. With this flag, the minimisers "
+                                                 "of each part are written to a temporary file next to the output "
+                                                 "instead, and the parts are constructed one after another."});
+    parser.add_option(arguments.memory_limit,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "memory-limit",
+                                    .description = "The memory (in MiB) for the index while it is built. If the index "
+                                                   "does not fit, it is split into parts (see \\fB--parts\\fP); "
+                                                   "the number of parts is increased as needed. If the parts do not "
+                                                   "fit at once, they are built one after another from temporary "
+                                                   "files next to the output. Not available for the HIBF.",
+                                    .default_message = "No limit",
+                                    .validator = positive_integer_validator{}});
+    parser.add_option(arguments.sketch_cache_dir,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "sketch-cache",
+                                    .description = "Store the sketches used to determine the index size in this "
+                                                   "directory, and reuse them in subsequent builds. A sketch is reused "
+                                                   "if the files of the user bin, the shape, the window size, and the "
+                                                   "number of parts did not change. Not used for the HIBF.",
+                                    .validator = output_directory_validator{}});
+    parser.add_option(arguments.bin_range_string,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "bin-range",
+                                    .description = "Only insert the user bins with IDs in [A, B), i.e., the lines A to "
+                                                   "B-1 of the input file, counting from 0. The index still has the "
+                                                   "size needed for all user bins. Indices built from the same input "
+                                                   "with the same options and disjoint ranges can be combined with "
+                                                   "\\fBraptor merge\\fP. Not available for the HIBF.",
+                                    .validator = sharg::regex_validator{"[0-9]+:[0-9]+"}});
+    parser.add_option(arguments.checkpoint_interval,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "checkpoint-interval",
+                                    .description = "Write the partially filled index and the finished user bins to "
+                                                   "OUTPUT.checkpoint every this many seconds. The checkpoint is "
+                                                   "written in the background and removed when the index is stored. "
+                                                   "Only available for unpartitioned IBFs. Fails if the index does "
+                                                   "not fit into \\fB--memory-limit\\fP.",
+                                    .default_message = "No checkpoints",
+                                    .validator = positive_integer_validator{}});
+    parser.add_flag(arguments.resume,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "resume",
+                                  .description = "Continue from OUTPUT.checkpoint if it exists. The input files and "
+                                                 "the options that determine the index must not have changed. Use "
+                                                 "\\fB--sketch-cache\\fP to also skip determining the index size."});
 
     // GCOVR_EXCL_START
     // Adding additional cwl information that currently aren't supported by sharg and tdl.
@@ -226,12 +334,37 @@ void init_build_parser(sharg::parser & parser, build_arguments & arguments)
                                             - --input
                                             - input_bins_filepaths.txt
                                           )-");
-        for (auto const elem : {"kmer", "window", "shape", "timing-output"})
+        for (auto const elem : {"kmer",
+                                "window",
+                                "shape",
+                                "timing-output",
+                                "trace",
+                                "memory-limit",
+                                "sketch-cache",
+                                "bin-range",
+                                "checkpoint-interval"})
             inputs[elem].remove("default");
     };
     // GCOVR_EXCL_STOP
 }
 
+void parse_bin_range(build_arguments & arguments)
+{
+    if (arguments.is_hibf)
+        throw sharg::parser_error{"--bin-range is not available for the HIBF."};
+
+    std::string_view const range{arguments.bin_range_string};
+    size_t const colon = range.find(':');
+    std::from_chars(range.data(), range.data() + colon, arguments.bin_range_begin);
+    std::from_chars(range.data() + colon + 1u, range.data() + range.size(), arguments.bin_range_end);
+
+    if (arguments.bin_range_begin >= arguments.bin_range_end)
+        throw sharg::parser_error{"--bin-range: A must be smaller than B."};
+    if (arguments.bin_range_end > arguments.bin_path.size())
+        throw sharg::parser_error{"--bin-range: B must not exceed the number of user bins ("
+                                  + std::to_string(arguments.bin_path.size()) + ")."};
+}
+
 bool input_is_pack_file(std::filesystem::path const & path)
 {
     char const first_char = std::ifstream{path}.get();
@@ -251,6 +384,9 @@ void build_parsing(sharg::parser & parser)
     init_build_parser(parser, arguments);
     parser.parse();
 
+    if (parser.is_option_set("trace"))
+        enable_tracing();
+
     if (std::filesystem::is_empty(arguments.bin_file))
         throw sharg::parser_error{"The input file is empty."};
 
@@ -259,8 +395,26 @@ void build_parsing(sharg::parser & parser)
     if (arguments.is_hibf && arguments.parts != 1u)
         throw sharg::parser_error{"The HIBF cannot yet be partitioned."};
 
+    if (arguments.is_hibf && parser.is_option_set("memory-limit"))
+        throw sharg::parser_error{"--memory-limit is not available for the HIBF."};
+
+    if (arguments.uses_checkpoint() && (arguments.is_hibf || arguments.parts != 1u))
+        throw sharg::parser_error{"--checkpoint-interval and --resume are only available for unpartitioned IBFs."};
+
+    if (arguments.is_blocked_ibf
+        && (arguments.is_hibf || arguments.parts != 1u || parser.is_option_set("memory-limit")
+            || parser.is_option_set("bin-range") || arguments.uses_checkpoint()))
+        throw sharg::parser_error{"--blocked is only available for unpartitioned IBFs and cannot be combined with "
+                                  "--memory-limit, --bin-range, --checkpoint-interval, or --resume."};
+
+    if (arguments.compression != index_compression::none && parser.is_option_set("bin-range"))
+        throw sharg::parser_error{"--compress cannot be combined with --bin-range."};
+
     parse_bin_path(arguments);
 
+    if (parser.is_option_set("bin-range"))
+        parse_bin_range(arguments);
+
     if (arguments.is_hibf)
         parse_chopper_config(parser, arguments);
 
@@ -279,6 +433,8 @@ void build_parsing(sharg::parser & parser)
         arguments.print_timings();
     if (parser.is_option_set("timing-output"))
         arguments.write_timings_to_file();
+    if (parser.is_option_set("trace"))
+        write_trace(arguments.trace_file);
 }
 
 } // namespace raptor
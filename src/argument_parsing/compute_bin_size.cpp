@@ -15,9 +15,13 @@
 
 #include <raptor/adjust_seed.hpp>
 #include <raptor/argument_parsing/compute_bin_size.hpp>
+#include <raptor/blocked_bloom_filter.hpp>
+#include <raptor/build/sketch_cache.hpp>
 #include <raptor/call_parallel_on_bins.hpp>
 #include <raptor/dna4_traits.hpp>
 #include <raptor/file_reader.hpp>
+#include <raptor/minimiser_file.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -28,65 +32,42 @@ namespace detail
 size_t kmer_count_from_minimiser_files(std::vector<std::vector<std::string>> const & bin_path, uint8_t const threads)
 {
     std::mutex callback_mutex{};
-    size_t max_filesize{};
-    std::filesystem::path biggest_file{};
+    size_t max_count{};
 
-    auto callback = [&callback_mutex, &biggest_file, &max_filesize](std::filesystem::path path, size_t const size)
+    auto callback = [&callback_mutex, &max_count](size_t const count)
     {
         std::lock_guard<std::mutex> guard{callback_mutex};
-        if (size > max_filesize)
-        {
-            max_filesize = size;
-            biggest_file = std::move(path);
-        }
+        max_count = std::max(max_count, count);
     };
 
+    // Both the compressed and the raw format store the number of minimisers; see raptor::minimiser_file_header.
     auto worker = [&callback](auto && zipped_view)
     {
-        std::filesystem::path minimiser_file{};
-        std::filesystem::path biggest_file{};
-        size_t max_filesize{};
+        size_t max_count{};
 
         for (auto && [file_names, bin_number] : zipped_view)
-        {
             for (auto && file_name : file_names)
-            {
-                minimiser_file = file_name;
-                size_t const size = std::filesystem::file_size(minimiser_file);
-                if (size > max_filesize)
-                {
-                    max_filesize = size;
-                    biggest_file = minimiser_file;
-                }
-            }
-        }
+                max_count = std::max<size_t>(max_count, minimiser_file_input{file_name}.size());
 
-        callback(std::move(biggest_file), max_filesize);
+        callback(max_count);
     };
 
     call_parallel_on_bins(worker, bin_path, threads);
 
-    std::string shape_string{};
-    uint64_t window_size{};
-    uint16_t cutoff{};
-    size_t max_count{};
-
-    biggest_file.replace_extension("header");
-    std::ifstream file_stream{biggest_file};
-    file_stream >> shape_string >> window_size >> cutoff >> max_count;
-
     return max_count;
 }
 
 size_t kmer_count_from_sequence_files(std::vector<std::vector<std::string>> const & bin_path,
                                       uint8_t const threads,
                                       seqan3::shape const & shape,
-                                      uint32_t const window_size)
+                                      uint32_t const window_size,
+                                      sketch_kind const sketch_type,
+                                      sketch_cache const & cache)
 {
     size_t max_count{};
     size_t max_bin_id{};
     std::mutex callback_mutex{};
-    file_reader<file_types::sequence> const reader{shape, window_size};
+    file_reader<file_types::sequence> const reader{shape, window_size, sketch_type};
 
     auto callback = [&](size_t const count, size_t const bin_id)
     {
@@ -98,12 +79,18 @@ size_t kmer_count_from_sequence_files(std::vector<std::vector<std::string>> cons
         }
     };
 
-    auto worker = [&callback, &reader](auto && zipped_view)
+    auto worker = [&callback, &reader, &cache](auto && zipped_view)
     {
-        seqan::hibf::sketch::hyperloglog sketch{15u};
+        seqan::hibf::sketch::hyperloglog sketch{sketch_cache::sketch_bits};
 
         for (auto && [file_names, bin_number] : zipped_view)
         {
+            if (std::optional<sketch_cache::entry> const cached = cache.load(file_names))
+            {
+                callback(cached->sketches[0].estimate(), bin_number);
+                continue;
+            }
+
             sketch.reset();
             reader.for_each_hash(file_names,
                                  [&sketch](auto && hash)
@@ -111,17 +98,28 @@ size_t kmer_count_from_sequence_files(std::vector<std::vector<std::string>> cons
                                      sketch.add(hash);
                                  });
             callback(sketch.estimate(), bin_number);
+            cache.store(file_names, {.sketches = {sketch}, .exact_counts = {sketch_cache::unknown_count}});
         }
     };
 
     // Use sketches to determine biggest bin.
     call_parallel_on_bins(worker, bin_path, threads);
 
+    std::optional<sketch_cache::entry> cached = cache.load(bin_path[max_bin_id]);
+    if (cached && cached->exact_counts[0] != sketch_cache::unknown_count)
+        return cached->exact_counts[0];
+
     // Get exact count for biggest bin. Sketch estimate's accuracy depends on sketch_bits (here: 15).
     robin_hood::unordered_flat_set<uint64_t> kmers{};
     auto insert_it = std::inserter(kmers, kmers.end());
     reader.hash_into(bin_path[max_bin_id], insert_it);
 
+    if (cached)
+    {
+        cached->exact_counts[0] = kmers.size();
+        cache.store(bin_path[max_bin_id], *cached);
+    }
+
     return kmers.size();
 }
 
@@ -130,16 +128,28 @@ size_t kmer_count_from_sequence_files(std::vector<std::vector<std::string>> cons
 size_t compute_bin_size(build_arguments const & arguments)
 {
     arguments.bin_size_timer.start();
+    trace_scope bin_size_trace{"Determine IBF size", "build"};
+    sketch_cache const cache{arguments.sketch_cache_dir,
+                             arguments.shape,
+                             arguments.window_size,
+                             partition_config{1u},
+                             arguments.sketch};
     size_t const max_count = arguments.input_is_minimiser
                                ? detail::kmer_count_from_minimiser_files(arguments.bin_path, arguments.threads)
                                : detail::kmer_count_from_sequence_files(arguments.bin_path,
                                                                         arguments.threads,
                                                                         arguments.shape,
-                                                                        arguments.window_size);
+                                                                        arguments.window_size,
+                                                                        arguments.sketch,
+                                                                        cache);
+    bin_size_trace.stop();
     arguments.bin_size_timer.stop();
 
     assert(max_count > 0u);
 
+    if (arguments.is_blocked_ibf)
+        return blocked_bloom_filter::bin_size_in_bits(arguments.fpr, arguments.hash, max_count, arguments.bins);
+
     return seqan::hibf::build::bin_size_in_bits(
         {.fpr = arguments.fpr, .hash_count = arguments.hash, .elements = max_count});
 }
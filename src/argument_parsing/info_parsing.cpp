@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::info_parsing.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <iomanip>
+#include <iostream>
+
+#include <raptor/argument_parsing/formatted_index_size.hpp>
+#include <raptor/argument_parsing/info_parsing.hpp>
+#include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+
+namespace raptor
+{
+
+void init_info_parser(sharg::parser & parser, std::filesystem::path & index_file)
+{
+    parser.info.short_description = "Prints information about a Raptor index";
+    parser.info.description.emplace_back("Prints the parameters of an index and, for each IBF, the number of bins, "
+                                         "the size, and the occupancy, i.e., the percentage of set bits.");
+    parser.info.description.emplace_back("Only the metadata at the start of the index is read. For indices built "
+                                         "by previous versions of Raptor, only the parameters are printed.");
+    parser.info.examples.emplace_back("raptor info --index raptor.index");
+    parser.info.synopsis.emplace_back("raptor info --index <file>");
+
+    parser.add_subsection("General options");
+    parser.add_option(index_file,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "index",
+                                    .description = "The index. Parts: Without suffix _0",
+                                    .required = true});
+}
+
+namespace detail
+{
+
+std::string_view index_type_name(bool const is_hibf, bool const is_blocked_ibf)
+{
+    if (is_hibf)
+        return "HIBF";
+    return is_blocked_ibf ? "blocked IBF" : "IBF";
+}
+
+template <typename enum_t>
+std::string_view enum_name(enum_t const value)
+{
+    for (auto const & [name, candidate] : enumeration_names(value))
+        if (candidate == value)
+            return name;
+    return "unknown"; // GCOVR_EXCL_LINE
+}
+
+// The partitioning only matters if there are multiple parts.
+std::string partitioning_line(size_t const parts, hash_partitioning const partitioning)
+{
+    if (parts < 2u)
+        return {};
+    return "Partitioning: " + std::string{enum_name(partitioning)} + '\n';
+}
+
+double occupancy(uint64_t const set_bits, uint64_t const bit_size)
+{
+    return bit_size == 0u ? 0.0 : 100.0 * static_cast<double>(set_bits) / static_cast<double>(bit_size);
+}
+
+// Indices written by previous versions have no metadata. Only the parameters are read.
+void print_parameters(std::filesystem::path const & index_file, std::filesystem::path const & first_file)
+{
+    raptor_index<> index{};
+    read_index_parameters(index, first_file);
+
+    std::cout << "Index: " << index_file.string() << '\n'
+              << "Type: " << index_type_name(index.is_hibf(), index.is_blocked_ibf()) << '\n'
+              << "Compression: " << enum_name(read_index_compression(first_file)) << '\n'
+              << "Shape: " << index.shape().to_string() << '\n'
+              << "Window size: " << index.window_size() << '\n'
+              << "Sketch: " << enum_name(index.sketch()) << '\n'
+              << "Parts: " << static_cast<uint16_t>(index.parts()) << '\n'
+              << partitioning_line(index.parts(), index.partitioning())
+              << "False positive rate: " << index.fpr() << '\n'
+              << "User bins: " << index.bin_path().size() << '\n'
+              << "Size: " << formatted_index_size(index_file, index.parts()) << '\n'
+              << "The index was built by a previous version of Raptor. Rebuild it for information about the IBFs.\n";
+}
+
+void print_metadata(std::filesystem::path const & index_file,
+                    std::filesystem::path const & first_file,
+                    std::vector<index_metadata> const & parts)
+{
+    index_metadata::fixed_type const & fixed = parts[0].fixed;
+    uint64_t bit_size{};
+    uint64_t set_bits{};
+    for (index_metadata const & part : parts)
+    {
+        bit_size += part.bit_size();
+        set_bits += part.set_bits();
+    }
+
+    std::cout << "Index: " << index_file.string() << '\n'
+              << "Type: " << index_type_name(fixed.is_hibf, fixed.is_blocked_ibf) << '\n'
+              << "Compression: " << enum_name(read_index_compression(first_file)) << '\n'
+              << "Index version: " << fixed.index_version << '\n'
+              << "Shape: " << parts[0].shape_string() << '\n'
+              << "Window size: " << fixed.window_size << '\n'
+              << "Sketch: " << enum_name(static_cast<sketch_kind>(fixed.sketch)) << '\n'
+              << "Parts: " << fixed.parts << '\n'
+              << partitioning_line(fixed.parts, static_cast<hash_partitioning>(fixed.partitioning))
+              << "Hash functions: " << fixed.hash_function_count << '\n'
+              << "False positive rate: " << fixed.fpr << '\n'
+              << "User bins: " << fixed.number_of_user_bins << '\n'
+              << "IBFs: " << fixed.number_of_ibfs << '\n'
+              << "Size: " << formatted_index_size(index_file, fixed.parts) << '\n'
+              << std::fixed << std::setprecision(2) << "Occupancy [%]: " << occupancy(set_bits, bit_size) << '\n';
+
+    std::cout << "#PART\tIBF\tLEVEL\tBINS\tBITS\tSET_BITS\tOCCUPANCY\n";
+    for (size_t part = 0; part < parts.size(); ++part)
+    {
+        for (size_t ibf_idx = 0; ibf_idx < parts[part].ibfs.size(); ++ibf_idx)
+        {
+            index_metadata::ibf_type const & ibf = parts[part].ibfs[ibf_idx];
+            std::cout << part << '\t' << ibf_idx << '\t' << ibf.level << '\t' << ibf.bin_count << '\t'
+                      << ibf.bit_size << '\t' << ibf.set_bits << '\t' << occupancy(ibf.set_bits, ibf.bit_size)
+                      << '\n';
+        }
+    }
+}
+
+} // namespace detail
+
+void info_parsing(sharg::parser & parser)
+{
+    std::filesystem::path index_file{};
+    init_info_parser(parser, index_file);
+    parser.parse();
+
+    sharg::input_file_validator const index_validator{};
+    std::filesystem::path first_part{index_file};
+    first_part += "_0";
+    bool const is_partitioned = !std::filesystem::exists(index_file) && std::filesystem::exists(first_part);
+    std::filesystem::path const & first_file = is_partitioned ? first_part : index_file;
+    index_validator(first_file);
+
+    std::optional<index_metadata> metadata = read_index_metadata(first_file);
+    if (!metadata)
+    {
+        detail::print_parameters(index_file, first_file);
+        return;
+    }
+
+    std::vector<index_metadata> parts{std::move(*metadata)};
+    for (size_t part = 1; part < parts[0].fixed.parts; ++part)
+    {
+        std::filesystem::path part_file{index_file};
+        part_file += "_" + std::to_string(part);
+        index_validator(part_file);
+        metadata = read_index_metadata(part_file);
+        if (!metadata)
+            throw sharg::parser_error{"Cannot read index: " + part_file.string() + " has no metadata."};
+        parts.push_back(std::move(*metadata));
+    }
+
+    detail::print_metadata(index_file, first_file, parts);
+}
+
+} // namespace raptor
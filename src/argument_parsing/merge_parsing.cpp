@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::merge_parsing.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <raptor/argument_parsing/merge_arguments.hpp>
+#include <raptor/argument_parsing/merge_parsing.hpp>
+#include <raptor/argument_parsing/validators.hpp>
+#include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/merge/merge.hpp>
+
+namespace raptor
+{
+
+void init_merge_parser(sharg::parser & parser, merge_arguments & arguments)
+{
+    parser.info.short_description = "Merges Raptor indices built for disjoint ranges of user bins";
+    parser.info.description.emplace_back("Merges Raptor indices built with \\fBraptor build --bin-range\\fP.");
+    parser.info.description.emplace_back("The indices must be built from the same input with the same options, "
+                                         "except for \\fB--bin-range\\fP. This way, the indices can be built on "
+                                         "different machines. The result is the same as building a single index "
+                                         "without \\fB--bin-range\\fP.");
+    parser.info.examples.emplace_back("raptor merge --input shard_0.index --input shard_1.index --output raptor.index");
+    parser.info.synopsis.emplace_back("raptor merge --input <file> --input <file> [--input <file>...] --output <file> "
+                                      "[--threads <number>] [--quiet]");
+
+    parser.add_subsection("General options");
+    parser.add_option(arguments.shard_files,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "input",
+                                    .description = "An index to merge. Can be given multiple times. Parts: Without "
+                                                   "suffix _0",
+                                    .required = true});
+    parser.add_option(arguments.out_path,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "output",
+                                    .description = "Path to the merged index.",
+                                    .required = true,
+                                    .validator = output_file_validator{}});
+    parser.add_option(arguments.threads,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "threads",
+                                    .description = "The number of threads to use.",
+                                    .validator = positive_integer_validator{}});
+    parser.add_flag(
+        arguments.quiet,
+        sharg::config{.short_id = '\0', .long_id = "quiet", .description = "Do not print time and memory usage."});
+}
+
+void merge_parsing(sharg::parser & parser)
+{
+    merge_arguments arguments{};
+    arguments.wall_clock_timer.start();
+
+    init_merge_parser(parser, arguments);
+    parser.parse();
+
+    if (arguments.shard_files.size() < 2u)
+        throw sharg::parser_error{"At least two indices are needed."};
+
+    // ==========================================
+    // Read the number of parts.
+    // ==========================================
+    sharg::input_file_validator const index_validator{};
+    std::filesystem::path const & first_file = arguments.shard_files[0];
+    std::filesystem::path first_part{first_file};
+    first_part += "_0";
+    bool const is_partitioned = !std::filesystem::exists(first_file) && std::filesystem::exists(first_part);
+
+    {
+        std::filesystem::path const & path = is_partitioned ? first_part : first_file;
+        index_validator(path);
+        raptor_index<> tmp{};
+        read_index_parameters(tmp, path);
+        arguments.parts = tmp.parts();
+    }
+
+    for (std::filesystem::path const & shard_file : arguments.shard_files)
+    {
+        if (arguments.parts == 1u)
+        {
+            index_validator(shard_file);
+            continue;
+        }
+
+        for (size_t part = 0; part < arguments.parts; ++part)
+        {
+            std::filesystem::path part_file{shard_file};
+            part_file += "_" + std::to_string(part);
+            index_validator(part_file);
+        }
+    }
+
+    raptor_merge(arguments);
+
+    arguments.wall_clock_timer.stop();
+    arguments.print_timings();
+}
+
+} // namespace raptor
@@ -13,6 +13,7 @@
 #include <raptor/argument_parsing/shared.hpp>
 #include <raptor/argument_parsing/validators.hpp>
 #include <raptor/prepare/compute_minimiser.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -23,13 +24,17 @@ void init_prepare_parser(sharg::parser & parser, prepare_arguments & arguments)
     parser.info.description.emplace_back(
         "Computes minimisers for the use with \\fBraptor layout\\fP and \\fBraptor build\\fP.");
     parser.info.description.emplace_back("Can continue where it left off after a crash or in multiple runs.");
+    parser.info.description.emplace_back("The largest files are processed first.");
     parser.info.examples.emplace_back("raptor prepare --input bins.list --output some_directory --kmer 20 --window 24");
     parser.info.examples.emplace_back("raptor prepare --input bins.list --output some_directory --kmer-count-cutoff 2");
+    parser.info.examples.emplace_back("raptor prepare --input bins.list --output some_directory --kmer 19 --window 23 "
+                                      "--sketch syncmer");
     parser.info.examples.emplace_back("raptor prepare --input bins.list --output some_directory "
                                       "--use-filesize-dependent-cutoff");
     parser.info.synopsis.emplace_back(
         "raptor prepare --input <file> --output <directory> [--threads <number>] [--quiet] [--kmer <number>|--shape "
-        "<01-pattern>] [--window <number>] [--kmer-count-cutoff <number>|--use-filesize-dependent-cutoff]");
+        "<01-pattern>] [--window <number>] [--sketch minimiser|syncmer] [--kmer-count-cutoff "
+        "<number>|--use-filesize-dependent-cutoff] [--counting-memory <number>] [--memory-limit <number>]");
 
     parser.add_subsection("General options");
     parser.add_option(
@@ -52,11 +57,18 @@ void init_prepare_parser(sharg::parser & parser, prepare_arguments & arguments)
                          "\\fBWhen you manually delete a .in_progress file, also delete the corresponding .header and "
                          ".minimiser file!\\fP");
     parser.add_list_item("", "Created output files for each file:");
-    parser.add_list_item("", "\\fB*.header\\fP: Contains the shape, window size, cutoff and minimiser count.");
-    parser.add_list_item("", "\\fB*.minimiser\\fP: Contains binary minimiser values, one minimiser per line.");
+    parser.add_list_item("",
+                         "\\fB*.header\\fP: Contains the shape, window size, cutoff and minimiser count. Only needed "
+                         "for minimiser files of previous versions.");
+    parser.add_list_item("",
+                         "\\fB*.minimiser\\fP: Contains the sorted minimiser values in a compressed binary format, "
+                         "as well as the shape, window size, cutoff and minimiser count.");
     parser.add_list_item(
         "",
         "\\fB*.in_progress\\fP: Temporary file to track process. Deleted after finishing computation.");
+    parser.add_list_item("",
+                         "\\fB*.run_<number>\\fP: Temporary files for counting with \\fB--counting-memory\\fP. Deleted "
+                         "after finishing computation.");
     parser.add_option(arguments.threads,
                       sharg::config{.short_id = '\0',
                                     .long_id = "threads",
@@ -65,6 +77,15 @@ void init_prepare_parser(sharg::parser & parser, prepare_arguments & arguments)
     parser.add_flag(
         arguments.quiet,
         sharg::config{.short_id = '\0', .long_id = "quiet", .description = "Do not print time and memory usage."});
+    parser.add_flag(arguments.perf_counters,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "perf-counters",
+                                  .description = "Measure cycles, instructions, last level cache misses, and data TLB "
+                                                 "misses while computing and writing the minimisers. The counters are "
+                                                 "added to the timings. Counters that cannot be measured, e.g., due "
+                                                 "to missing permissions for perf_event_open, are reported as not "
+                                                 "available."});
+    add_trace_option(parser, arguments.trace_file);
 
     parser.add_subsection("k-mer options");
     parser.add_option(arguments.kmer_size,
@@ -86,6 +107,16 @@ void init_prepare_parser(sharg::parser & parser, prepare_arguments & arguments)
                           "The shape to use for k-mers. Mutually exclusive with --kmer. Parsed from right to left.",
                       .default_message = "11111111111111111111 (a k-mer of size 20)",
                       .validator = sharg::regex_validator{"[01]+"}});
+    parser.add_option(arguments.sketch,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "sketch",
+                                    .description = "How the k-mers are chosen. minimiser: The smallest k-mer of each "
+                                                   "window. syncmer: Open syncmers, chosen by their smallest s-mer. "
+                                                   "The s-mer size is chosen such that there are about as many "
+                                                   "syncmers as minimisers for the window size. An error only affects "
+                                                   "the syncmers that contain it. Requires an ungapped shape of at "
+                                                   "least 3 bases.",
+                                    .default_message = "minimiser"});
 
     parser.add_subsection("Processing options");
     parser.add_option(arguments.kmer_count_cutoff,
@@ -99,6 +130,24 @@ void init_prepare_parser(sharg::parser & parser, prepare_arguments & arguments)
                                   .long_id = "use-filesize-dependent-cutoff",
                                   .description = "Apply cutoffs from Mantis(Pandey et al., 2018). "
                                                  "Mutually exclusive with --kmer-count-cutoff."});
+    parser.add_option(arguments.counting_memory,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "counting-memory",
+                                    .description = "The memory (in MiB) that all threads together may use for counting "
+                                                   "k-mers. If a file needs more memory, the counts are written to "
+                                                   "temporary files in the output directory and merged. The results "
+                                                   "are the same.",
+                                    .default_message = "No limit",
+                                    .validator = positive_integer_validator{}});
+    parser.add_option(arguments.memory_limit,
+                      sharg::config{.short_id = '\0',
+                                    .long_id = "memory-limit",
+                                    .description = "The memory (in MiB) that all threads together may use. Limits how "
+                                                   "many large files are processed at the same time. The memory needed "
+                                                   "for a file is estimated from its size. A file that exceeds the "
+                                                   "limit on its own is processed while no other file is processed.",
+                                    .default_message = "No limit",
+                                    .validator = positive_integer_validator{}});
 }
 
 void prepare_parsing(sharg::parser & parser)
@@ -109,6 +158,9 @@ void prepare_parsing(sharg::parser & parser)
     init_prepare_parser(parser, arguments);
     parser.parse();
 
+    if (parser.is_option_set("trace"))
+        enable_tracing();
+
     if (parser.is_option_set("kmer-count-cutoff") && parser.is_option_set("use-filesize-dependent-cutoff"))
         throw sharg::parser_error{"You cannot use both --kmer-count-cutoff and --use-filesize-dependent-cutoff."};
 
@@ -120,6 +172,9 @@ void prepare_parsing(sharg::parser & parser)
 
     arguments.wall_clock_timer.stop();
     arguments.print_timings();
+
+    if (parser.is_option_set("trace"))
+        write_trace(arguments.trace_file);
 }
 
 } // namespace raptor
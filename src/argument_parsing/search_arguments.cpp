@@ -17,6 +17,19 @@
 namespace raptor
 {
 
+namespace detail
+{
+
+// Writes p50, p90, p99, and max in microseconds. Each value is preceded by a tab.
+void write_percentiles(std::ostream & output_stream, latency_histogram const & histogram)
+{
+    for (double const percentile : {50.0, 90.0, 99.0})
+        output_stream << '\t' << histogram.percentile(percentile) / 1000.0;
+    output_stream << '\t' << histogram.max() / 1000.0;
+}
+
+} // namespace detail
+
 void search_arguments::print_timings() const
 {
     std::cerr << std::fixed << std::setprecision(2) << "============= Timings =============\n";
@@ -48,7 +61,13 @@ void search_arguments::print_timings() const
     std::cerr << "├── Determine query length [s]: " << query_length_timer.in_seconds() << '\n';
     std::cerr << "└── Complete search [s]: " << complete_search_timer.in_seconds() << '\n';
     std::cerr << "    ├── Query file I/O [s]: " << query_file_io_timer.in_seconds() << '\n';
+    // seqan::hibf::interleaved_bloom_filter zeroes its bit vector on one thread before it is read in parallel.
+    bool const zeroes_serially = !is_hibf && !is_blocked_ibf;
     std::cerr << "    ├── Load index [s]: " << load_index_timer.in_seconds() << '\n';
+    std::cerr << (zeroes_serially ? "    │   ├── " : "    │   └── ") << "Throughput [MiB/s]: "
+              << index_throughput_in_MiB_per_second(index_file, parts, load_index_timer.in_seconds()) << '\n';
+    if (zeroes_serially)
+        std::cerr << "    │   └── Includes zeroing the IBF on one thread\n";
     std::cerr << "    └── Parallel search [s]: " << parallel_search_timer.in_seconds() << '\n';
 
     if (cpu_usage_search > 0.0)
@@ -57,15 +76,27 @@ void search_arguments::print_timings() const
         std::cerr << "        ├── CPU usage [%]: Not available\n"; // GCOVR_EXCL_LINE
 
     // Each thread does `thread` many chunks; see `do_parallel()`.
+    auto print_stage = [&](std::string_view const prefix,
+                           seqan::hibf::concurrent_timer const & timer,
+                           concurrent_perf_counters const & counters)
+    {
+        std::cerr << prefix << "├── Max [s]: " << timer.max_in_seconds() * threads << '\n';
+        if (!perf_counters)
+        {
+            std::cerr << prefix << "└── Avg [s]: " << timer.avg_in_seconds() * threads << '\n';
+            return;
+        }
+        std::cerr << prefix << "├── Avg [s]: " << timer.avg_in_seconds() * threads << '\n';
+        std::cerr << prefix << "└── Hardware counters\n";
+        counters.print(std::cerr, std::string{prefix} + "    ");
+    };
+
     std::cerr << "        ├── Compute minimiser\n";
-    std::cerr << "        │   ├── Max [s]: " << compute_minimiser_timer.max_in_seconds() * threads << '\n';
-    std::cerr << "        │   └── Avg [s]: " << compute_minimiser_timer.avg_in_seconds() * threads << '\n';
+    print_stage("        │   ", compute_minimiser_timer, compute_minimiser_counters);
     std::cerr << "        ├── Query IBF\n";
-    std::cerr << "        │   ├── Max [s]: " << query_ibf_timer.max_in_seconds() * threads << '\n';
-    std::cerr << "        │   └── Avg [s]: " << query_ibf_timer.avg_in_seconds() * threads << '\n';
+    print_stage("        │   ", query_ibf_timer, query_ibf_counters);
     std::cerr << "        └── Generate results\n";
-    std::cerr << "            ├── Max [s]: " << generate_results_timer.max_in_seconds() * threads << '\n';
-    std::cerr << "            └── Avg [s]: " << generate_results_timer.avg_in_seconds() * threads << '\n';
+    print_stage("            ", generate_results_timer, generate_results_counters);
 }
 
 void search_arguments::write_timings_to_file() const
@@ -83,6 +114,7 @@ void search_arguments::write_timings_to_file() const
                   << "complete_search_in_seconds\t"
                   << "query_file_io_in_seconds\t"
                   << "load_index_in_seconds\t"
+                  << "load_index_throughput_in_mebibytes_per_second\t"
                   << "parallel_search_in_seconds\t"
                   << "cpu_usage_parallel_search_in_percent\t"
                   << "compute_minimiser_max_in_seconds\t"
@@ -90,7 +122,24 @@ void search_arguments::write_timings_to_file() const
                   << "query_ibf_max_in_seconds\t"
                   << "query_ibf_avg_in_seconds\t"
                   << "generate_results_max_in_seconds\t"
-                  << "generate_results_avg_in_seconds\n";
+                  << "generate_results_avg_in_seconds";
+
+    if (latency_histograms)
+    {
+        for (std::string_view const stage : stage_latencies::stage_names)
+        {
+            output_stream << '\t' << stage << "_p50_in_microseconds"
+                          << '\t' << stage << "_p90_in_microseconds"
+                          << '\t' << stage << "_p99_in_microseconds"
+                          << '\t' << stage << "_max_in_microseconds";
+        }
+    }
+    if (perf_counters)
+    {
+        for (std::string_view const stage : stage_latencies::stage_names)
+            concurrent_perf_counters::write_header(output_stream, stage);
+    }
+    output_stream << '\n';
 
     if (long const peak_ram_KiB = peak_ram_in_KiB(); peak_ram_KiB != -1L)
         output_stream << peak_ram_KiB << '\t';
@@ -124,6 +173,7 @@ void search_arguments::write_timings_to_file() const
     output_stream << complete_search_timer.in_seconds() << '\t';
     output_stream << query_file_io_timer.in_seconds() << '\t';
     output_stream << load_index_timer.in_seconds() << '\t';
+    output_stream << index_throughput_in_MiB_per_second(index_file, parts, load_index_timer.in_seconds()) << '\t';
     output_stream << parallel_search_timer.in_seconds() << '\t';
 
     if (cpu_usage_search > 0.0)
@@ -137,7 +187,58 @@ void search_arguments::write_timings_to_file() const
     output_stream << query_ibf_timer.max_in_seconds() * threads << '\t';
     output_stream << query_ibf_timer.avg_in_seconds() * threads << '\t';
     output_stream << generate_results_timer.max_in_seconds() * threads << '\t';
-    output_stream << generate_results_timer.avg_in_seconds() * threads << '\n';
+    output_stream << generate_results_timer.avg_in_seconds() * threads;
+
+    if (latency_histograms)
+    {
+        for (size_t stage = 0; stage < stage_latencies::number_of_stages; ++stage)
+        {
+            latency_stage const current_stage = static_cast<latency_stage>(stage);
+            detail::write_percentiles(output_stream, stage_latency.get().histogram(current_stage));
+        }
+    }
+    if (perf_counters)
+    {
+        compute_minimiser_counters.write_values(output_stream);
+        query_ibf_counters.write_values(output_stream);
+        generate_results_counters.write_values(output_stream);
+    }
+    output_stream << '\n';
+
+    if (latency_histograms)
+        write_latencies_per_length_to_file();
+}
+
+void search_arguments::write_latencies_per_length_to_file() const
+{
+    std::ofstream output_stream{std::filesystem::path{timing_out}.concat(".latency")};
+    output_stream << std::fixed << std::setprecision(2);
+    output_stream << "stage\t"
+                  << "min_query_length\t"
+                  << "max_query_length\t"
+                  << "number_of_queries\t"
+                  << "p50_in_microseconds\t"
+                  << "p90_in_microseconds\t"
+                  << "p99_in_microseconds\t"
+                  << "max_in_microseconds\n";
+
+    for (size_t stage = 0; stage < stage_latencies::number_of_stages; ++stage)
+    {
+        auto const & histograms = stage_latency.get().histograms_per_length(static_cast<latency_stage>(stage));
+        for (size_t length_class = 0; length_class < histograms.size(); ++length_class)
+        {
+            if (histograms[length_class].count() == 0u)
+                continue;
+
+            // Length class `i` contains queries of length `[2^(i-1), 2^i)`.
+            uint64_t const min_length = length_class == 0u ? 0u : 1ULL << (length_class - 1u);
+            uint64_t const max_length = length_class == 0u ? 0u : (1ULL << (length_class - 1u)) * 2u - 1u;
+            output_stream << stage_latencies::stage_names[stage] << '\t' << min_length << '\t' << max_length << '\t'
+                          << histograms[length_class].count();
+            detail::write_percentiles(output_stream, histograms[length_class]);
+            output_stream << '\n';
+        }
+    }
 }
 
 } // namespace raptor
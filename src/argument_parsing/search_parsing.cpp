@@ -9,13 +9,14 @@
 
 #include <yaml-cpp/yaml.h>
 
-#include <seqan3/io/views/async_input_buffer.hpp>
-
 #include <raptor/argument_parsing/search_parsing.hpp>
+#include <raptor/argument_parsing/shared.hpp>
 #include <raptor/argument_parsing/validators.hpp>
-#include <raptor/dna4_traits.hpp>
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/search/query_reader.hpp>
 #include <raptor/search/search.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -75,6 +76,9 @@ void fpga_checks(search_arguments const & arguments, size_t const max_query_leng
     if (arguments.is_hibf)
         throw sharg::parser_error{"The HIBF index is not supported."};
 
+    if (arguments.is_blocked_ibf)
+        throw sharg::parser_error{"The blocked IBF index is not supported."};
+
     if (max_query_length > 250u)
         throw sharg::parser_error{"The query length is too long. The maximum is 250."};
 
@@ -99,6 +103,50 @@ void init_fpga_parser(sharg::parser & parser, search_arguments & arguments)
 }
 #endif
 
+struct query_length_warnings
+{
+    bool variance{false};
+    bool too_short{false};
+    bool too_long{false};
+};
+
+// Each warning is emitted at most once.
+void check_query_lengths(search_arguments const & arguments,
+                         bool const check_variance,
+                         bool const check_window_size,
+                         query_length_warnings & emitted)
+{
+    uint64_t const min_query_length = arguments.min_query_length;
+    uint64_t const max_query_length = arguments.max_query_length;
+
+    if (check_variance && !emitted.variance && max_query_length - min_query_length > arguments.query_length / 20u)
+    {
+        std::cerr << "[WARNING] There is variance in the provided queries. The shortest length is " << min_query_length
+                  << ". The longest length is " << max_query_length
+                  << ". The tresholding will use a single query length (" << arguments.query_length
+                  << "). Therefore, results may be inprecise.\n";
+        emitted.variance = true;
+    }
+
+    if (check_window_size && !emitted.too_short && min_query_length < arguments.window_size)
+    {
+        std::cerr << "[WARNING] There are queries which are shorter than the window size (" << arguments.window_size
+                  << "). The shortest length is " << min_query_length << ". Results for these queries are not "
+                  << "meaningful.\n";
+        emitted.too_short = true;
+    }
+
+    // We currently use counting_agent<uint16_t> and membership_agent (which uses uint16_t fixed).
+    if (!emitted.too_long && max_query_length > std::numeric_limits<uint16_t>::max())
+    {
+        std::cerr << "[WARNING] There are queries which exceed the maximum safely supported length of "
+                  << std::numeric_limits<uint16_t>::max()
+                  << ". Results may be wrong, especially when using window size == k-mer size. If you need longer "
+                     "queries to be supported, please open an issue at https://github.com/seqan/raptor/issues.\n";
+        emitted.too_long = true;
+    }
+}
+
 void init_search_parser(sharg::parser & parser, search_arguments & arguments)
 {
     parser.info.short_description = "Queries a Raptor index";
@@ -146,6 +194,28 @@ void init_search_parser(sharg::parser & parser, search_arguments & arguments)
                                     .long_id = "timing-output",
                                     .description = "Write time and memory usage to specified file (TSV format).",
                                     .validator = output_file_validator{}});
+    parser.add_flag(arguments.latency_histograms,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "latency-histograms",
+                                  .description = "Record the latency of each query for each search stage. Requires "
+                                                 "--timing-output. Percentiles are added to the timing output. "
+                                                 "Percentiles per query length are written to <timing-output>.latency "
+                                                 "(TSV format)."});
+    parser.add_flag(arguments.perf_counters,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "perf-counters",
+                                  .description = "Measure cycles, instructions, last level cache misses, and data TLB "
+                                                 "misses of each search stage. The counters are added to the timings. "
+                                                 "Counters that cannot be measured, e.g., due to missing permissions "
+                                                 "for perf_event_open, are reported as not available."});
+    parser.add_flag(arguments.lazy_load,
+                    sharg::config{.short_id = '\0',
+                                  .long_id = "lazy-load",
+                                  .description = "Only available for HIBF indices. Load the top-level IBF before the "
+                                                 "search, and the other IBFs when a query reaches them for the first "
+                                                 "time. Reduces the start-up time and the memory usage if the queries "
+                                                 "only hit a few subtrees of the HIBF."});
+    add_trace_option(parser, arguments.trace_file);
 #if RAPTOR_FPGA
     init_fpga_parser(parser, arguments);
 #endif
@@ -215,7 +285,7 @@ void init_search_parser(sharg::parser & parser, search_arguments & arguments)
                                            outputBinding:
                                              glob: $(inputs.output_name)
                                        )-");
-        for (auto const elem : {"error", "threshold", "query_length", "timing-output"})
+        for (auto const elem : {"error", "threshold", "query_length", "timing-output", "trace"})
             inputs[elem].remove("default");
     };
     // GCOVR_EXCL_STOP
@@ -229,6 +299,9 @@ void search_parsing(sharg::parser & parser)
     init_search_parser(parser, arguments);
     parser.parse();
 
+    if (parser.is_option_set("trace"))
+        enable_tracing();
+
     // ==========================================
     // Various checks.
     // ==========================================
@@ -239,6 +312,9 @@ void search_parsing(sharg::parser & parser)
     if (std::filesystem::is_empty(arguments.query_file))
         throw sharg::parser_error{"The query file is empty."};
 
+    if (arguments.latency_histograms && !parser.is_option_set("timing-output"))
+        throw sharg::parser_error{"--latency-histograms requires --timing-output."};
+
     std::filesystem::path const partitioned_index_file = arguments.index_file.string() + "_0";
     bool const index_is_monolithic = std::filesystem::exists(arguments.index_file);
     bool const index_is_partitioned = std::filesystem::exists(partitioned_index_file);
@@ -264,63 +340,55 @@ void search_parsing(sharg::parser & parser)
     // ==========================================
     // Process --query_length.
     // ==========================================
-    size_t min_query_length{arguments.query_length};
-    size_t max_query_length{arguments.query_length};
+    bool const query_length_is_estimated = !parser.is_option_set("query_length");
+    bool const check_variance = query_length_is_estimated && !parser.is_option_set("threshold");
+    query_length_warnings emitted_warnings{};
+    arguments.min_query_length = arguments.query_length;
+    arguments.max_query_length = arguments.query_length;
 
-    if (!parser.is_option_set("query_length"))
+    if (query_length_is_estimated)
     {
+        // The lengths are estimated from a sample. The exact lengths are checked again after the search.
         arguments.query_length_timer.start();
-        std::vector<uint64_t> sequence_lengths{};
-        seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::seq>> query_in{arguments.query_file};
-
-        for (auto && record : query_in | seqan3::views::async_input_buffer(1024))
-            sequence_lengths.push_back(std::ranges::size(record.sequence()));
-
-        std::ranges::sort(sequence_lengths);
-        arguments.query_length = sequence_lengths[sequence_lengths.size() / 2];
-        min_query_length = sequence_lengths.front();
-        max_query_length = sequence_lengths.back();
-
-        if (!parser.is_option_set("threshold") && max_query_length - min_query_length > arguments.query_length / 20u)
+        trace_scope query_length_trace{"Determine query length", "search"};
+        std::vector<uint64_t> const sequence_lengths = sample_query_lengths(arguments.query_file, arguments.threads);
+        if (!sequence_lengths.empty())
         {
-            std::cerr << "[WARNING] There is variance in the provided queries. The shortest length is "
-                      << min_query_length << ". The longest length is " << max_query_length
-                      << ". The tresholding will use a single query length (" << arguments.query_length
-                      << "). Therefore, results may be inprecise.\n";
+            arguments.query_length = sequence_lengths[sequence_lengths.size() / 2];
+            arguments.min_query_length = sequence_lengths.front();
+            arguments.max_query_length = sequence_lengths.back();
         }
+        query_length_trace.stop();
         arguments.query_length_timer.stop();
     }
 
-    // We currently use counting_agent<uint16_t> and membership_agent (which uses uint16_t fixed).
-    if (max_query_length > std::numeric_limits<uint16_t>::max())
-    {
-        std::cerr << "[WARNING] There are queries which exceed the maximum safely supported length of "
-                  << std::numeric_limits<uint16_t>::max()
-                  << ". Results may be wrong, especially when using window size == k-mer size. If you need longer "
-                     "queries to be supported, please open an issue at https://github.com/seqan/raptor/issues.\n";
-    }
+    check_query_lengths(arguments, check_variance, false, emitted_warnings);
 
     // ==========================================
-    // Read window and kmer size, and the bin paths.
+    // Read window and kmer size, the sketch, and the bin paths.
     // ==========================================
     {
-        std::ifstream is{index_is_partitioned ? partitioned_index_file : arguments.index_file, std::ios::binary};
-        cereal::BinaryInputArchive iarchive{is};
         raptor_index<> tmp{};
-        tmp.load_parameters(iarchive);
+        read_index_parameters(tmp, index_is_partitioned ? partitioned_index_file : arguments.index_file);
         arguments.shape = tmp.shape();
         arguments.shape_size = arguments.shape.size();
         arguments.shape_weight = arguments.shape.count();
         arguments.window_size = tmp.window_size();
+        arguments.sketch = tmp.sketch();
         arguments.parts = tmp.parts();
-        arguments.bin_path = tmp.bin_path();
+        arguments.partitioning = tmp.partitioning();
+        arguments.bin_path = std::move(tmp).bin_path();
         arguments.fpr = tmp.fpr();
         arguments.is_hibf = tmp.is_hibf();
+        arguments.is_blocked_ibf = tmp.is_blocked_ibf();
     }
 
-    if (min_query_length < arguments.window_size)
+    if (arguments.lazy_load && !arguments.is_hibf)
+        throw sharg::parser_error{"--lazy-load is only available for HIBF indices."};
+
+    if (arguments.min_query_length < arguments.window_size)
         throw sharg::parser_error{sharg::detail::to_string("The (minimal) query length (",
-                                                           min_query_length,
+                                                           arguments.min_query_length,
                                                            ") is too short to be used with window size ",
                                                            arguments.window_size,
                                                            '.')};
@@ -344,7 +412,7 @@ void search_parsing(sharg::parser & parser)
     }
 
 #if RAPTOR_FPGA
-    fpga_checks(arguments, max_query_length, min_query_length);
+    fpga_checks(arguments, arguments.max_query_length, arguments.min_query_length);
 #endif
 
     // ==========================================
@@ -352,11 +420,17 @@ void search_parsing(sharg::parser & parser)
     // ==========================================
     raptor_search(arguments);
 
+    // The search has seen all queries.
+    if (query_length_is_estimated)
+        check_query_lengths(arguments, check_variance, true, emitted_warnings);
+
     arguments.wall_clock_timer.stop();
     if (!arguments.quiet)
         arguments.print_timings();
     if (parser.is_option_set("timing-output"))
         arguments.write_timings_to_file();
+    if (parser.is_option_set("trace"))
+        write_trace(arguments.trace_file);
 }
 
 } // namespace raptor
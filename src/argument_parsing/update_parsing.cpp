@@ -8,9 +8,12 @@
  */
 
 #include <raptor/argument_parsing/parse_bin_path.hpp>
+#include <raptor/argument_parsing/shared.hpp>
 #include <raptor/argument_parsing/update_parsing.hpp>
 #include <raptor/argument_parsing/validators.hpp>
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/trace.hpp>
 #include <raptor/update/update.hpp>
 
 namespace raptor
@@ -38,6 +41,7 @@ void init_update_parser(sharg::parser & parser, update_arguments & arguments)
                                     .long_id = "threads",
                                     .description = "The number of threads to use.",
                                     .validator = positive_integer_validator{}});
+    add_trace_option(parser, arguments.trace_file);
 }
 
 void init_delete_parser(sharg::parser & parser, update_arguments & arguments)
@@ -100,6 +104,9 @@ void update_parsing(sharg::parser & parser)
 
     sub_parser.parse();
 
+    if (sub_parser.is_option_set("trace"))
+        enable_tracing();
+
     if (sub_parser.info.app_name == std::string_view{"Raptor-update-insert"})
     {
         if (std::filesystem::is_empty(arguments.bin_file))
@@ -119,10 +126,8 @@ void update_parsing(sharg::parser & parser)
     // Read window and kmer size, and the bin paths.
     // ==========================================
     {
-        std::ifstream is{arguments.index_file, std::ios::binary};
-        cereal::BinaryInputArchive iarchive{is};
         raptor_index<index_structure::hibf> tmp{};
-        tmp.load_parameters(iarchive);
+        read_index_parameters(tmp, arguments.index_file);
         arguments.shape = tmp.shape();
         arguments.shape_size = arguments.shape.size();
         arguments.shape_weight = arguments.shape.count();
@@ -144,6 +149,9 @@ void update_parsing(sharg::parser & parser)
     }
 
     raptor_update(arguments);
+
+    if (sub_parser.is_option_set("trace"))
+        write_trace(arguments.trace_file);
 }
 
 } // namespace raptor
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::build_checkpoint.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <hibf/misc/next_multiple_of_64.hpp>
+
+#include <raptor/build/build_checkpoint.hpp>
+#include <raptor/trace.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+// Increase if the file format changes.
+constexpr std::string_view checkpoint_magic{"RAPTOR_BUILD_CHECKPOINT_2\n"};
+
+// The number of words of the IBF that are copied at once.
+constexpr size_t checkpoint_block_words{1ULL << 17};
+
+// Everything that determines the content of the IBF.
+std::string checkpoint_key(build_arguments const & arguments)
+{
+    std::string result{arguments.shape.to_string() + '\t' + std::to_string(arguments.window_size) + '\t'
+                       + std::to_string(arguments.bins) + '\t' + std::to_string(arguments.bits) + '\t'
+                       + std::to_string(arguments.hash) + '\t' + std::to_string(arguments.bin_range_begin) + '\t'
+                       + std::to_string(arguments.bin_range_end) + '\t'
+                       + std::to_string(std::to_underlying(arguments.sketch))};
+    for (std::vector<std::string> const & user_bin : arguments.bin_path)
+    {
+        result += '\n';
+        for (std::string const & file_name : user_bin)
+        {
+            std::error_code ec{};
+            uint64_t const size = std::filesystem::file_size(file_name, ec);
+            result += file_name;
+            result += '\t';
+            result += std::to_string(ec ? 0u : size);
+            result += '\t';
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+build_checkpoint::build_checkpoint(build_arguments const & arguments, seqan::hibf::interleaved_bloom_filter & ibf) :
+    file{path(arguments)},
+    key{detail::checkpoint_key(arguments)},
+    interval{arguments.checkpoint_interval},
+    data{ibf.data()},
+    words{seqan::hibf::next_multiple_of_64(ibf.bin_count()) * ibf.bin_size() / 64u},
+    finished(arguments.bin_path.size())
+{
+    if (arguments.resume && std::filesystem::exists(file))
+        load();
+}
+
+build_checkpoint::~build_checkpoint()
+{
+    stop();
+}
+
+std::filesystem::path build_checkpoint::path(build_arguments const & arguments)
+{
+    std::filesystem::path result{arguments.out_path};
+    result += ".checkpoint";
+    return result;
+}
+
+void build_checkpoint::load()
+{
+    trace_scope const load_trace{"Load checkpoint", "build"};
+    std::ifstream stream{file, std::ios::binary};
+
+    std::string magic(detail::checkpoint_magic.size(), '\0');
+    uint64_t key_size{};
+    stream.read(magic.data(), magic.size());
+    stream.read(reinterpret_cast<char *>(&key_size), sizeof(key_size));
+    std::string stored_key(stream && key_size == key.size() ? key_size : 0u, '\0');
+    stream.read(stored_key.data(), stored_key.size());
+
+    if (!stream || magic != detail::checkpoint_magic || stored_key != key)
+        throw std::runtime_error{"The checkpoint " + file.string()
+                                 + " was written for different input files or options. Remove it to start over."};
+
+    uint64_t stored_words{};
+    stream.read(reinterpret_cast<char *>(finished.data()), finished.size());
+    stream.read(reinterpret_cast<char *>(&stored_words), sizeof(stored_words));
+    if (stored_words == words)
+        stream.read(reinterpret_cast<char *>(data), words * sizeof(uint64_t));
+
+    if (!stream || stored_words != words)
+        throw std::runtime_error{"Failed to read the checkpoint " + file.string()}; // GCOVR_EXCL_LINE
+}
+
+void build_checkpoint::start()
+{
+    if (interval == 0u)
+        return;
+
+    writer = std::thread{[this]()
+                         {
+                             run();
+                         }};
+}
+
+void build_checkpoint::finish_bin(size_t const bin_number)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    finished[bin_number] = 1u;
+}
+
+void build_checkpoint::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    stop_requested.notify_all();
+
+    if (writer.joinable())
+        writer.join();
+}
+
+void build_checkpoint::run()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    while (!stop_requested.wait_for(lock,
+                                    std::chrono::seconds{interval},
+                                    [this]()
+                                    {
+                                        return stopping.load();
+                                    }))
+    {
+        // All k-mers of the user bins in the snapshot have been inserted before finish_bin acquired the mutex.
+        std::vector<uint8_t> const snapshot{finished};
+        lock.unlock();
+        write(snapshot);
+        lock.lock();
+    }
+}
+
+void build_checkpoint::write(std::vector<uint8_t> const & snapshot) const
+{
+    trace_scope const checkpoint_trace{"Write checkpoint", "build"};
+    std::filesystem::path temporary_path{file};
+    temporary_path += ".tmp";
+
+    {
+        std::ofstream stream{temporary_path, std::ios::binary};
+        uint64_t const key_size{key.size()};
+        uint64_t const stored_words{words};
+        stream.write(detail::checkpoint_magic.data(), detail::checkpoint_magic.size());
+        stream.write(reinterpret_cast<char const *>(&key_size), sizeof(key_size));
+        stream.write(key.data(), key.size());
+        stream.write(reinterpret_cast<char const *>(snapshot.data()), snapshot.size());
+        stream.write(reinterpret_cast<char const *>(&stored_words), sizeof(stored_words));
+
+        // The fill threads set bits concurrently.
+        std::vector<uint64_t> block(std::min(words, detail::checkpoint_block_words));
+        for (size_t offset = 0; offset < words && !stopping.load(std::memory_order_relaxed); offset += block.size())
+        {
+            size_t const count = std::min(block.size(), words - offset);
+            for (size_t i = 0; i < count; ++i)
+                block[i] = std::atomic_ref<uint64_t>{data[offset + i]}.load(std::memory_order_relaxed);
+            stream.write(reinterpret_cast<char const *>(block.data()), count * sizeof(uint64_t));
+        }
+
+        if (stopping.load(std::memory_order_relaxed) || !stream.good())
+        {
+            stream.close();
+            std::filesystem::remove(temporary_path);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporary_path, file);
+}
+
+} // namespace raptor
@@ -12,6 +12,7 @@
 #include <raptor/build/build_hibf.hpp>
 #include <raptor/build/store_index.hpp>
 #include <raptor/file_reader.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -22,16 +23,23 @@ void build_hibf(build_arguments const & arguments)
     if (arguments.input_is_minimiser)
         reader = file_reader<file_types::minimiser>{};
     else
-        reader = file_reader<file_types::sequence>{arguments.shape, arguments.window_size};
+        reader = file_reader<file_types::sequence>{arguments.shape, arguments.window_size, arguments.sketch};
 
     auto input_lambda = [&arguments, &reader](size_t const user_bin_id, seqan::hibf::insert_iterator it)
     {
+        // Called by the worker threads of the HIBF construction.
+        trace_scope const user_bin_trace{"User bin", "worker", "user_bin_id", user_bin_id};
+        perf_counter_group const counter_group{arguments.perf_counters};
+        serial_perf_counters local_counters{counter_group};
+        local_counters.start();
         std::visit(
             [&](auto const & reader)
             {
                 reader.hash_into(arguments.bin_path[user_bin_id], it);
             },
             reader);
+        local_counters.stop();
+        arguments.user_bin_io_counters += local_counters;
     };
 
     // Parse config+layout
@@ -49,7 +57,9 @@ void build_hibf(build_arguments const & arguments)
     config.threads = arguments.threads;
 
     // Call ctor
+    trace_scope construct_trace{"Construct HIBF", "build"};
     seqan::hibf::hierarchical_interleaved_bloom_filter hibf{config, layout};
+    construct_trace.stop();
 
     arguments.index_allocation_timer = std::move(hibf.index_allocation_timer);
     arguments.user_bin_io_timer = std::move(hibf.user_bin_io_timer);
@@ -57,16 +67,21 @@ void build_hibf(build_arguments const & arguments)
     arguments.fill_ibf_timer = std::move(hibf.fill_ibf_timer);
 
     arguments.index_allocation_timer.start();
+    trace_scope index_allocation_trace{"Index allocation", "build"};
     raptor_index<index_structure::hibf> index{window{arguments.window_size},
                                               arguments.shape,
                                               arguments.parts,
-                                              arguments.bin_path,
+                                              bin_path_table{arguments.bin_path},
                                               config,
-                                              std::move(hibf)};
+                                              std::move(hibf),
+                                              arguments.sketch};
+    index_allocation_trace.stop();
     arguments.index_allocation_timer.stop();
 
     arguments.store_index_timer.start();
-    store_index(arguments.out_path, std::move(index));
+    trace_scope store_index_trace{"Store index", "build"};
+    store_index(arguments.out_path, std::move(index), arguments.threads, arguments.compression);
+    store_index_trace.stop();
     arguments.store_index_timer.stop();
 }
 
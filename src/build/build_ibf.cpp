@@ -7,37 +7,158 @@
  * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
  */
 
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
 #include <hibf/build/bin_size_in_bits.hpp>
+#include <hibf/misc/next_multiple_of_64.hpp>
 
+#include <raptor/build/build_checkpoint.hpp>
 #include <raptor/build/index_factory.hpp>
 #include <raptor/build/max_count_per_partition.hpp>
 #include <raptor/build/partition_config.hpp>
+#include <raptor/build/partition_spill.hpp>
 #include <raptor/build/store_index.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
 
+namespace detail
+{
+
+// The largest power of two that fits into build_arguments::parts.
+constexpr uint8_t max_parts{128u};
+
+// The size of the IBF of a part. See raptor_index(build_arguments const &) and seqan::hibf::interleaved_bloom_filter.
+uint64_t part_bytes(build_arguments const & arguments, uint64_t const bits, size_t const parts)
+{
+    return seqan::hibf::next_multiple_of_64(arguments.bins) * (bits / parts) / 8u;
+}
+
+// The memory that the IBFs may use: the --memory-limit, or half of the physical memory.
+uint64_t available_memory(build_arguments const & arguments)
+{
+    if (arguments.memory_limit != 0u)
+        return arguments.memory_limit << 20;
+
+    long const pages = sysconf(_SC_PHYS_PAGES);
+    long const page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0)
+        return 0u; // GCOVR_EXCL_LINE
+
+    return static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size) / 2u;
+}
+
+// Whether all parts fit into the available memory at once.
+bool parts_fit_in_memory(build_arguments const & arguments, std::vector<uint64_t> const & bits_per_part)
+{
+    uint64_t bytes{};
+    for (uint64_t const bits : bits_per_part)
+        bytes += part_bytes(arguments, bits, arguments.parts);
+
+    return bytes <= available_memory(arguments);
+}
+
+// Whether each part fits into the --memory-limit on its own.
+bool each_part_fits_memory_limit(build_arguments const & arguments, std::vector<uint64_t> const & bits_per_part)
+{
+    return arguments.memory_limit == 0u
+        || std::ranges::all_of(bits_per_part,
+                               [&](uint64_t const bits)
+                               {
+                                   return part_bytes(arguments, bits, arguments.parts) <= available_memory(arguments);
+                               });
+}
+
+/* The number of parts needed for the --memory-limit, estimated from the size of the unpartitioned index.
+ * The k-mers are distributed evenly among the parts. The largest part is expected to be slightly larger than the
+ * average, so 10% of the limit are kept in reserve.
+ */
+uint8_t estimate_parts(build_arguments const & arguments)
+{
+    uint8_t parts{2u};
+    while (parts < max_parts
+           && part_bytes(arguments, arguments.bits / parts, parts) > available_memory(arguments) / 10u * 9u)
+        parts *= 2u;
+    return parts;
+}
+
+std::vector<uint64_t> bits_of_parts(build_arguments const & arguments, std::vector<size_t> const & kmers_per_partition)
+{
+    std::vector<uint64_t> result(kmers_per_partition.size());
+    for (size_t part = 0; part < kmers_per_partition.size(); ++part)
+        result[part] = seqan::hibf::build::bin_size_in_bits(
+            {.fpr = arguments.fpr, .hash_count = arguments.hash, .elements = kmers_per_partition[part]});
+    return result;
+}
+
+/* The bits of each part for the fewest parts, starting at build_arguments::parts, for which each part fits into the
+ * --memory-limit. Increases build_arguments::parts accordingly. The input is read once for all numbers of parts.
+ */
+std::vector<uint64_t> compute_bits_per_part(build_arguments const & arguments)
+{
+    // Without --memory-limit, the number of parts is not increased.
+    size_t const max_partitions = arguments.memory_limit == 0u ? arguments.parts : max_parts;
+    auto fits = [&arguments](std::vector<size_t> const & kmers_per_partition)
+    {
+        arguments.parts = static_cast<uint8_t>(kmers_per_partition.size());
+        return each_part_fits_memory_limit(arguments, bits_of_parts(arguments, kmers_per_partition));
+    };
+
+    std::vector<size_t> const kmers_per_partition =
+        max_count_per_partition(partition_config{arguments.parts}, max_partitions, arguments, fits);
+
+    if (!fits(kmers_per_partition))
+        throw std::runtime_error{"The index does not fit into the memory limit, even with "
+                                 + std::to_string(max_parts) + " parts."};
+
+    return bits_of_parts(arguments, kmers_per_partition);
+}
+
+} // namespace detail
+
 void build_ibf(build_arguments const & arguments)
 {
+    // With --memory-limit, an index that does not fit is partitioned. Parsing only rejects checkpoints for --parts.
+    if (arguments.parts == 1u && !detail::each_part_fits_memory_limit(arguments, {arguments.bits}))
+    {
+        if (arguments.uses_checkpoint())
+            throw std::runtime_error{"The index does not fit into the memory limit and would be partitioned, but "
+                                     "--checkpoint-interval and --resume are only available for unpartitioned IBFs."};
+        arguments.parts = detail::estimate_parts(arguments);
+    }
+
     if (arguments.parts == 1u)
     {
         index_factory factory{arguments};
-        auto index = factory();
-        arguments.store_index_timer.start();
-        store_index(arguments.out_path, std::move(index));
-        arguments.store_index_timer.stop();
+        auto store = [&arguments](auto && index)
+        {
+            arguments.store_index_timer.start();
+            trace_scope store_index_trace{"Store index", "build"};
+            store_index(arguments.out_path, std::move(index), arguments.threads, arguments.compression);
+            store_index_trace.stop();
+            arguments.store_index_timer.stop();
+        };
+
+        if (arguments.is_blocked_ibf)
+            store(factory.construct_blocked_ibf());
+        else
+            store(factory());
+
+        if (arguments.uses_checkpoint())
+            std::filesystem::remove(build_checkpoint::path(arguments));
     }
     else
     {
+        std::vector<uint64_t> const bits_per_part = detail::compute_bits_per_part(arguments);
+
         partition_config const cfg{arguments.parts};
         index_factory factory{arguments, cfg};
-        std::vector<size_t> const kmers_per_partition = max_count_per_partition(cfg, arguments);
 
-        for (size_t part = 0; part < arguments.parts; ++part)
+        auto store_part = [&arguments](raptor_index<> && index, size_t const part)
         {
-            arguments.bits = seqan::hibf::build::bin_size_in_bits(
-                {.fpr = arguments.fpr, .hash_count = arguments.hash, .elements = kmers_per_partition[part]});
-            auto index = factory(part);
             std::filesystem::path out_path{arguments.out_path};
 #if HIBF_WORKAROUND_GCC_BOGUS_MEMCPY
 #    pragma GCC diagnostic push
@@ -48,8 +169,30 @@ void build_ibf(build_arguments const & arguments)
 #    pragma GCC diagnostic pop
 #endif // HIBF_WORKAROUND_GCC_BOGUS_MEMCPY
             arguments.store_index_timer.start();
-            store_index(out_path, std::move(index));
+            trace_scope store_index_trace{"Store index", "build"};
+            store_index(out_path, std::move(index), arguments.threads, arguments.compression);
+            store_index_trace.stop();
             arguments.store_index_timer.stop();
+        };
+
+        // Each input is read once. Either all parts are filled at once, or the minimisers are written to one file
+        // per part, and each part is filled from its file. Then, only one part is in memory at a time.
+        if (!arguments.spill_parts && detail::parts_fit_in_memory(arguments, bits_per_part))
+        {
+            std::vector<raptor_index<>> indices = factory.construct_all_parts(bits_per_part);
+            for (size_t part = 0; part < arguments.parts; ++part)
+            {
+                store_part(std::move(indices[part]), part);
+                indices[part] = raptor_index<>{}; // Free memory.
+            }
+        }
+        else
+        {
+            partition_spill spill{arguments.out_path, arguments.parts};
+            factory.spill_all_parts(spill);
+
+            for (size_t part = 0; part < arguments.parts; ++part)
+                store_part(factory.construct_from_spill(spill, part, bits_per_part[part]), part);
         }
     }
 }
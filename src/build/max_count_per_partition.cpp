@@ -8,14 +8,22 @@
  */
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
 #include <fstream>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <unordered_map>
 
 #include <hibf/contrib/robin_hood.hpp>
 #include <hibf/sketch/hyperloglog.hpp>
 
 #include <raptor/build/max_count_per_partition.hpp>
+#include <raptor/build/sketch_cache.hpp>
 #include <raptor/call_parallel_on_bins.hpp>
 #include <raptor/file_reader.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -25,52 +33,103 @@ namespace detail
 
 template <file_types file_type>
 std::vector<size_t> max_count_per_partition(partition_config const & cfg,
+                                            size_t const max_partitions,
+                                            std::function<bool(std::vector<size_t> const &)> const & accept,
                                             std::vector<std::vector<std::string>> const & bin_path,
                                             uint8_t const threads,
                                             seqan3::shape const & shape,
-                                            uint32_t const window_size)
+                                            uint32_t const window_size,
+                                            sketch_kind const sketch_type,
+                                            sketch_cache const & cache)
 {
-    std::vector<size_t> kmers_per_partition(cfg.partitions);
-    std::vector<size_t> bin_per_partition(cfg.partitions);
+    assert(max_partitions % cfg.partitions == 0u);
+    assert(max_partitions == cfg.partitions || cfg.scheme == hash_partitioning::balanced);
+
+    // The sketches and the cached exact counts are those of the finest parts.
+    partition_config const finest{max_partitions, cfg.scheme};
+    // Level `l` has `cfg.partitions << l` parts.
+    size_t const levels = std::bit_width(max_partitions / cfg.partitions);
+    auto parts_of_level = [&cfg](size_t const level)
+    {
+        return cfg.partitions << level;
+    };
+
+    std::vector<std::vector<size_t>> kmers_per_partition(levels);
+    std::vector<std::vector<size_t>> bin_per_partition(levels);
+    for (size_t level = 0; level < levels; ++level)
+    {
+        kmers_per_partition[level].resize(parts_of_level(level));
+        bin_per_partition[level].resize(parts_of_level(level));
+    }
     std::mutex callback_mutex{};
-    file_reader<file_type> const reader{shape, window_size};
+    file_reader<file_type> const reader{shape, window_size, sketch_type};
 
-    auto callback = [&](std::vector<size_t> const & kmer_counts, std::vector<size_t> const & bin_ids)
+    auto callback = [&](std::vector<std::vector<size_t>> const & kmer_counts,
+                        std::vector<std::vector<size_t>> const & bin_ids)
     {
         std::lock_guard<std::mutex> guard{callback_mutex};
-        for (size_t i = 0; i < cfg.partitions; ++i)
+        for (size_t level = 0; level < levels; ++level)
         {
-            if (kmer_counts[i] > kmers_per_partition[i])
+            for (size_t i = 0; i < parts_of_level(level); ++i)
             {
-                kmers_per_partition[i] = kmer_counts[i];
-                bin_per_partition[i] = bin_ids[i];
+                if (kmer_counts[level][i] > kmers_per_partition[level][i])
+                {
+                    kmers_per_partition[level][i] = kmer_counts[level][i];
+                    bin_per_partition[level][i] = bin_ids[level][i];
+                }
             }
         }
     };
 
-    auto worker = [&callback, &reader, &cfg](auto && zipped_view)
+    auto worker = [&](auto && zipped_view)
     {
-        std::vector<size_t> max_kmer_counts(cfg.partitions);
-        std::vector<size_t> max_bin_ids(cfg.partitions);
-        std::vector<seqan::hibf::sketch::hyperloglog> sketches(cfg.partitions, 15u);
+        std::vector<std::vector<size_t>> max_kmer_counts{kmers_per_partition};
+        std::vector<std::vector<size_t>> max_bin_ids{bin_per_partition};
+        std::vector<seqan::hibf::sketch::hyperloglog> sketches(finest.partitions, sketch_cache::sketch_bits);
+        std::vector<size_t> estimates(finest.partitions);
+
+        auto update_max = [&](std::vector<seqan::hibf::sketch::hyperloglog> const & bin_sketches,
+                              size_t const bin_number)
+        {
+            for (size_t j = 0; j < finest.partitions; ++j)
+                estimates[j] = bin_sketches[j].estimate();
+
+            // The parts are disjoint. Hence, the k-mers of a part are the sum of the k-mers of its finest parts.
+            for (size_t level = 0; level < levels; ++level)
+            {
+                size_t const group = finest.partitions / parts_of_level(level);
+                for (size_t i = 0; i < parts_of_level(level); ++i)
+                {
+                    size_t const estimate =
+                        std::reduce(estimates.begin() + i * group, estimates.begin() + (i + 1u) * group);
+                    if (estimate > max_kmer_counts[level][i])
+                    {
+                        max_kmer_counts[level][i] = estimate;
+                        max_bin_ids[level][i] = bin_number;
+                    }
+                }
+            }
+        };
 
         for (auto && [file_names, bin_number] : zipped_view)
         {
+            if (std::optional<sketch_cache::entry> const cached = cache.load(file_names))
+            {
+                update_max(cached->sketches, bin_number);
+                continue;
+            }
+
             reader.for_each_hash(file_names,
                                  [&](auto && hash)
                                  {
-                                     sketches[cfg.hash_partition(hash)].add(hash);
+                                     sketches[finest.hash_partition(hash)].add(hash);
                                  });
-            for (size_t i = 0; i < cfg.partitions; ++i)
-            {
-                size_t const estimate = sketches[i].estimate();
-                if (estimate > max_kmer_counts[i])
-                {
-                    max_kmer_counts[i] = estimate;
-                    max_bin_ids[i] = bin_number;
-                }
-                sketches[i].reset();
-            }
+            update_max(sketches, bin_number);
+            cache.store(file_names,
+                        {.sketches = sketches,
+                         .exact_counts = std::vector<uint64_t>(finest.partitions, sketch_cache::unknown_count)});
+            for (seqan::hibf::sketch::hyperloglog & sketch : sketches)
+                sketch.reset();
         }
         callback(max_kmer_counts, max_bin_ids);
     };
@@ -79,42 +138,126 @@ std::vector<size_t> max_count_per_partition(partition_config const & cfg,
     call_parallel_on_bins(worker, bin_path, threads);
 
     // Get exact count for biggest bin. Sketch estimate's accuracy depends on sketch_bits (here: 15).
-    robin_hood::unordered_flat_set<uint64_t> kmers{};
+    auto exact_counts = [&](size_t const level)
+    {
+        size_t const parts = parts_of_level(level);
+        size_t const group = finest.partitions / parts;
+        partition_config const level_cfg{parts, cfg.scheme};
+        std::vector<size_t> const & bin_ids = bin_per_partition[level];
+
+        std::vector<size_t> counts(parts);
+        std::vector<std::optional<sketch_cache::entry>> cached(parts);
+        for (size_t i = 0; i < parts; ++i)
+            cached[i] = cache.load(bin_path[bin_ids[i]]);
+
+        robin_hood::unordered_flat_set<uint64_t> kmers{};
 #pragma omp parallel for schedule(dynamic) num_threads(threads) private(kmers)
-    for (size_t i = 0; i < cfg.partitions; ++i)
+        for (size_t i = 0; i < parts; ++i)
+        {
+            std::span<uint64_t> const finest_counts =
+                cached[i] ? std::span{cached[i]->exact_counts}.subspan(i * group, group) : std::span<uint64_t>{};
+
+            if (cached[i] && std::ranges::find(finest_counts, sketch_cache::unknown_count) == finest_counts.end())
+            {
+                counts[i] = std::reduce(finest_counts.begin(), finest_counts.end(), size_t{});
+                continue;
+            }
+
+            kmers.clear();
+            auto insert_it = std::inserter(kmers, kmers.end());
+            reader.hash_into_if(bin_path[bin_ids[i]],
+                                insert_it,
+                                [&](uint64_t const hash)
+                                {
+                                    return level_cfg.hash_partition(hash) == i;
+                                });
+            counts[i] = kmers.size();
+
+            // The counts of the finest parts can be reused for any number of parts.
+            if (cached[i])
+            {
+                std::ranges::fill(finest_counts, 0u);
+                for (uint64_t const hash : kmers)
+                    ++finest_counts[finest.hash_partition(hash) - i * group];
+            }
+        }
+
+        // A user bin may be the biggest bin of multiple partitions. Each cache entry is stored once.
+        std::unordered_map<size_t, sketch_cache::entry> updated_entries{};
+        for (size_t i = 0; i < parts; ++i)
+        {
+            if (!cached[i])
+                continue;
+
+            sketch_cache::entry & entry = updated_entries.try_emplace(bin_ids[i], *cached[i]).first->second;
+            std::ranges::copy_n(cached[i]->exact_counts.begin() + i * group,
+                                group,
+                                entry.exact_counts.begin() + i * group);
+        }
+        for (auto const & [bin_id, entry] : updated_entries)
+            cache.store(bin_path[bin_id], entry);
+
+        return counts;
+    };
+
+    std::vector<size_t> counts{};
+    for (size_t level = 0; level < levels; ++level)
     {
-        kmers.clear();
-        auto insert_it = std::inserter(kmers, kmers.end());
-        reader.hash_into_if(bin_path[bin_per_partition[i]],
-                            insert_it,
-                            [&](uint64_t const hash)
-                            {
-                                return cfg.hash_partition(hash) == i;
-                            });
-        kmers_per_partition[i] = kmers.size();
+        counts = exact_counts(level);
+        if (accept(counts))
+            break;
     }
 
-    return kmers_per_partition;
+    return counts;
 }
 
 } // namespace detail
 
 std::vector<size_t> max_count_per_partition(partition_config const & cfg, build_arguments const & arguments)
+{
+    return max_count_per_partition(cfg,
+                                   cfg.partitions,
+                                   arguments,
+                                   [](std::vector<size_t> const &)
+                                   {
+                                       return true;
+                                   });
+}
+
+std::vector<size_t> max_count_per_partition(partition_config const & cfg,
+                                            size_t const max_partitions,
+                                            build_arguments const & arguments,
+                                            std::function<bool(std::vector<size_t> const &)> const & accept)
 {
     arguments.bin_size_timer.start();
+    trace_scope bin_size_trace{"Determine IBF size", "build"};
+    sketch_cache const cache{arguments.sketch_cache_dir,
+                             arguments.shape,
+                             arguments.window_size,
+                             partition_config{max_partitions, cfg.scheme},
+                             arguments.sketch};
     // GCOVR_EXCL_START
     std::vector<size_t> result = arguments.input_is_minimiser
                                    ? detail::max_count_per_partition<file_types::minimiser>(cfg,
+                                                                                            max_partitions,
+                                                                                            accept,
                                                                                             arguments.bin_path,
                                                                                             arguments.threads,
                                                                                             arguments.shape,
-                                                                                            arguments.window_size)
+                                                                                            arguments.window_size,
+                                                                                            arguments.sketch,
+                                                                                            cache)
                                    : detail::max_count_per_partition<file_types::sequence>(cfg,
+                                                                                           max_partitions,
+                                                                                           accept,
                                                                                            arguments.bin_path,
                                                                                            arguments.threads,
                                                                                            arguments.shape,
-                                                                                           arguments.window_size);
+                                                                                           arguments.window_size,
+                                                                                           arguments.sketch,
+                                                                                           cache);
     // GCOVR_EXCL_STOP
+    bin_size_trace.stop();
     arguments.bin_size_timer.stop();
 
     return result;
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::partition_spill.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <cassert>
+#include <stdexcept>
+#include <system_error>
+
+#include <raptor/build/partition_spill.hpp>
+
+namespace raptor
+{
+
+partition_spill::partition_spill(std::filesystem::path const & prefix, size_t const parts) : files(parts)
+{
+    for (size_t part = 0; part < parts; ++part)
+    {
+        spill_file & file = files[part];
+        file.path = prefix;
+        file.path += "_" + std::to_string(part) + ".spill";
+        file.stream.open(file.path, std::ios::binary);
+        if (!file.stream.is_open())
+            throw std::system_error{errno, std::generic_category(), "Failed to create " + file.path.string()};
+    }
+}
+
+partition_spill::~partition_spill()
+{
+    for (spill_file & file : files)
+    {
+        file.stream.close();
+        std::error_code ec{};
+        std::filesystem::remove(file.path, ec);
+    }
+}
+
+void partition_spill::write(size_t const part, uint64_t const bin, std::span<uint64_t const> const hashes)
+{
+    assert(part < files.size());
+    assert(hashes.size() <= block_size);
+
+    if (hashes.empty())
+        return;
+
+    spill_file & file = files[part];
+    uint64_t const count = hashes.size();
+
+    std::lock_guard<std::mutex> lock{file.mutex};
+    file.block_offsets.push_back(file.size);
+    file.stream.write(reinterpret_cast<char const *>(&bin), sizeof(bin));
+    file.stream.write(reinterpret_cast<char const *>(&count), sizeof(count));
+    file.stream.write(reinterpret_cast<char const *>(hashes.data()), hashes.size_bytes());
+    file.size += sizeof(bin) + sizeof(count) + hashes.size_bytes();
+}
+
+void partition_spill::finish()
+{
+    for (spill_file & file : files)
+    {
+        file.stream.close();
+        if (file.stream.fail())
+            throw std::system_error{errno, std::generic_category(), "Failed to write " + file.path.string()};
+    }
+}
+
+uint64_t partition_spill::read_block(spill_file const & file,
+                                     std::ifstream & stream,
+                                     uint64_t const offset,
+                                     std::vector<uint64_t> & hashes)
+{
+    uint64_t bin{};
+    uint64_t count{};
+    stream.seekg(offset);
+    stream.read(reinterpret_cast<char *>(&bin), sizeof(bin));
+    stream.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!stream.good() || count == 0u || count > block_size)
+        throw std::runtime_error{"Failed to read " + file.path.string() + ": Invalid block at offset "
+                                 + std::to_string(offset) + "."};
+
+    hashes.resize(count);
+    stream.read(reinterpret_cast<char *>(hashes.data()), count * sizeof(uint64_t));
+    if (!stream.good())
+        throw std::runtime_error{"Failed to read " + file.path.string() + ": Truncated block at offset "
+                                 + std::to_string(offset) + "."};
+    return bin;
+}
+
+} // namespace raptor
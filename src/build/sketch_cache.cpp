@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::sketch_cache.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+#include <raptor/build/sketch_cache.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+// Increase if the file format changes.
+constexpr std::string_view sketch_cache_magic{"RAPTOR_SKETCH_CACHE_1\n"};
+
+// FNV-1a. Unlike std::hash, the result does not depend on the standard library.
+uint64_t fnv1a_hash(std::string_view const value)
+{
+    uint64_t hash{14695981039346656037ULL};
+    for (char const character : value)
+    {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void write_uint64(std::ostream & stream, uint64_t const value)
+{
+    stream.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+bool read_uint64(std::istream & stream, uint64_t & value)
+{
+    return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+} // namespace detail
+
+sketch_cache::sketch_cache(std::filesystem::path directory,
+                           seqan3::shape const & shape,
+                           uint32_t const window_size,
+                           partition_config const & partitioning,
+                           sketch_kind const sketch) :
+    directory{std::move(directory)},
+    parameters{shape.to_string() + '\t' + std::to_string(window_size) + '\t' + std::to_string(sketch_bits) + '\t'
+               + std::to_string(partitioning.partitions)},
+    partitions{partitioning.partitions}
+{
+    // Minimisers are not marked, so entries of previous versions remain valid.
+    if (sketch == sketch_kind::syncmer)
+        parameters += "\tsyncmer";
+    // Entries of previous versions with multiple partitions used raptor::hash_partitioning::suffix, which is not
+    // marked either. With a single partition, the partitioning does not change the counts.
+    if (partitions > 1u && partitioning.scheme != hash_partitioning::suffix)
+    {
+        for (auto const & [name, scheme] : enumeration_names(partitioning.scheme))
+            if (scheme == partitioning.scheme)
+                parameters += '\t' + std::string{name};
+    }
+
+    if (is_enabled())
+        std::filesystem::create_directories(this->directory);
+}
+
+std::string sketch_cache::key(std::vector<std::string> const & user_bin) const
+{
+    std::string result{parameters};
+    for (std::string const & file_name : user_bin)
+    {
+        std::filesystem::path const path = std::filesystem::absolute(file_name);
+        result += '\t';
+        result += path.string();
+        result += '\t';
+        result += std::to_string(std::filesystem::last_write_time(path).time_since_epoch().count());
+        result += '\t';
+        result += std::to_string(std::filesystem::file_size(path));
+    }
+    return result;
+}
+
+std::filesystem::path sketch_cache::file_path(std::string const & key) const
+{
+    std::array<char, 16> buffer{};
+    uint64_t const hash = detail::fnv1a_hash(key);
+    char * const end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), hash, 16).ptr;
+    std::string file_name(16u - (end - buffer.data()), '0');
+    file_name.append(buffer.data(), end);
+    return directory / (file_name + ".hll");
+}
+
+std::optional<sketch_cache::entry> sketch_cache::load(std::vector<std::string> const & user_bin) const
+{
+    if (!is_enabled())
+        return std::nullopt;
+
+    std::string const expected_key = key(user_bin);
+    std::ifstream stream{file_path(expected_key), std::ios::binary};
+    if (!stream.good())
+        return std::nullopt;
+
+    std::string magic(detail::sketch_cache_magic.size(), '\0');
+    if (!stream.read(magic.data(), magic.size()) || magic != detail::sketch_cache_magic)
+        return std::nullopt;
+
+    // The key is stored to detect hash collisions.
+    uint64_t key_size{};
+    if (!detail::read_uint64(stream, key_size) || key_size != expected_key.size())
+        return std::nullopt;
+    std::string stored_key(key_size, '\0');
+    if (!stream.read(stored_key.data(), key_size) || stored_key != expected_key)
+        return std::nullopt;
+
+    entry result{.sketches = std::vector<seqan::hibf::sketch::hyperloglog>(partitions),
+                 .exact_counts = std::vector<uint64_t>(partitions)};
+    try
+    {
+        for (seqan::hibf::sketch::hyperloglog & sketch : result.sketches)
+            sketch.load(stream);
+    }
+    catch (std::exception const &)
+    {
+        return std::nullopt;
+    }
+
+    for (uint64_t & count : result.exact_counts)
+        if (!detail::read_uint64(stream, count))
+            return std::nullopt;
+
+    return result;
+}
+
+void sketch_cache::store(std::vector<std::string> const & user_bin, entry const & value) const
+{
+    if (!is_enabled())
+        return;
+
+    assert(value.sketches.size() == partitions);
+    assert(value.exact_counts.size() == partitions);
+
+    std::string const entry_key = key(user_bin);
+    std::filesystem::path const path = file_path(entry_key);
+
+    // Write to a temporary file and rename it. A concurrent or interrupted run never sees a partial entry.
+    // The suffix is unique per process and thread, since multiple runs may share the cache.
+    std::filesystem::path temporary_path{path};
+    temporary_path += '.' + std::to_string(getpid()) + '.'
+                    + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream stream{temporary_path, std::ios::binary};
+        stream.write(detail::sketch_cache_magic.data(), detail::sketch_cache_magic.size());
+        detail::write_uint64(stream, entry_key.size());
+        stream.write(entry_key.data(), entry_key.size());
+        for (seqan::hibf::sketch::hyperloglog const & sketch : value.sketches)
+            sketch.store(stream);
+        for (uint64_t const count : value.exact_counts)
+            detail::write_uint64(stream, count);
+
+        if (!stream.good())
+        {
+            // GCOVR_EXCL_START
+            stream.close();
+            std::filesystem::remove(temporary_path);
+            return;
+            // GCOVR_EXCL_STOP
+        }
+    }
+
+    std::filesystem::rename(temporary_path, path);
+}
+
+} // namespace raptor
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::raptor_merge.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/merge/merge.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+// The number of bytes of all indices that are read at once. At least 1 MiB of each index is read at once.
+static constexpr size_t buffer_bytes{1ULL << 28};
+
+/* All sections of the indices but the bit vector of the IBF must be equal: the parameters, the user bins, and the
+ * dimensions of the IBF. The bit vectors are combined with a bitwise OR, one block per thread at a time.
+ * The metadata differs in the number of set bits, which is counted while merging.
+ */
+void merge_files(std::vector<std::filesystem::path> const & input_files,
+                 std::filesystem::path const & output_file,
+                 uint8_t const threads)
+{
+    size_t const number_of_inputs = input_files.size();
+    std::vector<std::unique_ptr<index_file>> files{};
+    std::vector<index_section> sections{};
+    std::string header{};
+    std::optional<index_metadata> metadata{};
+
+    for (size_t i = 0; i < number_of_inputs; ++i)
+    {
+        if (!is_index_container(input_files[i]))
+            throw sharg::parser_error{"The index " + input_files[i].string()
+                                      + " was built by a previous version of Raptor. Please rebuild it."};
+
+        raptor_index<> parameters{};
+        read_index_parameters(parameters, input_files[i]);
+        if (parameters.is_hibf() || parameters.is_blocked_ibf())
+            throw sharg::parser_error{"Only IBF indices can be merged."};
+
+        index_file const & file = *files.emplace_back(std::make_unique<index_file>(input_files[i], O_RDONLY));
+        if (read_compression(file) != index_compression::none)
+            throw sharg::parser_error{"The index " + input_files[i].string()
+                                      + " is compressed. Compressed indices cannot be merged."};
+
+        std::vector<index_section> input_sections = read_section_table(file);
+        if (input_sections.size() != 2u)
+            throw sharg::parser_error{"Cannot read index: " + input_files[i].string()}; // GCOVR_EXCL_LINE
+
+        // Everything before the bit vector: the section table, the metadata, and the index without the bit vector.
+        std::string input_header(input_sections[1].offset, '\0');
+        file.read_at(input_header.data(), input_header.size(), 0u);
+        std::string_view const input_shell = std::string_view{input_header}.substr(input_sections[0].offset);
+
+        if (i == 0u)
+        {
+            metadata = read_metadata(file, input_sections);
+            header = std::move(input_header);
+            sections = std::move(input_sections);
+        }
+        else if (input_shell != std::string_view{header}.substr(sections[0].offset) || input_sections != sections)
+        {
+            throw sharg::parser_error{"The indices " + input_files[0].string() + " and " + input_files[i].string()
+                                      + " differ in more than the inserted user bins. All indices must be built from "
+                                        "the same input with the same options."};
+        }
+    }
+
+    index_file const output{output_file, O_WRONLY | O_CREAT | O_TRUNC};
+    index_section const & data = sections[1];
+    output.resize(data.offset + data.size);
+    output.write_at(header.data(), header.size(), 0u);
+
+    size_t const block_bytes =
+        std::max<size_t>(1ULL << 20, buffer_bytes / (number_of_inputs * threads)) / 64u * 64u;
+    size_t const number_of_blocks = (data.size + block_bytes - 1u) / block_bytes;
+    std::atomic<uint64_t> set_bits{};
+    parallel_for_each_section(number_of_blocks,
+                              threads,
+                              [&](size_t const block)
+                              {
+                                  size_t const bytes = std::min<uint64_t>(block_bytes, data.size - block * block_bytes);
+                                  uint64_t const offset = data.offset + block * block_bytes;
+                                  size_t const words = bytes / sizeof(uint64_t);
+                                  std::vector<uint64_t> merged(words);
+                                  std::vector<uint64_t> input(words);
+
+                                  files[0]->read_at(merged.data(), bytes, offset);
+                                  for (size_t i = 1; i < number_of_inputs; ++i)
+                                  {
+                                      files[i]->read_at(input.data(), bytes, offset);
+                                      for (size_t word = 0; word < words; ++word)
+                                          merged[word] |= input[word];
+                                  }
+                                  output.write_at(merged.data(), bytes, offset);
+
+                                  uint64_t count{};
+                                  for (uint64_t const word : merged)
+                                      count += std::popcount(word);
+                                  set_bits.fetch_add(count, std::memory_order_relaxed);
+                              });
+
+    if (metadata && metadata->ibfs.size() == 1u)
+    {
+        metadata->ibfs[0].set_bits = set_bits.load();
+        write_metadata(output, sections.size(), *metadata);
+    }
+}
+
+} // namespace detail
+
+void raptor_merge(merge_arguments const & arguments)
+{
+    arguments.merge_timer.start();
+    if (arguments.parts == 1u)
+    {
+        detail::merge_files(arguments.shard_files, arguments.out_path, arguments.threads);
+    }
+    else
+    {
+        auto with_suffix = [](std::filesystem::path path, size_t const part)
+        {
+            path += "_" + std::to_string(part);
+            return path;
+        };
+
+        for (size_t part = 0; part < arguments.parts; ++part)
+        {
+            std::vector<std::filesystem::path> input_files{};
+            for (std::filesystem::path const & shard_file : arguments.shard_files)
+                input_files.push_back(with_suffix(shard_file, part));
+            detail::merge_files(input_files, with_suffix(arguments.out_path, part), arguments.threads);
+        }
+    }
+    arguments.merge_timer.stop();
+}
+
+} // namespace raptor
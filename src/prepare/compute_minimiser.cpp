@@ -7,21 +7,23 @@
  * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
  */
 
+#include <condition_variable>
+#include <mutex>
 #include <omp.h>
 
 #include <seqan3/io/sequence_file/input.hpp>
 #include <seqan3/search/views/minimiser_hash.hpp>
 
 #include <hibf/contrib/robin_hood.hpp>
-#include <hibf/contrib/std/chunk_view.hpp>
-#include <hibf/contrib/std/zip_view.hpp>
-#include <hibf/misc/divide_and_ceil.hpp>
 
 #include <raptor/adjust_seed.hpp>
 #include <raptor/dna4_traits.hpp>
 #include <raptor/file_reader.hpp>
+#include <raptor/minimiser_file.hpp>
 #include <raptor/prepare/compute_minimiser.hpp>
 #include <raptor/prepare/cutoff.hpp>
+#include <raptor/prepare/minimiser_counter.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -49,19 +51,125 @@ void write_list_file(prepare_arguments const & arguments)
     }
 }
 
+namespace detail
+{
+
+struct bin_workload
+{
+    size_t bin_number{};
+    uint64_t size{};   // The size of the files in bytes.
+    uint64_t memory{}; // The estimated memory needed for counting.
+};
+
+// Returns the workloads of all user bins, the largest bin first.
+std::vector<bin_workload> bins_by_size(prepare_arguments const & arguments, uint64_t const counting_memory_per_thread)
+{
+    // A random sequence has about 2 / (w - k + 2) minimisers per base. Each distinct minimiser needs about 24 bytes in
+    // the hash table. This is an upper bound: it assumes that all minimisers are distinct.
+    uint64_t const window_span = arguments.window_size - arguments.shape.size() + 2u;
+    std::vector<bin_workload> result(arguments.bin_path.size());
+
+    for (size_t bin_number = 0; bin_number < arguments.bin_path.size(); ++bin_number)
+    {
+        bin_workload & workload = result[bin_number];
+        workload.bin_number = bin_number;
+        uint64_t bases{};
+        for (std::string const & file_name : arguments.bin_path[bin_number])
+        {
+            // A missing file is reported when it is read.
+            std::error_code ec{};
+            uint64_t const size = std::filesystem::file_size(file_name, ec);
+            if (ec)
+                continue;
+            workload.size += size;
+            // Assumes a compression ratio of 4.
+            bases += cutoff::file_is_compressed(file_name) ? 4u * size : size;
+        }
+
+        workload.memory = 2u * bases / window_span * 24u;
+        if (counting_memory_per_thread > 0u)
+            workload.memory = std::min(workload.memory, counting_memory_per_thread);
+    }
+
+    std::ranges::stable_sort(result,
+                             [](bin_workload const & lhs, bin_workload const & rhs)
+                             {
+                                 return lhs.size > rhs.size;
+                             });
+    return result;
+}
+
+// Limits the estimated memory of the bins that are processed at the same time.
+// A bin that exceeds the limit on its own is processed when no other bin is processed. A limit of 0 means no limit.
+class memory_gate
+{
+public:
+    explicit memory_gate(uint64_t const limit_) : limit{limit_}
+    {}
+
+    void acquire(uint64_t const memory)
+    {
+        if (limit == 0u)
+            return;
+
+        std::unique_lock<std::mutex> lock{mutex};
+        available.wait(lock,
+                       [&]()
+                       {
+                           return in_use == 0u || in_use + memory <= limit;
+                       });
+        in_use += memory;
+    }
+
+    void release(uint64_t const memory)
+    {
+        if (limit == 0u)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            in_use -= memory;
+        }
+        available.notify_all();
+    }
+
+private:
+    uint64_t const limit{};
+    uint64_t in_use{};
+    std::mutex mutex{};
+    std::condition_variable available{};
+};
+
+} // namespace detail
+
 void compute_minimiser(prepare_arguments const & arguments)
 {
-    file_reader<file_types::sequence> const reader{arguments.shape, arguments.window_size};
+    file_reader<file_types::sequence> const reader{arguments.shape, arguments.window_size, arguments.sketch};
     raptor::cutoff const cutoffs{arguments};
+    // The limit is shared by all threads.
+    uint64_t const counting_memory_per_thread = (arguments.counting_memory << 20) / arguments.threads;
+
+    std::vector<detail::bin_workload> const workloads = detail::bins_by_size(arguments, counting_memory_per_thread);
+    detail::memory_gate gate{arguments.memory_limit << 20};
 
-    auto worker = [&](auto && zipped_view)
+    trace_scope compute_minimiser_trace{"Compute minimiser", "prepare"};
+    // The largest bins are processed first, one bin at a time. This way, a thread that gets a large bin does not
+    // have to process a static share of other bins afterwards.
+#pragma omp parallel num_threads(arguments.threads)
     {
         seqan::hibf::serial_timer local_compute_minimiser_timer{};
         seqan::hibf::serial_timer local_write_minimiser_timer{};
         seqan::hibf::serial_timer local_write_header_timer{};
+        perf_counter_group const counter_group{arguments.perf_counters};
+        serial_perf_counters local_compute_minimiser_counters{counter_group};
+        serial_perf_counters local_write_minimiser_counters{counter_group};
 
-        for (auto && [file_names, bin_number] : zipped_view)
+#pragma omp for schedule(dynamic, 1)
+        for (size_t i = 0; i < workloads.size(); ++i)
         {
+            size_t const bin_number = workloads[i].bin_number;
+            std::vector<std::string> const & file_names = arguments.bin_path[bin_number];
+            trace_scope const user_bin_trace{"User bin", "worker", "user_bin_id", bin_number};
             std::filesystem::path const file_name{file_names[0]};
             std::filesystem::path output_path = get_output_path(arguments.out_dir, file_name);
 
@@ -81,38 +189,76 @@ void compute_minimiser(prepare_arguments const & arguments)
             else
                 std::ofstream outfile{progress_file, std::ios::binary};
 
-            // The hash table stores how often a minimiser appears. It does not matter whether a minimiser appears
-            // 50 times or 2000 times, it is stored regardless because the biggest cutoff value is 50. Hence,
-            // the hash table stores only values up to 254 to save memory.
-            robin_hood::unordered_map<uint64_t, uint8_t> minimiser_table{};
-            // The map is (re-)constructed for each file. The alternative is to construct it once for each thread
-            // and clear+reuse it for every file that a thread works on. However, this dramatically increases
-            // memory consumption because the map will stay as big as needed for the biggest encountered file.
-
-            local_compute_minimiser_timer.start();
-            reader.for_each_hash(file_names,
-                                 [&](auto && hash)
-                                 {
-                                     minimiser_table[hash] = std::min<uint8_t>(254u, minimiser_table[hash] + 1);
-                                 });
-            local_compute_minimiser_timer.stop();
+            gate.acquire(workloads[i].memory);
 
             uint8_t const cutoff = cutoffs.get(file_name);
+            minimiser_file_header const header{.shape = arguments.shape.to_ulong(),
+                                               .window_size = arguments.window_size,
+                                               .cutoff = cutoff,
+                                               .sketch = arguments.sketch};
             uint64_t count{};
 
-            local_write_minimiser_timer.start();
+            if (counting_memory_per_thread > 0u)
+            {
+                minimiser_counter counter{std::filesystem::path{output_path}.replace_extension("run"),
+                                          counting_memory_per_thread};
+
+                local_compute_minimiser_timer.start();
+                local_compute_minimiser_counters.start();
+                reader.for_each_hash(file_names,
+                                     [&](auto && hash)
+                                     {
+                                         counter.add(hash);
+                                     });
+                local_compute_minimiser_counters.stop();
+                local_compute_minimiser_timer.stop();
+
+                local_write_minimiser_timer.start();
+                local_write_minimiser_counters.start();
+                minimiser_file_output output{minimiser_file, header};
+                counter.for_each(cutoff,
+                                 [&](uint64_t const minimiser)
+                                 {
+                                     output.push_back(minimiser);
+                                     ++count;
+                                 });
+                output.close();
+                local_write_minimiser_counters.stop();
+                local_write_minimiser_timer.stop();
+            }
+            else
             {
-                std::ofstream outfile{minimiser_file, std::ios::binary};
+                // The hash table stores how often a minimiser appears. It does not matter whether a minimiser appears
+                // 50 times or 2000 times, it is stored regardless because the biggest cutoff value is 50. Hence,
+                // the hash table stores only values up to 254 to save memory.
+                robin_hood::unordered_map<uint64_t, uint8_t> minimiser_table{};
+                // The map is (re-)constructed for each file. The alternative is to construct it once for each thread
+                // and clear+reuse it for every file that a thread works on. However, this dramatically increases
+                // memory consumption because the map will stay as big as needed for the biggest encountered file.
+
+                local_compute_minimiser_timer.start();
+                local_compute_minimiser_counters.start();
+                reader.for_each_hash(file_names,
+                                     [&](auto && hash)
+                                     {
+                                         minimiser_table[hash] = std::min<uint8_t>(254u, minimiser_table[hash] + 1);
+                                     });
+                local_compute_minimiser_counters.stop();
+                local_compute_minimiser_timer.stop();
+
+                local_write_minimiser_timer.start();
+                local_write_minimiser_counters.start();
+                std::vector<uint64_t> minimisers{};
                 for (auto && [hash, occurrences] : minimiser_table)
-                {
                     if (occurrences >= cutoff)
-                    {
-                        outfile.write(reinterpret_cast<char const *>(&hash), sizeof(hash));
-                        ++count;
-                    }
-                }
+                        minimisers.push_back(hash);
+                minimiser_table = {}; // Free memory.
+                std::ranges::sort(minimisers);
+                write_minimiser_file(minimiser_file, minimisers, header);
+                count = minimisers.size();
+                local_write_minimiser_counters.stop();
+                local_write_minimiser_timer.stop();
             }
-            local_write_minimiser_timer.stop();
 
             local_write_header_timer.start();
             {
@@ -123,25 +269,18 @@ void compute_minimiser(prepare_arguments const & arguments)
             local_write_header_timer.stop();
 
             std::filesystem::remove(progress_file);
+            gate.release(workloads[i].memory);
         }
 
         arguments.compute_minimiser_timer += local_compute_minimiser_timer;
         arguments.write_minimiser_timer += local_write_minimiser_timer;
         arguments.write_header_timer += local_write_header_timer;
-    };
-
-    size_t const number_of_bins = arguments.bin_path.size();
-    size_t const chunk_size = seqan::hibf::divide_and_ceil(number_of_bins, arguments.threads);
-    auto chunked_view = seqan::stl::views::zip(arguments.bin_path, std::views::iota(0u, number_of_bins))
-                      | seqan::stl::views::chunk(chunk_size);
-    size_t const number_of_chunks = std::ranges::size(chunked_view);
-
-#pragma omp parallel for schedule(dynamic) num_threads(arguments.threads)
-    for (size_t i = 0; i < number_of_chunks; ++i)
-    {
-        std::invoke(worker, chunked_view[i]);
+        arguments.compute_minimiser_counters += local_compute_minimiser_counters;
+        arguments.write_minimiser_counters += local_write_minimiser_counters;
     }
+    compute_minimiser_trace.stop();
 
+    trace_scope const list_file_trace{"Write list file", "prepare"};
     write_list_file(arguments);
 }
 
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::minimiser_counter.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include <raptor/prepare/minimiser_counter.hpp>
+
+namespace raptor
+{
+
+// Maximum number of entries that are written or read at once.
+static constexpr size_t entries_per_chunk{1ULL << 13};
+
+minimiser_counter::minimiser_counter(std::filesystem::path run_prefix,
+                                     uint64_t const memory,
+                                     size_t const max_fan_in) :
+    run_prefix{std::move(run_prefix)},
+    capacity{std::max<size_t>(1u, memory / sizeof(uint64_t))},
+    max_fan_in{std::max<size_t>(2u, max_fan_in)},
+    // While merging, the chunks of `max_fan_in` readers and one writer share the memory of the buffer.
+    chunk_entries{std::clamp<size_t>(memory / ((this->max_fan_in + 1u) * entry_size), 1u, entries_per_chunk)}
+{
+    // Only touched pages are backed by physical memory.
+    buffer.reserve(capacity);
+}
+
+minimiser_counter::~minimiser_counter()
+{
+    for (std::filesystem::path const & path : run_paths)
+    {
+        std::error_code ec{};
+        std::filesystem::remove(path, ec);
+    }
+}
+
+std::filesystem::path const & minimiser_counter::new_run()
+{
+    std::filesystem::path & path = run_paths.emplace_back(run_prefix);
+    path += "_" + std::to_string(next_run++);
+    return path;
+}
+
+void minimiser_counter::spill()
+{
+    if (buffer.empty())
+        return;
+
+    std::ranges::sort(buffer);
+
+    run_writer writer{};
+    writer.open(new_run(), chunk_entries);
+    ++spilled_runs;
+
+    for (auto it = buffer.begin(); it != buffer.end();)
+    {
+        uint64_t const minimiser = *it;
+        uint8_t occurrences{};
+        for (; it != buffer.end() && *it == minimiser; ++it)
+            occurrences = std::min<uint8_t>(254u, occurrences + 1);
+
+        writer.push_back(minimiser, occurrences);
+    }
+
+    writer.close();
+    buffer.clear();
+}
+
+void minimiser_counter::merge_runs()
+{
+    assert(run_paths.size() > max_fan_in);
+
+    // Runs are merged in the order they were written, hence each minimiser is rewritten about log(runs) times.
+    std::vector<std::filesystem::path> const runs(run_paths.begin(), run_paths.begin() + max_fan_in);
+    run_paths.erase(run_paths.begin(), run_paths.begin() + max_fan_in);
+
+    run_writer writer{};
+    writer.open(new_run(), chunk_entries);
+    merge(runs,
+          [&writer](uint64_t const minimiser, uint8_t const occurrences)
+          {
+              writer.push_back(minimiser, occurrences);
+          });
+    writer.close();
+
+    for (std::filesystem::path const & path : runs)
+    {
+        std::error_code ec{};
+        std::filesystem::remove(path, ec);
+    }
+}
+
+void minimiser_counter::run_reader::open(std::filesystem::path const & path, size_t const chunk_entries)
+{
+    stream.open(path, std::ios::binary);
+    if (!stream.is_open())
+        throw std::system_error{errno, std::generic_category(), "Failed to open " + path.string()}; // GCOVR_EXCL_LINE
+    chunk.resize(chunk_entries * entry_size);
+}
+
+bool minimiser_counter::run_reader::next()
+{
+    if (position == end)
+    {
+        stream.read(chunk.data(), chunk.size());
+        end = stream.gcount();
+        position = 0u;
+        if (end == 0u)
+            return false;
+    }
+
+    std::memcpy(&minimiser, chunk.data() + position, sizeof(minimiser));
+    occurrences = static_cast<uint8_t>(chunk[position + sizeof(minimiser)]);
+    position += entry_size;
+    return true;
+}
+
+void minimiser_counter::run_writer::open(std::filesystem::path const & path, size_t const chunk_entries)
+{
+    this->path = path;
+    stream.open(path, std::ios::binary);
+    if (!stream.is_open())
+        throw std::system_error{errno, std::generic_category(), "Failed to create " + path.string()};
+    chunk_bytes = chunk_entries * entry_size;
+    chunk.reserve(chunk_bytes);
+}
+
+void minimiser_counter::run_writer::push_back(uint64_t const minimiser, uint8_t const occurrences)
+{
+    char bytes[entry_size];
+    std::memcpy(bytes, &minimiser, sizeof(minimiser));
+    bytes[sizeof(minimiser)] = static_cast<char>(occurrences);
+    chunk.insert(chunk.end(), bytes, bytes + entry_size);
+
+    if (chunk.size() == chunk_bytes)
+    {
+        stream.write(chunk.data(), chunk.size());
+        chunk.clear();
+    }
+}
+
+void minimiser_counter::run_writer::close()
+{
+    stream.write(chunk.data(), chunk.size());
+    chunk.clear();
+    stream.close();
+    if (stream.fail())
+        throw std::system_error{errno, std::generic_category(), "Failed to write " + path.string()}; // GCOVR_EXCL_LINE
+}
+
+} // namespace raptor
@@ -8,6 +8,8 @@
  */
 
 #include <raptor/argument_parsing/build_parsing.hpp>
+#include <raptor/argument_parsing/info_parsing.hpp>
+#include <raptor/argument_parsing/merge_parsing.hpp>
 #include <raptor/argument_parsing/prepare_parsing.hpp>
 #include <raptor/argument_parsing/search_parsing.hpp>
 #include <raptor/argument_parsing/update_parsing.hpp>
@@ -80,7 +82,7 @@ int main(int argc, char ** argv)
                                        argc,
                                        argv,
                                        sharg::update_notifications::on,
-                                       {"build", "layout", "prepare", "search", "update", "upgrade"}};
+                                       {"build", "info", "layout", "merge", "prepare", "search", "update", "upgrade"}};
         set_metadata(top_level_parser.info);
 
         top_level_parser.parse();
@@ -88,8 +90,12 @@ int main(int argc, char ** argv)
         sharg::parser & sub_parser = top_level_parser.get_sub_parser();
         if (sub_parser.info.app_name == std::string_view{"Raptor-build"})
             raptor::build_parsing(sub_parser);
+        if (sub_parser.info.app_name == std::string_view{"Raptor-info"})
+            raptor::info_parsing(sub_parser);
         if (sub_parser.info.app_name == std::string_view{"Raptor-layout"})
             raptor::chopper_layout(sub_parser);
+        if (sub_parser.info.app_name == std::string_view{"Raptor-merge"})
+            raptor::merge_parsing(sub_parser);
         if (sub_parser.info.app_name == std::string_view{"Raptor-prepare"})
             raptor::prepare_parsing(sub_parser);
         if (sub_parser.info.app_name == std::string_view{"Raptor-search"})
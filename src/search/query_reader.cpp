@@ -0,0 +1,876 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+/*!\file
+ * \brief Implements raptor::query_reader.
+ * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <omp.h>
+#include <random>
+#include <string_view>
+#include <thread>
+
+#if SEQAN3_HAS_ZLIB
+#    include <zlib.h>
+#endif
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/io/exception.hpp>
+#include <seqan3/io/sequence_file/format_fasta.hpp>
+#include <seqan3/io/sequence_file/format_fastq.hpp>
+
+#include <raptor/search/query_reader.hpp>
+
+namespace raptor
+{
+
+namespace detail
+{
+
+class byte_source
+{
+public:
+    virtual ~byte_source() = default;
+
+    //!\brief Appends the next block to `buffer`. Returns `false` if the file was completely read.
+    virtual bool append_to(std::string & buffer) = 0;
+};
+
+enum class compression_kind : uint8_t
+{
+    none,
+    gzip,
+    bgzf,
+    other
+};
+
+class plain_source final : public byte_source
+{
+public:
+    explicit plain_source(std::ifstream && stream) : stream{std::move(stream)}
+    {}
+
+    bool append_to(std::string & buffer) override
+    {
+        size_t const old_size = buffer.size();
+        buffer.resize(old_size + block_size);
+        stream.read(buffer.data() + old_size, block_size);
+        size_t const bytes_read = stream.gcount();
+        buffer.resize(old_size + bytes_read);
+        return bytes_read > 0u;
+    }
+
+private:
+    static constexpr size_t block_size{1ULL << 24};
+    std::ifstream stream;
+};
+
+#if SEQAN3_HAS_ZLIB
+/*!\brief Decompresses multiple BGZF blocks in parallel.
+ * \details
+ * Each BGZF block is a gzip member of at most 64 KiB that stores its compressed and decompressed size. Hence, the
+ * output position of each block is known before decompressing it.
+ */
+class bgzf_source final : public byte_source
+{
+public:
+    bgzf_source(std::ifstream && stream, uint8_t const threads) :
+        bgzf_source{std::move(stream), threads, blocks_per_thread * threads}
+    {}
+
+    bgzf_source(std::ifstream && stream, uint8_t const threads, size_t const max_blocks) :
+        stream{std::move(stream)},
+        max_blocks{max_blocks},
+        threads{threads}
+    {}
+
+    bool append_to(std::string & buffer) override
+    {
+        compressed.clear();
+        blocks.clear();
+
+        size_t uncompressed_size{};
+        while (blocks.size() < max_blocks && read_block())
+        {
+            blocks.back().output_offset = uncompressed_size;
+            uncompressed_size += blocks.back().uncompressed_size;
+        }
+
+        if (blocks.empty())
+            return false;
+
+        size_t const old_size = buffer.size();
+        buffer.resize(old_size + uncompressed_size);
+        std::atomic_bool failed{false};
+
+#    pragma omp parallel for schedule(dynamic) num_threads(threads)
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            if (!inflate_block(blocks[i], buffer.data() + old_size))
+                failed = true;
+        }
+
+        if (failed)
+            throw seqan3::io_error{"The BGZF file is corrupted."};
+
+        return true;
+    }
+
+private:
+    struct block
+    {
+        size_t data_offset{};
+        size_t data_size{};
+        size_t uncompressed_size{};
+        size_t output_offset{};
+    };
+
+    static constexpr size_t blocks_per_thread{64u};
+    std::ifstream stream;
+    std::vector<unsigned char> compressed{};
+    std::vector<block> blocks{};
+    size_t max_blocks{};
+    uint8_t threads{1u};
+
+    static size_t little_endian(unsigned char const * const data, size_t const bytes)
+    {
+        size_t result{};
+        for (size_t i = 0; i < bytes; ++i)
+            result |= static_cast<size_t>(data[i]) << (8u * i);
+        return result;
+    }
+
+    bool read_block()
+    {
+        std::array<unsigned char, 12> header{};
+        stream.read(reinterpret_cast<char *>(header.data()), header.size());
+        if (stream.gcount() == 0)
+            return false;
+
+        if (static_cast<size_t>(stream.gcount()) != header.size() || header[0] != 0x1f || header[1] != 0x8b
+            || !(header[3] & 0x04))
+            throw seqan3::io_error{"The BGZF file is corrupted."};
+
+        size_t const extra_length = little_endian(header.data() + 10u, 2u);
+        size_t const block_start = compressed.size();
+        compressed.resize(block_start + extra_length);
+        stream.read(reinterpret_cast<char *>(compressed.data() + block_start), extra_length);
+
+        // The BSIZE subfield stores the total block size minus 1.
+        size_t block_size{};
+        for (size_t position = 0; position + 4u <= extra_length;)
+        {
+            unsigned char const * const subfield = compressed.data() + block_start + position;
+            size_t const subfield_length = little_endian(subfield + 2u, 2u);
+            if (subfield[0] == 'B' && subfield[1] == 'C' && subfield_length == 2u)
+                block_size = little_endian(subfield + 4u, 2u) + 1u;
+            position += 4u + subfield_length;
+        }
+
+        if (block_size < header.size() + extra_length + 8u)
+            throw seqan3::io_error{"The BGZF file is corrupted."};
+
+        size_t const remaining = block_size - header.size() - extra_length;
+        compressed.resize(block_start + remaining);
+        stream.read(reinterpret_cast<char *>(compressed.data() + block_start), remaining);
+        if (static_cast<size_t>(stream.gcount()) != remaining)
+            throw seqan3::io_error{"The BGZF file is truncated."};
+
+        // The footer consists of CRC32 and ISIZE.
+        blocks.push_back({.data_offset = block_start,
+                          .data_size = remaining - 8u,
+                          .uncompressed_size = little_endian(compressed.data() + block_start + remaining - 4u, 4u)});
+        return true;
+    }
+
+    bool inflate_block(block const & current, char * const output) const
+    {
+        if (current.uncompressed_size == 0u) // E.g., the empty EOF marker block.
+            return true;
+
+        z_stream zstream{};
+        if (inflateInit2(&zstream, -15) != Z_OK) // Raw deflate, the gzip header was already parsed.
+            return false; // GCOVR_EXCL_LINE
+
+        zstream.next_in = const_cast<unsigned char *>(compressed.data() + current.data_offset);
+        zstream.avail_in = current.data_size;
+        zstream.next_out = reinterpret_cast<unsigned char *>(output + current.output_offset);
+        zstream.avail_out = current.uncompressed_size;
+
+        int const status = inflate(&zstream, Z_FINISH);
+        bool const success = (status == Z_STREAM_END) && (zstream.avail_out == 0u);
+        inflateEnd(&zstream);
+        return success;
+    }
+};
+
+/*!\brief Decompresses a gzip file on a dedicated thread.
+ * \details
+ * The decompressed blocks are handed over via a bounded queue. Concatenated gzip members are supported.
+ */
+class gzip_source final : public byte_source
+{
+public:
+    explicit gzip_source(std::ifstream && stream) :
+        stream{std::move(stream)},
+        inflate_thread{[this]()
+                       {
+                           inflate_all();
+                       }}
+    {}
+
+    ~gzip_source() override
+    {
+        {
+            std::lock_guard lock{queue_mutex};
+            stop = true;
+        }
+        producer_condition.notify_all();
+        inflate_thread.join();
+    }
+
+    bool append_to(std::string & buffer) override
+    {
+        std::unique_lock lock{queue_mutex};
+        consumer_condition.wait(lock,
+                                [this]()
+                                {
+                                    return !queue.empty() || done;
+                                });
+
+        if (queue.empty())
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+            return false;
+        }
+
+        std::string const block = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        producer_condition.notify_one();
+
+        buffer.append(block);
+        return true;
+    }
+
+private:
+    static constexpr size_t input_size{1ULL << 20};
+    static constexpr size_t output_size{1ULL << 24};
+    static constexpr size_t queue_capacity{4u};
+
+    std::ifstream stream;
+    std::mutex queue_mutex{};
+    std::condition_variable producer_condition{};
+    std::condition_variable consumer_condition{};
+    std::deque<std::string> queue{};
+    std::exception_ptr exception{};
+    bool done{false};
+    bool stop{false};
+    std::thread inflate_thread; // Must be the last member: The thread starts during construction.
+
+    bool push(std::string && block)
+    {
+        std::unique_lock lock{queue_mutex};
+        producer_condition.wait(lock,
+                                [this]()
+                                {
+                                    return queue.size() < queue_capacity || stop;
+                                });
+        if (stop)
+            return false;
+        queue.push_back(std::move(block));
+        lock.unlock();
+        consumer_condition.notify_one();
+        return true;
+    }
+
+    void inflate_all()
+    {
+        z_stream zstream{};
+        bool const initialised = inflateInit2(&zstream, 15 + 32) == Z_OK; // 15 + 32: gzip with automatic header
+
+        try
+        {
+            if (!initialised)
+                throw seqan3::io_error{"Could not initialise zlib."}; // GCOVR_EXCL_LINE
+
+            std::vector<unsigned char> input(input_size);
+            std::string output(output_size, '\0');
+            size_t output_used{};
+            bool member_complete{true};
+
+            while (true)
+            {
+                if (zstream.avail_in == 0u)
+                {
+                    stream.read(reinterpret_cast<char *>(input.data()), input.size());
+                    zstream.next_in = input.data();
+                    zstream.avail_in = stream.gcount();
+                    if (zstream.avail_in == 0u)
+                        break;
+                }
+
+                if (member_complete) // The previous member ended, but there is more input.
+                {
+                    inflateReset(&zstream);
+                    member_complete = false;
+                }
+
+                zstream.next_out = reinterpret_cast<unsigned char *>(output.data() + output_used);
+                zstream.avail_out = output.size() - output_used;
+
+                int const status = inflate(&zstream, Z_NO_FLUSH);
+                if (status == Z_STREAM_END)
+                    member_complete = true;
+                else if (status != Z_OK && status != Z_BUF_ERROR)
+                    throw seqan3::io_error{"The gzip file is corrupted."};
+
+                output_used = output.size() - zstream.avail_out;
+                if (output_used == output.size())
+                {
+                    if (!push(std::move(output)))
+                        break;
+                    output.assign(output_size, '\0');
+                    output_used = 0u;
+                }
+            }
+
+            if (!member_complete)
+                throw seqan3::io_error{"The gzip file is truncated."};
+
+            output.resize(output_used);
+            if (!output.empty())
+                push(std::move(output));
+        }
+        catch (...)
+        {
+            std::lock_guard lock{queue_mutex};
+            exception = std::current_exception();
+        }
+
+        if (initialised)
+            inflateEnd(&zstream);
+
+        {
+            std::lock_guard lock{queue_mutex};
+            done = true;
+        }
+        consumer_condition.notify_all();
+    }
+};
+#endif
+
+compression_kind detect_compression(std::ifstream & stream)
+{
+    std::array<unsigned char, 18> magic_header{};
+    stream.read(reinterpret_cast<char *>(magic_header.data()), magic_header.size());
+    size_t const bytes_read = stream.gcount();
+    stream.clear();
+    stream.seekg(0);
+
+    if (bytes_read >= 3u && magic_header[0] == 'B' && magic_header[1] == 'Z' && magic_header[2] == 'h')
+        return compression_kind::other;
+
+    if (bytes_read < 3u || magic_header[0] != 0x1f || magic_header[1] != 0x8b || magic_header[2] != 0x08)
+        return compression_kind::none;
+
+    // BGZF: FEXTRA flag set, XLEN == 6, and the first subfield is 'BC'.
+    if (bytes_read == magic_header.size() && (magic_header[3] & 0x04) && magic_header[10] == 6u
+        && magic_header[11] == 0u && magic_header[12] == 'B' && magic_header[13] == 'C')
+        return compression_kind::bgzf;
+
+    return compression_kind::gzip;
+}
+
+constexpr size_t sample_head_records{1ULL << 16};
+constexpr size_t sample_windows{64u};
+constexpr size_t sample_window_size{1ULL << 20};
+constexpr size_t sample_records_per_window{1024u};
+
+// 0-3: rank, skip: ignored character (whitespace, and digits for FASTA), invalid: not a valid character.
+constexpr uint8_t skip_character{0xFE};
+constexpr uint8_t invalid_character{0xFF};
+
+std::array<uint8_t, 256> make_conversion_table(bool const skip_digits)
+{
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        char const chr = static_cast<char>(i);
+        if (chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r' || chr == '\v' || chr == '\f'
+            || (skip_digits && chr >= '0' && chr <= '9'))
+            table[i] = skip_character;
+        else if (seqan3::char_is_valid_for<seqan3::dna4>(chr))
+            table[i] = seqan3::assign_char_to(chr, seqan3::dna4{}).to_rank();
+        else
+            table[i] = invalid_character;
+    }
+    return table;
+}
+
+void convert_sequence(std::string_view const text, std::vector<seqan3::dna4> & sequence, bool const is_fastq)
+{
+    static std::array<uint8_t, 256> const fasta_table = make_conversion_table(true);
+    static std::array<uint8_t, 256> const fastq_table = make_conversion_table(false);
+    std::array<uint8_t, 256> const & table = is_fastq ? fastq_table : fasta_table;
+
+    sequence.clear();
+    sequence.reserve(text.size());
+    for (char const chr : text)
+    {
+        uint8_t const rank = table[static_cast<unsigned char>(chr)];
+        if (rank < 4u)
+            sequence.push_back(seqan3::dna4{}.assign_rank(rank));
+        else if (rank == invalid_character)
+            throw seqan3::parse_error{std::string{"Encountered an unexpected letter: char_is_valid_for<dna4> "
+                                                  "evaluated to false on "}
+                                      + chr};
+    }
+}
+
+std::string_view strip_carriage_return(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1u);
+    return line;
+}
+
+void parse_fasta_record(std::string_view const record, query_record & result)
+{
+    size_t const id_end = std::min(record.find('\n'), record.size());
+    std::string_view id = strip_carriage_return(record.substr(0u, id_end));
+    id.remove_prefix(std::min(id.find_first_not_of(">; \t"), id.size()));
+
+    result.id.assign(id);
+    convert_sequence(record.substr(std::min(id_end + 1u, record.size())), result.sequence, false);
+}
+
+void parse_fastq_record(std::string_view const record, query_record & result)
+{
+    size_t const id_end = std::min(record.find('\n'), record.size());
+    std::string_view id = strip_carriage_return(record.substr(0u, id_end));
+    id.remove_prefix(1u); // '@'
+
+    // The sequence ends at the first line starting with '+'.
+    size_t const sequence_begin = std::min(id_end + 1u, record.size());
+    size_t const sequence_end = std::max(std::min(record.find("\n+", id_end), record.size()), sequence_begin);
+
+    result.id.assign(id);
+    convert_sequence(record.substr(sequence_begin, sequence_end - sequence_begin), result.sequence, true);
+}
+
+/*!\brief Returns the end of the FASTA record starting at `begin`.
+ * \details
+ * Returns std::string_view::npos if the record may continue after the end of `buffer`.
+ */
+size_t fasta_record_end(std::string_view const buffer, size_t const begin, bool const is_last)
+{
+    size_t position = buffer.find('\n', begin);
+    while (position != std::string_view::npos && position + 1u < buffer.size())
+    {
+        ++position;
+        if (buffer[position] == '>' || buffer[position] == ';')
+            return position;
+        position = buffer.find('\n', position);
+    }
+    return is_last ? buffer.size() : std::string_view::npos;
+}
+
+/*!\brief Returns the end of the FASTQ record starting at `begin`.
+ * \details
+ * Returns std::string_view::npos if the record may continue after the end of `buffer`.
+ * Sequence and qualities may span multiple lines.
+ */
+size_t fastq_record_end(std::string_view const buffer, size_t const begin, bool const is_last)
+{
+    constexpr size_t npos = std::string_view::npos;
+
+    // Returns the end of the line starting at `line_begin`. `npos` if the line is incomplete.
+    auto line_end = [&](size_t const line_begin)
+    {
+        size_t const end = buffer.find('\n', line_begin);
+        return (end == npos && is_last) ? buffer.size() : end;
+    };
+
+    auto line_length = [&](size_t const line_begin, size_t const end)
+    {
+        return strip_carriage_return(buffer.substr(line_begin, end - line_begin)).size();
+    };
+
+    size_t position = line_end(begin);
+    size_t sequence_length{};
+
+    while (true)
+    {
+        if (position == npos || (position + 1u >= buffer.size() && !is_last))
+            return npos;
+        if (position + 1u >= buffer.size())
+            throw seqan3::parse_error{"Expected to be on beginning of separator, but '+' was not found."};
+
+        size_t const line_begin = position + 1u;
+        position = line_end(line_begin);
+        if (buffer[line_begin] == '+')
+            break;
+        if (position != npos)
+            sequence_length += line_length(line_begin, position);
+    }
+
+    size_t quality_length{};
+    while (quality_length < sequence_length)
+    {
+        if (position == npos || (position + 1u >= buffer.size() && !is_last))
+            return npos;
+        if (position + 1u >= buffer.size())
+            throw seqan3::parse_error{"The quality string is shorter than the sequence."};
+
+        size_t const line_begin = position + 1u;
+        position = line_end(line_begin);
+        if (position != npos)
+            quality_length += line_length(line_begin, position);
+    }
+
+    if (position == npos)
+        return npos;
+    return std::min(position + 1u, buffer.size());
+}
+
+std::ifstream open_file(std::filesystem::path const & file_path)
+{
+    std::ifstream stream{file_path, std::ios::binary};
+    if (!stream.good())
+        throw seqan3::file_open_error{"Could not open file " + file_path.string() + " for reading."};
+    return stream;
+}
+
+struct file_properties
+{
+    compression_kind compression{};
+    bool is_fasta{};
+    bool is_fastq{};
+};
+
+file_properties detect_file_properties(std::filesystem::path const & file_path, std::ifstream & stream)
+{
+    file_properties result{.compression = detect_compression(stream)};
+
+    std::filesystem::path format_path{file_path};
+    if (std::string const extension = format_path.extension().string();
+        extension == ".gz" || extension == ".bgzf" || extension == ".bz2" || extension == ".zst")
+        format_path.replace_extension();
+
+    std::string extension = format_path.extension().string();
+    if (!extension.empty())
+        extension.erase(0u, 1u); // Leading '.'
+
+    auto const & fasta_extensions = seqan3::format_fasta::file_extensions;
+    auto const & fastq_extensions = seqan3::format_fastq::file_extensions;
+    result.is_fasta = std::ranges::find(fasta_extensions, extension) != fasta_extensions.end();
+    result.is_fastq = std::ranges::find(fastq_extensions, extension) != fastq_extensions.end();
+
+    return result;
+}
+
+//!\brief Returns the start of the first FASTA record in `window`, which may start anywhere within a file.
+size_t fasta_resynchronise(std::string_view const window)
+{
+    size_t const position = window.find("\n>");
+    return position == std::string_view::npos ? window.size() : position + 1u;
+}
+
+/*!\brief Returns the start of the first FASTQ record in `window`, which may start anywhere within a file.
+ * \details
+ * Qualities may start with '@'. A line starting with '@' is only a record start if the line after next starts with '+'.
+ */
+size_t fastq_resynchronise(std::string_view const window)
+{
+    constexpr size_t npos = std::string_view::npos;
+
+    for (size_t position = window.find("\n@"); position != npos; position = window.find("\n@", position + 1u))
+    {
+        size_t const sequence_line_end = window.find('\n', position + 1u);
+        if (sequence_line_end == npos)
+            break;
+        size_t const separator_line_end = window.find('\n', sequence_line_end + 1u);
+        if (separator_line_end == npos || separator_line_end + 1u >= window.size())
+            break;
+        if (window[separator_line_end + 1u] == '+')
+            return position + 1u;
+    }
+
+    return window.size();
+}
+
+//!\brief Appends the lengths of the complete records in `window` to `lengths`.
+void sample_window(std::string_view const window,
+                   bool const is_fastq,
+                   bool const is_last,
+                   std::vector<uint64_t> & lengths)
+{
+    query_record record{};
+    char const id_start = is_fastq ? '@' : '>';
+    size_t position = is_fastq ? fastq_resynchronise(window) : fasta_resynchronise(window);
+
+    for (size_t count{}; count < sample_records_per_window; ++count)
+    {
+        position = std::min(window.find_first_not_of("\r\n", position), window.size());
+        if (position == window.size() || window[position] != id_start)
+            break;
+
+        size_t const end = is_fastq ? fastq_record_end(window, position, is_last)
+                                    : fasta_record_end(window, position, is_last);
+        if (end == std::string_view::npos)
+            break;
+
+        if (is_fastq)
+            parse_fastq_record(window.substr(position, end - position), record);
+        else
+            parse_fasta_record(window.substr(position, end - position), record);
+
+        lengths.push_back(record.sequence.size());
+        position = end;
+    }
+}
+
+} // namespace detail
+
+query_reader::query_reader(std::filesystem::path const & file_path, uint8_t const threads) :
+    threads{std::max<uint8_t>(threads, 1u)}
+{
+    std::ifstream stream = detail::open_file(file_path);
+    detail::file_properties const properties = detail::detect_file_properties(file_path, stream);
+    is_fastq = properties.is_fastq;
+
+    if (properties.is_fasta || properties.is_fastq)
+    {
+        switch (properties.compression)
+        {
+        case detail::compression_kind::none:
+            source = std::make_unique<detail::plain_source>(std::move(stream));
+            break;
+#if SEQAN3_HAS_ZLIB
+        case detail::compression_kind::bgzf:
+            source = std::make_unique<detail::bgzf_source>(std::move(stream), this->threads);
+            break;
+        case detail::compression_kind::gzip:
+            source = std::make_unique<detail::gzip_source>(std::move(stream));
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+    if (!source)
+        fallback_file = std::make_unique<fallback_file_t>(file_path);
+}
+
+query_reader::~query_reader() = default;
+
+bool query_reader::read_chunk(std::vector<query_record> & records, size_t const max_records)
+{
+    size_t const count = fallback_file ? read_fallback(records, max_records) : read_records(records, max_records);
+    records.resize(count);
+
+    for (auto const & record : records)
+    {
+        min_length = std::min<uint64_t>(min_length, record.sequence.size());
+        max_length = std::max<uint64_t>(max_length, record.sequence.size());
+    }
+
+    return count > 0u;
+}
+
+size_t query_reader::read_records(std::vector<query_record> & records, size_t const max_records)
+{
+    size_t count{};
+    while (count < max_records)
+    {
+        find_records(max_records - count);
+
+        if (!record_spans.empty())
+        {
+            if (records.size() < count + record_spans.size())
+                records.resize(count + record_spans.size());
+            parse_records(records, count);
+            count += record_spans.size();
+        }
+
+        if (count == max_records || source_exhausted)
+            break;
+
+        buffer.erase(0u, buffer_position);
+        buffer_position = 0u;
+        source_exhausted = !source->append_to(buffer);
+    }
+
+    return count;
+}
+
+void query_reader::find_records(size_t const max_records)
+{
+    record_spans.clear();
+    std::string_view const view{buffer};
+    char const id_start = is_fastq ? '@' : '>';
+
+    while (record_spans.size() < max_records)
+    {
+        buffer_position = std::min(view.find_first_not_of("\r\n", buffer_position), view.size());
+        if (buffer_position == view.size())
+            break;
+
+        if (view[buffer_position] != id_start && (is_fastq || view[buffer_position] != ';'))
+            throw seqan3::parse_error{std::string{"Expected to be on beginning of ID, but "} + view[buffer_position]
+                                      + " was found."};
+
+        size_t const end = is_fastq ? detail::fastq_record_end(view, buffer_position, source_exhausted)
+                                    : detail::fasta_record_end(view, buffer_position, source_exhausted);
+        if (end == std::string_view::npos)
+            break;
+
+        record_spans.emplace_back(buffer_position, end);
+        buffer_position = end;
+    }
+}
+
+void query_reader::parse_records(std::vector<query_record> & records, size_t const offset)
+{
+    std::string_view const view{buffer};
+    size_t const number_of_records = record_spans.size();
+    std::exception_ptr exception{};
+
+#pragma omp parallel for schedule(static) num_threads(threads)
+    for (size_t i = 0; i < number_of_records; ++i)
+    {
+        auto const [begin, end] = record_spans[i];
+        try
+        {
+            if (is_fastq)
+                detail::parse_fastq_record(view.substr(begin, end - begin), records[offset + i]);
+            else
+                detail::parse_fasta_record(view.substr(begin, end - begin), records[offset + i]);
+        }
+        catch (...)
+        {
+#pragma omp critical
+            exception = std::current_exception();
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+size_t query_reader::read_fallback(std::vector<query_record> & records, size_t const max_records)
+{
+    size_t count{};
+    auto it = fallback_file->begin();
+    for (; count < max_records && it != fallback_file->end(); ++it, ++count)
+    {
+        if (records.size() <= count)
+            records.emplace_back();
+        records[count].id = std::move((*it).id());
+        records[count].sequence = std::move((*it).sequence());
+    }
+    return count;
+}
+
+std::vector<uint64_t> sample_query_lengths(std::filesystem::path const & file_path, uint8_t const threads)
+{
+    std::vector<uint64_t> lengths{};
+
+    // The head of the file. If the file is small, this already covers all records.
+    {
+        query_reader reader{file_path, threads};
+        std::vector<query_record> records{};
+        reader.read_chunk(records, detail::sample_head_records);
+        for (auto const & record : records)
+            lengths.push_back(record.sequence.size());
+
+        if (records.size() < detail::sample_head_records || !reader.read_chunk(records, 1u))
+        {
+            std::ranges::sort(lengths);
+            return lengths;
+        }
+    }
+
+    // Windows at random positions. Plain gzip files do not support random access.
+    std::ifstream stream = detail::open_file(file_path);
+    detail::file_properties const properties = detail::detect_file_properties(file_path, stream);
+    bool const is_supported_compression = properties.compression == detail::compression_kind::none
+#if SEQAN3_HAS_ZLIB
+                                       || properties.compression == detail::compression_kind::bgzf
+#endif
+        ;
+
+    if ((properties.is_fasta || properties.is_fastq) && is_supported_compression)
+    {
+        size_t const file_size = std::filesystem::file_size(file_path);
+        std::mt19937_64 generator{0u};
+        std::uniform_int_distribution<size_t> distribution{0u, file_size - 1u};
+        std::string window{};
+
+        for (size_t i = 0; i < detail::sample_windows; ++i)
+        {
+            size_t const offset = distribution(generator);
+            stream.clear();
+            stream.seekg(offset);
+            window.resize(detail::sample_window_size);
+            stream.read(window.data(), window.size());
+            window.resize(stream.gcount());
+
+            if (properties.compression == detail::compression_kind::none)
+            {
+                detail::sample_window(window, properties.is_fastq, offset + window.size() == file_size, lengths);
+                continue;
+            }
+
+#if SEQAN3_HAS_ZLIB
+            // BGZF: Find the next block header, i.e., the gzip magic bytes followed by the 'BC' subfield.
+            constexpr std::string_view bgzf_magic{"\x1f\x8b\x08\x04", 4u};
+            constexpr std::string_view bgzf_subfield{"\x06\x00\x42\x43\x02\x00", 6u};
+            auto is_block_start = [&](size_t const position)
+            {
+                return position + 16u <= window.size() && window.compare(position + 10u, 6u, bgzf_subfield) == 0;
+            };
+
+            size_t block_start = window.find(bgzf_magic);
+            while (block_start != std::string::npos && !is_block_start(block_start))
+                block_start = window.find(bgzf_magic, block_start + 1u);
+
+            if (block_start == std::string::npos)
+                continue;
+
+            std::ifstream block_stream = detail::open_file(file_path);
+            block_stream.seekg(offset + block_start);
+            // 16 blocks are about 1 MiB of decompressed data.
+            detail::bgzf_source source{std::move(block_stream), 1u, 16u};
+            std::string decompressed{};
+            try
+            {
+                source.append_to(decompressed);
+            }
+            catch (seqan3::io_error const &) // The magic bytes were part of the compressed data.
+            {
+                continue;
+            }
+            detail::sample_window(decompressed, properties.is_fastq, false, lengths);
+#endif
+        }
+    }
+
+    std::ranges::sort(lengths);
+    return lengths;
+}
+
+} // namespace raptor
@@ -11,6 +11,7 @@
 #include <raptor/search/search_hibf.hpp>
 #include <raptor/search/search_ibf.hpp>
 #include <raptor/search/search_partitioned_ibf.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -18,6 +19,7 @@ namespace raptor
 void raptor_search(search_arguments const & arguments)
 {
     arguments.complete_search_timer.start();
+    trace_scope complete_search_trace{"Complete search", "search"};
 
     if (arguments.is_hibf)
         search_hibf(arguments);
@@ -33,6 +35,7 @@ void raptor_search(search_arguments const & arguments)
     else
         search_partitioned_ibf(arguments);
 
+    complete_search_trace.stop();
     arguments.complete_search_timer.stop();
 
     return;
@@ -7,6 +7,7 @@
  * \author Enrico Seiler <enrico.seiler AT fu-berlin.de>
  */
 
+#include <raptor/search/lazy_hibf.hpp>
 #include <raptor/search/search_hibf.hpp>
 #include <raptor/search/search_singular_ibf.hpp>
 
@@ -15,8 +16,15 @@ namespace raptor
 
 void search_hibf(search_arguments const & arguments)
 {
-    auto index = raptor_index<index_structure::hibf>{};
-    search_singular_ibf(arguments, std::move(index));
+    if (arguments.lazy_load)
+    {
+        search_singular_ibf(arguments, lazy_hibf{});
+    }
+    else
+    {
+        auto index = raptor_index<index_structure::hibf>{};
+        search_singular_ibf(arguments, std::move(index));
+    }
 }
 
 } // namespace raptor
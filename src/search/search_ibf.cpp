@@ -15,8 +15,16 @@ namespace raptor
 
 void search_ibf(search_arguments const & arguments)
 {
-    auto index = raptor_index<index_structure::ibf>{};
-    search_singular_ibf(arguments, std::move(index));
+    if (arguments.is_blocked_ibf)
+    {
+        auto index = raptor_index<index_structure::blocked_ibf>{};
+        search_singular_ibf(arguments, std::move(index));
+    }
+    else
+    {
+        auto index = raptor_index<index_structure::ibf>{};
+        search_singular_ibf(arguments, std::move(index));
+    }
 }
 
 } // namespace raptor
@@ -10,18 +10,15 @@
 #include <future>
 #include <random>
 
-#include <seqan3/search/views/minimiser_hash.hpp>
-
-#include <hibf/contrib/std/chunk_view.hpp>
-
-#include <raptor/adjust_seed.hpp>
 #include <raptor/build/partition_config.hpp>
-#include <raptor/dna4_traits.hpp>
+#include <raptor/file_reader.hpp>
 #include <raptor/search/do_parallel.hpp>
 #include <raptor/search/load_index.hpp>
+#include <raptor/search/query_reader.hpp>
 #include <raptor/search/search_partitioned_ibf.hpp>
 #include <raptor/search/sync_out.hpp>
 #include <raptor/threshold/threshold.hpp>
+#include <raptor/trace.hpp>
 
 namespace raptor
 {
@@ -29,12 +26,10 @@ namespace raptor
 void search_partitioned_ibf(search_arguments const & arguments)
 {
     auto index = raptor_index<index_structure::ibf>{};
-    partition_config const cfg{arguments.parts};
+    partition_config const cfg{arguments.parts, arguments.partitioning};
 
-    seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::id, seqan3::field::seq>> fin{
-        arguments.query_file};
-    using record_type = typename decltype(fin)::record_type;
-    std::vector<record_type> records{};
+    query_reader reader{arguments.query_file, arguments.threads};
+    std::vector<query_record> records{};
 
     sync_out synced_out{arguments};
 
@@ -45,19 +40,32 @@ void search_partitioned_ibf(search_arguments const & arguments)
 
     raptor::threshold::threshold const thresholder{arguments.make_threshold_parameters()};
 
-    for (auto && chunked_records : fin | seqan::stl::views::chunk((1ULL << 20) * 10))
+    size_t const chunk_size{(1ULL << 20) * 10};
+
+    // A chunk with fewer than `chunk_size` records is the last one.
+    for (bool is_last_chunk{false}; !is_last_chunk;)
     {
+        // The first part is loaded while the chunk is read.
         auto cereal_future = std::async(std::launch::async,
                                         [&]() // GCOVR_EXCL_LINE
                                         {
                                             load_index(index, arguments, 0);
                                         });
 
-        records.clear();
         arguments.query_file_io_timer.start();
-        std::ranges::move(chunked_records, std::back_inserter(records));
+        trace_scope query_file_io_trace{"Query file I/O", "search"};
+        if (!reader.read_chunk(records, chunk_size))
+        {
+            query_file_io_trace.stop();
+            arguments.query_file_io_timer.stop();
+            cereal_future.get();
+            break;
+        }
+        is_last_chunk = records.size() < chunk_size;
+
         // Very fast, improves parallel processing when chunks of the query belong to the same bin.
         std::ranges::shuffle(records, std::mt19937_64{0u});
+        query_file_io_trace.stop();
         arguments.query_file_io_timer.stop();
 
         cereal_future.get();
@@ -73,21 +81,31 @@ void search_partitioned_ibf(search_arguments const & arguments)
         {
             seqan::hibf::serial_timer local_compute_minimiser_timer{};
             seqan::hibf::serial_timer local_query_ibf_timer{};
+            perf_counter_group const counter_group{arguments.perf_counters};
+            serial_perf_counters local_compute_minimiser_counters{counter_group};
+            serial_perf_counters local_query_ibf_counters{counter_group};
+            stage_latencies local_stage_latency{arguments.latency_histograms};
 
             auto & ibf = index.ibf();
             auto counter = ibf.template counting_agent<uint16_t>();
             size_t counter_id = start;
             std::vector<uint64_t> minimiser;
 
-            auto hash_view = seqan3::views::minimiser_hash(arguments.shape,
-                                                           seqan3::window_size{arguments.window_size},
-                                                           seqan3::seed{adjust_seed(arguments.shape_weight)});
+            file_reader<file_types::sequence> const hash_reader{arguments.shape,
+                                                                arguments.window_size,
+                                                                arguments.sketch};
 
             for (auto && [id, seq] : std::span{records.data() + start, extent})
             {
-                auto minimiser_view = seq | hash_view | std::views::common;
+                local_stage_latency.set_query_length(seq.size());
+
                 local_compute_minimiser_timer.start();
-                minimiser.assign(minimiser_view.begin(), minimiser_view.end());
+                local_compute_minimiser_counters.start();
+                local_stage_latency.start();
+                minimiser.clear();
+                hash_reader.hash_into(seq, std::back_inserter(minimiser));
+                local_stage_latency.stop(latency_stage::compute_minimiser);
+                local_compute_minimiser_counters.stop();
                 local_compute_minimiser_timer.stop();
 
                 // GCOVR_EXCL_START
@@ -100,16 +118,25 @@ void search_partitioned_ibf(search_arguments const & arguments)
                 // GCOVR_EXCL_STOP
 
                 local_query_ibf_timer.start();
+                local_query_ibf_counters.start();
+                local_stage_latency.start();
                 counts[counter_id++] += counter.bulk_count(filtered);
+                local_stage_latency.stop(latency_stage::query_ibf);
+                local_query_ibf_counters.stop();
                 local_query_ibf_timer.stop();
             }
 
             arguments.compute_minimiser_timer += local_compute_minimiser_timer;
             arguments.query_ibf_timer += local_query_ibf_timer;
+            arguments.stage_latency += local_stage_latency;
+            arguments.compute_minimiser_counters += local_compute_minimiser_counters;
+            arguments.query_ibf_counters += local_query_ibf_counters;
         };
 
         arguments.parallel_search_timer.start();
+        trace_scope parallel_search_trace{"Parallel search", "search"};
         do_parallel(count_task, records.size(), arguments.threads);
+        parallel_search_trace.stop();
         arguments.parallel_search_timer.stop();
         ++part;
 
@@ -117,7 +144,9 @@ void search_partitioned_ibf(search_arguments const & arguments)
         {
             load_index(index, arguments, part);
             arguments.parallel_search_timer.start();
+            trace_scope parallel_search_trace{"Parallel search", "search"};
             do_parallel(count_task, records.size(), arguments.threads);
+            parallel_search_trace.stop();
             arguments.parallel_search_timer.stop();
         }
 
@@ -129,6 +158,11 @@ void search_partitioned_ibf(search_arguments const & arguments)
             seqan::hibf::serial_timer local_compute_minimiser_timer{};
             seqan::hibf::serial_timer local_query_ibf_timer{};
             seqan::hibf::serial_timer local_generate_results_timer{};
+            perf_counter_group const counter_group{arguments.perf_counters};
+            serial_perf_counters local_compute_minimiser_counters{counter_group};
+            serial_perf_counters local_query_ibf_counters{counter_group};
+            serial_perf_counters local_generate_results_counters{counter_group};
+            stage_latencies local_stage_latency{arguments.latency_histograms};
 
             auto & ibf = index.ibf();
             auto counter = ibf.template counting_agent<uint16_t>();
@@ -137,9 +171,9 @@ void search_partitioned_ibf(search_arguments const & arguments)
             std::array<char, std::numeric_limits<uint64_t>::digits10 + 1> buffer{};
             std::vector<uint64_t> minimiser;
 
-            auto hash_adaptor = seqan3::views::minimiser_hash(arguments.shape,
-                                                              seqan3::window_size{arguments.window_size},
-                                                              seqan3::seed{adjust_seed(arguments.shape_weight)});
+            file_reader<file_types::sequence> const hash_reader{arguments.shape,
+                                                                arguments.window_size,
+                                                                arguments.sketch};
 
             for (auto && [id, seq] : std::span{records.data() + start, extent})
             {
@@ -147,9 +181,15 @@ void search_partitioned_ibf(search_arguments const & arguments)
                 result_string += id;
                 result_string += '\t';
 
-                auto minimiser_view = seq | hash_adaptor | std::views::common;
+                local_stage_latency.set_query_length(seq.size());
+
                 local_compute_minimiser_timer.start();
-                minimiser.assign(minimiser_view.begin(), minimiser_view.end());
+                local_compute_minimiser_counters.start();
+                local_stage_latency.start();
+                minimiser.clear();
+                hash_reader.hash_into(seq, std::back_inserter(minimiser));
+                local_stage_latency.stop(latency_stage::compute_minimiser);
+                local_compute_minimiser_counters.stop();
                 local_compute_minimiser_timer.stop();
 
                 // GCOVR_EXCL_START
@@ -161,7 +201,11 @@ void search_partitioned_ibf(search_arguments const & arguments)
                                     });
                 // GCOVR_EXCL_STOP
                 local_query_ibf_timer.start();
+                local_query_ibf_counters.start();
+                local_stage_latency.start();
                 counts[counter_id] += counter.bulk_count(filtered);
+                local_stage_latency.stop(latency_stage::query_ibf);
+                local_query_ibf_counters.stop();
                 local_query_ibf_timer.stop();
 
                 size_t const minimiser_count{minimiser.size()};
@@ -169,6 +213,8 @@ void search_partitioned_ibf(search_arguments const & arguments)
 
                 size_t const threshold = thresholder.get(minimiser_count);
                 local_generate_results_timer.start();
+                local_generate_results_counters.start();
+                local_stage_latency.start();
                 for (auto && count : counts[counter_id++])
                 {
                     if (count >= threshold)
@@ -187,18 +233,29 @@ void search_partitioned_ibf(search_arguments const & arguments)
                     result_string += '\n';
 
                 synced_out.write(result_string);
+                local_stage_latency.stop(latency_stage::generate_results);
+                local_generate_results_counters.stop();
                 local_generate_results_timer.stop();
             }
 
             arguments.compute_minimiser_timer += local_compute_minimiser_timer;
             arguments.query_ibf_timer += local_query_ibf_timer;
             arguments.generate_results_timer += local_generate_results_timer;
+            arguments.stage_latency += local_stage_latency;
+            arguments.compute_minimiser_counters += local_compute_minimiser_counters;
+            arguments.query_ibf_counters += local_query_ibf_counters;
+            arguments.generate_results_counters += local_generate_results_counters;
         };
 
         arguments.parallel_search_timer.start();
+        trace_scope parallel_search_trace{"Parallel search", "search"};
         do_parallel(output_task, records.size(), arguments.threads);
+        parallel_search_trace.stop();
         arguments.parallel_search_timer.stop();
     }
+
+    arguments.min_query_length = reader.min_sequence_length();
+    arguments.max_query_length = reader.max_sequence_length();
 }
 
 } // namespace raptor
@@ -10,15 +10,27 @@
 #include <random>
 
 #include <raptor/threshold/forward_strand_minimiser.hpp>
+#include <raptor/threshold/logspace.hpp>
 #include <raptor/threshold/one_indirect_error_model.hpp>
 
 namespace raptor::threshold
 {
 
-[[nodiscard]] std::vector<double>
-one_indirect_error_model(size_t const query_length, size_t const window_size, seqan3::shape const shape)
+[[nodiscard]] std::vector<double> one_indirect_error_model(size_t const query_length,
+                                                           size_t const window_size,
+                                                           seqan3::shape const shape,
+                                                           sketch_kind const sketch)
 {
     uint8_t const kmer_size{shape.size()};
+
+    // With probability 1, no syncmer is affected. There must be room for the k syncmers that are affected directly.
+    if (sketch == sketch_kind::syncmer)
+    {
+        std::vector<double> result(kmer_size + 1u, logspace::negative_inf);
+        result[0] = 0.0;
+        return result;
+    }
+
     size_t const max_number_of_minimiser{query_length - window_size + 1};
     size_t const iterations{10'000};
 
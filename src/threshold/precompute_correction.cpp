@@ -22,7 +22,11 @@ namespace raptor::threshold
 {
     std::stringstream stream{};
     stream << "correction_" << std::hex << arguments.query_length << '_' << arguments.window_size << '_'
-           << arguments.shape.to_ulong() << '_' << arguments.p_max << '_' << arguments.fpr << ".bin";
+           << arguments.shape.to_ulong() << '_' << arguments.p_max << '_' << arguments.fpr;
+    // Minimisers are not marked, so files of previous versions remain valid.
+    if (arguments.sketch == sketch_kind::syncmer)
+        stream << "_syncmer";
+    stream << ".bin";
     std::string result = stream.str();
     if (auto it = result.find("0."); it != std::string::npos)
         result.replace(it, 2, "");
@@ -56,9 +60,8 @@ bool read_correction(std::vector<size_t> & vec, threshold_parameters const & arg
 
 [[nodiscard]] std::vector<size_t> precompute_correction(threshold_parameters const & arguments)
 {
-    uint8_t const kmer_size{arguments.shape.size()};
-    assert(arguments.window_size != kmer_size); // Use k-mer lemma.
-    assert(std::isnan(arguments.percentage));   // Use percentage.
+    assert(arguments.window_size != arguments.shape.size()); // Use k-mer lemma.
+    assert(std::isnan(arguments.percentage));                // Use percentage.
 
     std::vector<size_t> correction;
 
@@ -68,10 +71,8 @@ bool read_correction(std::vector<size_t> & vec, threshold_parameters const & arg
     double const fpr{std::log(arguments.fpr)};
     double const inv_fpr{std::log(1.0 - arguments.fpr)};
     double const log_p_max{std::log(arguments.p_max)};
-    size_t const kmers_per_window{arguments.window_size - kmer_size + 1};
-    size_t const kmers_per_pattern{arguments.query_length - kmer_size + 1};
-    size_t const minimal_number_of_minimisers{kmers_per_pattern / kmers_per_window};
-    size_t const maximal_number_of_minimisers{arguments.query_length - arguments.window_size + 1};
+    size_t const minimal_number_of_minimisers{arguments.minimal_number_of_minimisers()};
+    size_t const maximal_number_of_minimisers{arguments.maximal_number_of_minimisers()};
 
     correction.reserve(maximal_number_of_minimisers - minimal_number_of_minimisers + 1);
 
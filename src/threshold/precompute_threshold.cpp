@@ -24,8 +24,11 @@ namespace raptor::threshold
 {
     std::stringstream stream{};
     stream << "threshold_" << std::hex << arguments.query_length << '_' << arguments.window_size << '_'
-           << arguments.shape.to_ulong() << '_' << static_cast<uint16_t>(arguments.errors) << '_' << arguments.tau
-           << ".bin";
+           << arguments.shape.to_ulong() << '_' << static_cast<uint16_t>(arguments.errors) << '_' << arguments.tau;
+    // Minimisers are not marked, so files of previous versions remain valid.
+    if (arguments.sketch == sketch_kind::syncmer)
+        stream << "_syncmer";
+    stream << ".bin";
     std::string result = stream.str();
     if (auto it = result.find("0."); it != std::string::npos)
         result.replace(it, 2, "");
@@ -67,16 +70,15 @@ bool read_thresholds(std::vector<size_t> & vec, threshold_parameters const & arg
         return thresholds;
 
     double const log_tau{std::log(arguments.tau)};
-    size_t const kmers_per_window{arguments.window_size - kmer_size + 1};
     size_t const kmers_per_pattern{arguments.query_length - kmer_size + 1};
-    size_t const minimal_number_of_minimisers{kmers_per_pattern / kmers_per_window};
-    size_t const maximal_number_of_minimisers{arguments.query_length - arguments.window_size + 1};
+    size_t const minimal_number_of_minimisers{arguments.minimal_number_of_minimisers()};
+    size_t const maximal_number_of_minimisers{arguments.maximal_number_of_minimisers()};
 
     thresholds.reserve(maximal_number_of_minimisers - minimal_number_of_minimisers + 1);
 
     // Probability that i minimisers are indirectly affected by one error.
     std::vector<double> const affected_by_one_error_indirectly_prob{
-        one_indirect_error_model(arguments.query_length, arguments.window_size, arguments.shape)};
+        one_indirect_error_model(arguments.query_length, arguments.window_size, arguments.shape, arguments.sketch)};
 
     // Iterate over the possible number of minimisers.
     for (size_t number_of_minimisers = minimal_number_of_minimisers;
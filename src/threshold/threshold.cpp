@@ -34,9 +34,8 @@ threshold::threshold(threshold_parameters const & arguments)
     else
     {
         threshold_kind = threshold_kinds::probabilistic;
-        size_t const kmers_per_pattern = arguments.query_length - kmer_size + 1;
-        minimal_number_of_minimizers = kmers_per_pattern / kmers_per_window;
-        maximal_number_of_minimizers = arguments.query_length - arguments.window_size + 1;
+        minimal_number_of_minimizers = arguments.minimal_number_of_minimisers();
+        maximal_number_of_minimizers = arguments.maximal_number_of_minimisers();
         precomp_correction = precompute_correction(arguments);
         precomp_thresholds = precompute_threshold(arguments);
     }
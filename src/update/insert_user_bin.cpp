@@ -41,7 +41,8 @@ template <std::output_iterator<uint64_t> it_t>
 void hash_paths_into(std::vector<std::string> const & paths,
                      it_t target,
                      seqan3::shape const shape,
-                     uint32_t const window_size)
+                     uint32_t const window_size,
+                     sketch_kind const sketch)
 {
     assert(!paths.empty());
     assert(std::ranges::all_of(paths,
@@ -58,10 +59,24 @@ void hash_paths_into(std::vector<std::string> const & paths,
     if (std::filesystem::path{paths.front()}.extension() == ".minimiser")
         file_reader<file_types::minimiser>{}.hash_into(paths, target);
     else
-        file_reader<file_types::sequence>{shape, window_size}.hash_into(paths, target);
+        file_reader<file_types::sequence>{shape, window_size, sketch}.hash_into(paths, target);
 }
 
-//!\brief Computes the set of k-mers of a user bin, using the shape and window size the index was built with.
+//!\brief Reads the hashes of all files of a user bin of the index into `target`.
+template <std::output_iterator<uint64_t> it_t>
+void hash_paths_into(bin_path_table::user_bin_view const & paths,
+                     it_t target,
+                     seqan3::shape const shape,
+                     uint32_t const window_size,
+                     sketch_kind const sketch)
+{
+    std::vector<std::string> copied_paths{};
+    for (std::string_view const path : paths)
+        copied_paths.emplace_back(path);
+    hash_paths_into(copied_paths, target, shape, window_size, sketch);
+}
+
+//!\brief Computes the set of k-mers of a user bin, using the shape, window size, and sketch of the index.
 robin_hood::unordered_flat_set<uint64_t> compute_kmers(std::vector<std::string> const & user_bin,
                                                        raptor_index<index_structure::hibf> const & index)
 {
@@ -69,7 +84,8 @@ robin_hood::unordered_flat_set<uint64_t> compute_kmers(std::vector<std::string>
     hash_paths_into(user_bin,
                     std::inserter(kmers, kmers.begin()),
                     index.shape(),
-                    static_cast<uint32_t>(index.window_size()));
+                    static_cast<uint32_t>(index.window_size()),
+                    index.sketch());
     return kmers;
 }
 
@@ -186,7 +202,8 @@ void partial_rebuild(update_arguments const & arguments,
         detail::hash_paths_into(index.bin_path()[ub_ids[user_bin_id]],
                                 it,
                                 index.shape(),
-                                static_cast<uint32_t>(index.window_size()));
+                                static_cast<uint32_t>(index.window_size()),
+                                index.sketch());
     };
 
     seqan::hibf::config config{index.config()};
@@ -297,10 +314,11 @@ void full_rebuild(update_arguments const & arguments, raptor_index<index_structu
     auto bin_path = index.bin_path();
     auto const shape = index.shape();
     auto const window_size = static_cast<uint32_t>(index.window_size());
+    auto const sketch = index.sketch();
 
-    auto input_fn = [&bin_path, shape, window_size](size_t const user_bin_id, seqan::hibf::insert_iterator it)
+    auto input_fn = [&bin_path, shape, window_size, sketch](size_t const user_bin_id, seqan::hibf::insert_iterator it)
     {
-        detail::hash_paths_into(bin_path[user_bin_id], it, shape, window_size);
+        detail::hash_paths_into(bin_path[user_bin_id], it, shape, window_size, sketch);
     };
 
     seqan::hibf::config config{index.config()};
@@ -318,7 +336,8 @@ void full_rebuild(update_arguments const & arguments, raptor_index<index_structu
                                                 1u,
                                                 std::move(bin_path),
                                                 config,
-                                                std::move(hibf)};
+                                                std::move(hibf),
+                                                sketch};
 }
 
 //!\brief The rebuild an IBF needs because of its number of technical bins.
@@ -418,10 +437,9 @@ rebuild_decision determine_rebuild(raptor_index<index_structure::hibf> const & i
 
 void insert_user_bin(update_arguments const & arguments, raptor_index<index_structure::hibf> & index)
 {
-    auto full_rebuild_bin_path = index.bin_path();
-    full_rebuild_bin_path.insert(full_rebuild_bin_path.end(),
-                                 arguments.user_bins_to_insert.begin(),
-                                 arguments.user_bins_to_insert.end());
+    bin_path_table full_rebuild_bin_path = index.bin_path();
+    for (std::vector<std::string> const & user_bin : arguments.user_bins_to_insert)
+        full_rebuild_bin_path.push_back(user_bin);
 
     for (std::vector<std::string> const & user_bin : arguments.user_bins_to_insert)
     {
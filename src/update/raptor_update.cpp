@@ -11,6 +11,8 @@
 
 #include <raptor/build/store_index.hpp>
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
+#include <raptor/trace.hpp>
 #include <raptor/update/delete_user_bins.hpp>
 #include <raptor/update/dump_index.hpp>
 #include <raptor/update/insert_user_bin.hpp>
@@ -21,24 +23,29 @@ namespace raptor
 
 void raptor_update(update_arguments const & arguments)
 {
-    std::ifstream index_file{arguments.index_file};
-    cereal::BinaryInputArchive archive{index_file};
+    trace_scope load_index_trace{"Load index", "update"};
     raptor::raptor_index<index_structure::hibf> index;
-    archive(index);
+    read_index_container(index, arguments.index_file, arguments.threads);
+    index_compression const compression = read_index_compression(arguments.index_file);
+    load_index_trace.stop();
 
     // dump_index(index);
     if (!arguments.user_bins_to_delete.empty())
     {
+        trace_scope const delete_trace{"Delete user bins", "update"};
         delete_user_bins(arguments, index);
         // dump_index(index);
     }
     if (!arguments.user_bins_to_insert.empty())
     {
+        trace_scope const insert_trace{"Insert user bins", "update"};
         insert_user_bin(arguments, index);
         // dump_index(index);
     }
 
-    store_index(arguments.out_path, std::move(index));
+    trace_scope const store_index_trace{"Store index", "update"};
+    // The updated index keeps the compression of the input index.
+    store_index(arguments.out_path, std::move(index), arguments.threads, compression);
 }
 
 } // namespace raptor
@@ -16,6 +16,7 @@
 #include <hibf/contrib/std/zip_view.hpp>
 
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
 
 #ifndef RAPTOR_ASSERT_ZERO_EXIT
 #    define RAPTOR_ASSERT_ZERO_EXIT(arg)                                                                               \
@@ -271,19 +272,12 @@ struct raptor_base : public cli_test
 
         raptor::raptor_index<data_t> expected_index{}, actual_index{};
 
-        {
-            std::ifstream is{expected_result, std::ios::binary};
-            cereal::BinaryInputArchive iarchive{is};
-            iarchive(expected_index);
-        }
-        {
-            std::ifstream is{actual_result, std::ios::binary};
-            cereal::BinaryInputArchive iarchive{is};
-            iarchive(actual_index);
-        }
+        raptor::read_index_container(expected_index, expected_result, 1u);
+        raptor::read_index_container(actual_index, actual_result, 1u);
 
         EXPECT_EQ(expected_index.window_size(), actual_index.window_size());
         EXPECT_EQ(expected_index.shape(), actual_index.shape());
+        EXPECT_EQ(expected_index.sketch(), actual_index.sketch());
         EXPECT_EQ(expected_index.parts(), actual_index.parts());
 
         if constexpr (is_ibf)
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <raptor/build/bulk_emplacer.hpp>
+
+#define USE_UNIT_TEST_PARAMETERS 1
+
+// With the unit test parameters, the IBF has 8 MiB and mostly fits into the cache. Then, bucketing does not help.
+// The other parameters use an IBF of 2 GiB, where almost every emplace misses the cache and the TLB.
+#if USE_UNIT_TEST_PARAMETERS
+static constexpr size_t const bin_size{1ULL << 16};
+#else
+static constexpr size_t const bin_size{1ULL << 24};
+#endif
+
+static constexpr size_t const bins{1024u};
+static constexpr size_t const values_per_bin{bin_size / 8u};
+
+static std::vector<uint64_t> const & get_values()
+{
+    static std::vector<uint64_t> const values = []()
+    {
+        std::mt19937_64 engine{0u};
+        std::vector<uint64_t> result(values_per_bin);
+        for (uint64_t & value : result)
+            value = engine();
+        return result;
+    }();
+    return values;
+}
+
+static seqan::hibf::interleaved_bloom_filter make_ibf()
+{
+    return seqan::hibf::interleaved_bloom_filter{seqan::hibf::bin_count{bins},
+                                                 seqan::hibf::bin_size{bin_size},
+                                                 seqan::hibf::hash_function_count{2u}};
+}
+
+// Inserts the same values into every `state.range(0)`-th bin. The items are the inserted values.
+static void emplace(benchmark::State & state)
+{
+    std::vector<uint64_t> const & values = get_values();
+    size_t const step = state.range(0);
+    seqan::hibf::interleaved_bloom_filter ibf = make_ibf();
+
+    for (auto _ : state)
+        for (size_t bin = 0; bin < bins; bin += step)
+            for (uint64_t const value : values)
+                ibf.emplace(value, seqan::hibf::bin_index{bin});
+
+    state.SetItemsProcessed(state.iterations() * (bins / step) * values.size());
+}
+
+static void bulk_emplace(benchmark::State & state)
+{
+    std::vector<uint64_t> const & values = get_values();
+    size_t const step = state.range(0);
+    seqan::hibf::interleaved_bloom_filter ibf = make_ibf();
+
+    for (auto _ : state)
+    {
+        for (size_t bin = 0; bin < bins; bin += step)
+        {
+            raptor::bulk_emplacer inserter{ibf, seqan::hibf::bin_index{bin}};
+            std::ranges::copy(values, std::back_inserter(inserter));
+            inserter.flush();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (bins / step) * values.size());
+}
+
+BENCHMARK(emplace)->Arg(64)->Arg(256);
+BENCHMARK(bulk_emplace)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <random>
+
+#include <raptor/index_container.hpp>
+
+#define USE_UNIT_TEST_PARAMETERS 1
+
+#if USE_UNIT_TEST_PARAMETERS
+static constexpr size_t const bits{1ULL << 20};
+#else
+static constexpr size_t const bits{1ULL << 26};
+#endif
+
+static constexpr size_t const bins{64u};
+
+static std::filesystem::path get_path(raptor::index_compression const compression)
+{
+    std::filesystem::path path{std::filesystem::temp_directory_path()};
+    path /= "raptor_benchmark_" + std::to_string(bits) + "_"
+          + std::to_string(static_cast<uint16_t>(compression)) + ".index";
+    return path;
+}
+
+// Writes the same index with each compression. About half of the bits are set, as in an index with an FPR of 0.05:
+// With 2 hash functions and 0.35 * bits values per bin, a bit is set with probability 1 - e^(-2 * 0.35) ≈ 0.5.
+static std::filesystem::path const & get_file(raptor::index_compression const compression)
+{
+    static std::filesystem::path const paths[3]{get_path(raptor::index_compression::none),
+                                                get_path(raptor::index_compression::lz4),
+                                                get_path(raptor::index_compression::zstd)};
+    static bool const generated = []()
+    {
+        raptor::build_arguments arguments{};
+        arguments.window_size = 23u;
+        arguments.shape = seqan3::ungapped{19u};
+        arguments.bin_path = std::vector<std::vector<std::string>>(bins, std::vector<std::string>{"bin.fa"});
+        arguments.bins = bins;
+        arguments.bits = bits;
+        arguments.hash = 2u;
+
+        raptor::raptor_index<raptor::index_structure::ibf> index{arguments};
+        std::mt19937_64 engine{0u};
+        for (size_t i = 0; i < bins * bits / 100u * 35u; ++i)
+            index.ibf().emplace(engine(), seqan::hibf::bin_index{i % bins});
+
+        for (auto const compression :
+             {raptor::index_compression::none, raptor::index_compression::lz4, raptor::index_compression::zstd})
+            raptor::write_index_container(paths[static_cast<size_t>(compression)], index, 4u, compression);
+        return true;
+    }();
+    (void)generated;
+    return paths[static_cast<size_t>(compression)];
+}
+
+// The bytes of the loaded index, not of the file.
+static void read(benchmark::State & state, raptor::index_compression && compression)
+{
+    std::filesystem::path const & path = get_file(compression);
+    uint8_t const threads = state.range(0);
+    size_t bytes{};
+
+    for (auto _ : state)
+    {
+        raptor::raptor_index<raptor::index_structure::ibf> index{};
+        raptor::read_index_container(index, path, threads);
+        bytes = index.ibf().bit_size() / 8u;
+        benchmark::DoNotOptimize(index);
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["file_bytes"] = std::filesystem::file_size(path);
+}
+
+BENCHMARK_CAPTURE(read, none, raptor::index_compression::none)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_CAPTURE(read, lz4, raptor::index_compression::lz4)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_CAPTURE(read, zstd, raptor::index_compression::zstd)->Arg(1)->Arg(4)->UseRealTime();
+
+BENCHMARK_MAIN();
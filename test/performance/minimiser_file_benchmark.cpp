@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include <hibf/interleaved_bloom_filter.hpp>
+
+#include <raptor/build/emplace_iterator.hpp>
+#include <raptor/build/partition_config.hpp>
+#include <raptor/file_reader.hpp>
+#include <raptor/minimiser_file.hpp>
+
+#define USE_UNIT_TEST_PARAMETERS 1
+
+#if USE_UNIT_TEST_PARAMETERS
+static constexpr size_t const minimiser_count{1ULL << 20};
+#else
+static constexpr size_t const minimiser_count{1ULL << 28};
+#endif
+
+static constexpr size_t const parts{4u};
+
+enum class format : uint8_t
+{
+    raw,
+    compressed
+};
+
+static std::filesystem::path get_path(format const file_format)
+{
+    std::filesystem::path path{std::filesystem::temp_directory_path()};
+    path /= "raptor_benchmark_" + std::to_string(minimiser_count)
+          + (file_format == format::raw ? "_raw.minimiser" : "_compressed.minimiser");
+    return path;
+}
+
+// Writes the same minimisers in both formats, as `raptor prepare` would (raw: previous versions).
+static std::string const & get_file(format const file_format)
+{
+    static std::string const raw_path{get_path(format::raw).string()};
+    static std::string const compressed_path{get_path(format::compressed).string()};
+    static bool const generated = []()
+    {
+        std::mt19937_64 engine{0u};
+        std::vector<uint64_t> values(minimiser_count);
+        std::ranges::generate(values, engine);
+
+        {
+            std::ofstream raw{raw_path, std::ios::binary};
+            raw.write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(uint64_t));
+        }
+
+        std::ranges::sort(values);
+        values.erase(std::ranges::unique(values).begin(), values.end());
+        raptor::write_minimiser_file(compressed_path, values, {});
+        return true;
+    }();
+    (void)generated;
+    return file_format == format::raw ? raw_path : compressed_path;
+}
+
+// The bytes of the minimisers, not of the file.
+static void set_counters(benchmark::State & state, std::string const & path)
+{
+    state.SetBytesProcessed(state.iterations() * raptor::minimiser_file_input{path}.size() * sizeof(uint64_t));
+    state.counters["file_bytes"] = std::filesystem::file_size(path);
+}
+
+// Reading one minimiser per `std::ifstream::read`, as done by previous versions.
+static void ifstream_baseline(benchmark::State & state)
+{
+    std::string const & path = get_file(format::raw);
+    raptor::partition_config const cfg{parts};
+    std::vector<uint64_t> counts(parts);
+
+    for (auto _ : state)
+    {
+        std::ifstream fin{path, std::ios::binary};
+        uint64_t value;
+        while (fin.read(reinterpret_cast<char *>(&value), sizeof(value)))
+            ++counts[cfg.hash_partition(value)];
+        benchmark::DoNotOptimize(counts);
+    }
+
+    set_counters(state, path);
+}
+
+// The access pattern of raptor::max_count_per_partition.
+static void for_each_hash(benchmark::State & state, format && file_format)
+{
+    std::string const & path = get_file(file_format);
+    raptor::file_reader<raptor::file_types::minimiser> const reader{};
+    raptor::partition_config const cfg{parts};
+    std::vector<uint64_t> counts(parts);
+
+    for (auto _ : state)
+    {
+        reader.for_each_hash(path,
+                             [&](uint64_t const hash)
+                             {
+                                 ++counts[cfg.hash_partition(hash)];
+                             });
+        benchmark::DoNotOptimize(counts);
+    }
+
+    set_counters(state, path);
+}
+
+// The access pattern of `raptor build`.
+static void hash_into(benchmark::State & state, format && file_format)
+{
+    std::string const & path = get_file(file_format);
+    raptor::file_reader<raptor::file_types::minimiser> const reader{};
+    seqan::hibf::interleaved_bloom_filter ibf{seqan::hibf::bin_count{1u},
+                                              seqan::hibf::bin_size{minimiser_count * 16u},
+                                              seqan::hibf::hash_function_count{2u}};
+
+    for (auto _ : state)
+    {
+        reader.hash_into(path, raptor::emplacer(ibf, seqan::hibf::bin_index{0u}));
+        benchmark::ClobberMemory();
+    }
+
+    set_counters(state, path);
+}
+
+BENCHMARK(ifstream_baseline);
+BENCHMARK_CAPTURE(for_each_hash, raw, format::raw);
+BENCHMARK_CAPTURE(for_each_hash, compressed, format::compressed);
+BENCHMARK_CAPTURE(hash_into, raw, format::raw);
+BENCHMARK_CAPTURE(hash_into, compressed, format::compressed);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <raptor/file_reader.hpp>
+
+#define USE_UNIT_TEST_PARAMETERS 1
+
+#if USE_UNIT_TEST_PARAMETERS
+static constexpr size_t const sequence_length{1ULL << 20};
+#else
+static constexpr size_t const sequence_length{1ULL << 26};
+#endif
+
+static std::vector<seqan3::dna4> const & get_sequence()
+{
+    static std::vector<seqan3::dna4> const sequence = []()
+    {
+        std::mt19937_64 engine{0u};
+        std::vector<seqan3::dna4> result(sequence_length);
+        for (seqan3::dna4 & base : result)
+            base.assign_rank(engine() % 4u);
+        return result;
+    }();
+    return sequence;
+}
+
+// The bytes are the bases of the sequence. `density` is the fraction of k-mers that are stored.
+static void hash(benchmark::State & state, raptor::sketch_kind && sketch)
+{
+    std::vector<seqan3::dna4> const & sequence = get_sequence();
+    uint8_t const kmer_size = state.range(0);
+    uint32_t const window_size = state.range(1);
+    raptor::file_reader<raptor::file_types::sequence> const reader{seqan3::ungapped{kmer_size}, window_size, sketch};
+    size_t count{};
+
+    for (auto _ : state)
+    {
+        count = 0u;
+        reader.for_each_hash(sequence,
+                             [&count](uint64_t const value)
+                             {
+                                 benchmark::DoNotOptimize(value);
+                                 ++count;
+                             });
+    }
+
+    state.SetBytesProcessed(state.iterations() * sequence.size());
+    state.counters["density"] = static_cast<double>(count) / (sequence.size() - kmer_size + 1u);
+}
+
+BENCHMARK_CAPTURE(hash, minimiser, raptor::sketch_kind::minimiser)->Args({19, 23})->Args({32, 40});
+BENCHMARK_CAPTURE(hash, syncmer, raptor::sketch_kind::syncmer)->Args({19, 23})->Args({32, 40});
+
+BENCHMARK_MAIN();
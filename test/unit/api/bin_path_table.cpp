@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <cereal/archives/binary.hpp>
+
+#include <raptor/bin_path_table.hpp>
+
+static std::vector<std::vector<std::string>> const bin_path{{"/data/a/bin0.fa"},
+                                                            {"/data/a/bin1.fa", "/data/b/bin1.fa"},
+                                                            {"bin2.fa"},
+                                                            {"/data/a/bin3.fa", "/bin4.fa", "/data/b/bin5.fa"}};
+
+TEST(bin_path_table, access)
+{
+    raptor::bin_path_table const table{bin_path};
+    EXPECT_EQ(table.size(), bin_path.size());
+    EXPECT_EQ(table.number_of_paths(), 7u);
+    EXPECT_FALSE(table.empty());
+    EXPECT_TRUE(raptor::bin_path_table{}.empty());
+
+    size_t user_bin_id{};
+    for (auto const & user_bin : table)
+    {
+        ASSERT_EQ(std::ranges::size(user_bin), bin_path[user_bin_id].size());
+        for (size_t i = 0; i < bin_path[user_bin_id].size(); ++i)
+            EXPECT_EQ(user_bin[i], bin_path[user_bin_id][i]);
+        ++user_bin_id;
+    }
+    EXPECT_EQ(user_bin_id, bin_path.size());
+    EXPECT_EQ(table.to_vector(), bin_path);
+}
+
+TEST(bin_path_table, push_back)
+{
+    raptor::bin_path_table table{};
+    for (std::vector<std::string> const & user_bin : bin_path)
+        table.push_back(user_bin);
+
+    EXPECT_EQ(table, raptor::bin_path_table{bin_path});
+    EXPECT_EQ(table[1].front(), "/data/a/bin1.fa");
+    EXPECT_EQ(table[3].back(), "/data/b/bin5.fa");
+}
+
+TEST(bin_path_table, serialisation)
+{
+    raptor::bin_path_table const expected{bin_path};
+    std::stringstream stream{};
+    {
+        cereal::BinaryOutputArchive oarchive{stream};
+        oarchive(expected);
+    }
+
+    raptor::bin_path_table actual{};
+    {
+        cereal::BinaryInputArchive iarchive{stream};
+        iarchive(actual);
+    }
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(actual.to_vector(), bin_path);
+}
+
+TEST(bin_path_table, shared_directories)
+{
+    // 1000 files in one directory: the directory is stored once.
+    std::string const directory(200u, 'd');
+    std::vector<std::vector<std::string>> many_paths{};
+    for (size_t i = 0; i < 1000u; ++i)
+        many_paths.push_back({directory + "/bin" + std::to_string(i) + ".fa"});
+
+    std::stringstream stream{};
+    {
+        cereal::BinaryOutputArchive oarchive{stream};
+        oarchive(raptor::bin_path_table{many_paths});
+    }
+    EXPECT_LT(stream.str().size(), 1000u * directory.size());
+
+    raptor::bin_path_table actual{};
+    {
+        cereal::BinaryInputArchive iarchive{stream};
+        iarchive(actual);
+    }
+    EXPECT_EQ(actual.to_vector(), many_paths);
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include <cereal/archives/binary.hpp>
+
+#include <raptor/blocked_bloom_filter.hpp>
+
+using raptor::blocked_bloom_filter;
+
+TEST(blocked_bloom_filter, rows_per_block)
+{
+    // A block has 4 KiB, but at least 64 rows.
+    EXPECT_EQ(blocked_bloom_filter::rows_per_block(1u), 512u);
+    EXPECT_EQ(blocked_bloom_filter::rows_per_block(64u), 512u);
+    EXPECT_EQ(blocked_bloom_filter::rows_per_block(65u), 256u);
+    EXPECT_EQ(blocked_bloom_filter::rows_per_block(512u), 64u);
+    EXPECT_EQ(blocked_bloom_filter::rows_per_block(100'000u), 64u);
+}
+
+TEST(blocked_bloom_filter, construction)
+{
+    blocked_bloom_filter const filter{seqan::hibf::bin_count{100u},
+                                      seqan::hibf::bin_size{1000u},
+                                      seqan::hibf::hash_function_count{3u}};
+    EXPECT_EQ(filter.bin_count(), 100u);
+    EXPECT_EQ(filter.hash_function_count(), 3u);
+    EXPECT_EQ(filter.bin_size(), 1024u); // Rounded up to a multiple of 256 rows.
+    EXPECT_EQ(filter.bit_size(), 128u * 1024u);
+
+    EXPECT_THROW((blocked_bloom_filter{seqan::hibf::bin_count{0u},
+                                       seqan::hibf::bin_size{1u},
+                                       seqan::hibf::hash_function_count{1u}}),
+                 std::logic_error);
+    EXPECT_THROW((blocked_bloom_filter{seqan::hibf::bin_count{1u},
+                                       seqan::hibf::bin_size{1u},
+                                       seqan::hibf::hash_function_count{6u}}),
+                 std::logic_error);
+}
+
+// The bit vector is zeroed in parallel; the threads must not change the filter.
+TEST(blocked_bloom_filter, construction_threads)
+{
+    blocked_bloom_filter const expected{seqan::hibf::bin_count{100u},
+                                        seqan::hibf::bin_size{100'000u},
+                                        seqan::hibf::hash_function_count{2u}};
+
+    for (uint8_t const threads : {0u, 2u, 3u, 64u})
+    {
+        blocked_bloom_filter const filter{seqan::hibf::bin_count{100u},
+                                          seqan::hibf::bin_size{100'000u},
+                                          seqan::hibf::hash_function_count{2u},
+                                          threads};
+        EXPECT_EQ(filter, expected);
+        EXPECT_TRUE(std::all_of(filter.data(),
+                                filter.data() + filter.bit_size() / 64u,
+                                [](uint64_t const word)
+                                {
+                                    return word == 0u;
+                                }));
+    }
+}
+
+// Only the bit vector is left uninitialised.
+TEST(blocked_bloom_filter, construction_uninitialised)
+{
+    blocked_bloom_filter const expected{seqan::hibf::bin_count{100u},
+                                        seqan::hibf::bin_size{1000u},
+                                        seqan::hibf::hash_function_count{3u}};
+    blocked_bloom_filter filter{seqan::hibf::bin_count{100u},
+                                seqan::hibf::bin_size{1000u},
+                                seqan::hibf::hash_function_count{3u},
+                                blocked_bloom_filter::uninitialised};
+    EXPECT_EQ(filter.bin_size(), expected.bin_size());
+    EXPECT_EQ(filter.bit_size(), expected.bit_size());
+
+    std::fill_n(filter.data(), filter.bit_size() / 64u, 0u);
+    EXPECT_EQ(filter, expected);
+}
+
+TEST(blocked_bloom_filter, membership_for)
+{
+    blocked_bloom_filter filter{seqan::hibf::bin_count{130u},
+                                seqan::hibf::bin_size{8192u},
+                                seqan::hibf::hash_function_count{2u}};
+    std::vector<uint64_t> const values{1u, 2u, 3u, 4u, 5u};
+    for (uint64_t const value : values)
+    {
+        filter.emplace(value, seqan::hibf::bin_index{0u});
+        filter.emplace(value, seqan::hibf::bin_index{129u});
+    }
+    filter.emplace(1u, seqan::hibf::bin_index{64u});
+
+    auto agent = filter.membership_agent();
+    EXPECT_EQ(agent.membership_for(values, 5u), (std::vector<uint64_t>{0u, 129u}));
+    EXPECT_EQ(agent.membership_for(values, 1u), (std::vector<uint64_t>{0u, 64u, 129u}));
+    EXPECT_EQ(agent.membership_for(std::vector<uint64_t>{}, 1u), std::vector<uint64_t>{});
+    EXPECT_EQ(agent.membership_for(std::vector<uint64_t>{}, 0u).size(), 130u);
+}
+
+TEST(blocked_bloom_filter, false_positive_rate)
+{
+    size_t const elements{10'000u};
+    size_t const bins{64u};
+
+    for (size_t const hash_count : {1u, 2u, 3u})
+    {
+        size_t const bin_size = blocked_bloom_filter::bin_size_in_bits(0.05, hash_count, elements, bins);
+        double const fpr = blocked_bloom_filter::false_positive_rate(bin_size,
+                                                                     blocked_bloom_filter::rows_per_block(bins),
+                                                                     hash_count,
+                                                                     elements);
+        EXPECT_LE(fpr, 0.05);
+        EXPECT_GE(fpr, 0.045);
+
+        blocked_bloom_filter filter{seqan::hibf::bin_count{bins},
+                                    seqan::hibf::bin_size{bin_size},
+                                    seqan::hibf::hash_function_count{hash_count}};
+        std::mt19937_64 engine{hash_count};
+        for (size_t i = 0; i < elements; ++i)
+            filter.emplace(engine(), seqan::hibf::bin_index{0u});
+
+        size_t const queries{100'000u};
+        std::vector<uint64_t> query(1u);
+        auto agent = filter.membership_agent();
+        size_t false_positives{};
+        for (size_t i = 0; i < queries; ++i)
+        {
+            query[0] = engine();
+            false_positives += agent.membership_for(query, 1u).size();
+        }
+
+        // The model matches the observed false positive rate.
+        EXPECT_NEAR(static_cast<double>(false_positives) / queries, fpr, 0.005) << "hash_count " << hash_count;
+    }
+}
+
+TEST(blocked_bloom_filter, serialisation)
+{
+    blocked_bloom_filter expected{seqan::hibf::bin_count{10u},
+                                  seqan::hibf::bin_size{1000u},
+                                  seqan::hibf::hash_function_count{2u}};
+    for (uint64_t value = 0; value < 100u; ++value)
+        expected.emplace(value, seqan::hibf::bin_index{value % 10u});
+
+    std::stringstream stream{};
+    {
+        cereal::BinaryOutputArchive oarchive{stream};
+        oarchive(expected);
+    }
+
+    blocked_bloom_filter actual{};
+    {
+        cereal::BinaryInputArchive iarchive{stream};
+        iarchive(actual);
+    }
+
+    EXPECT_TRUE(expected == actual);
+}
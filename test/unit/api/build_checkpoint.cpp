@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include <hibf/misc/next_multiple_of_64.hpp>
+
+#include <raptor/build/build_checkpoint.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct build_checkpoint : public ::testing::Test
+{
+    raptor::test::tmp_test_file tmp{};
+    raptor::build_arguments arguments{};
+
+    void SetUp() override
+    {
+        arguments.out_path = tmp.path() / "raptor.index";
+        arguments.bin_path = {{tmp.create("bin0.fa", ">0\nACGT\n").string()},
+                              {tmp.create("bin1.fa", ">1\nACGT\n").string()},
+                              {tmp.create("bin2.fa", ">2\nACGT\n").string()}};
+        arguments.bins = 3u;
+        arguments.bits = 1024u;
+        arguments.checkpoint_interval = 1u;
+    }
+
+    seqan::hibf::interleaved_bloom_filter make_ibf() const
+    {
+        return seqan::hibf::interleaved_bloom_filter{seqan::hibf::bin_count{arguments.bins},
+                                                     seqan::hibf::bin_size{arguments.bits},
+                                                     seqan::hibf::hash_function_count{arguments.hash}};
+    }
+
+    static bool equal(seqan::hibf::interleaved_bloom_filter & lhs, seqan::hibf::interleaved_bloom_filter & rhs)
+    {
+        size_t const bytes = seqan::hibf::next_multiple_of_64(lhs.bin_count()) * lhs.bin_size() / 8u;
+        return std::memcmp(lhs.data(), rhs.data(), bytes) == 0;
+    }
+};
+
+TEST_F(build_checkpoint, resume)
+{
+    std::filesystem::path const checkpoint_file = raptor::build_checkpoint::path(arguments);
+    EXPECT_EQ(checkpoint_file, tmp.path() / "raptor.index.checkpoint");
+
+    seqan::hibf::interleaved_bloom_filter ibf = make_ibf();
+    {
+        raptor::build_checkpoint checkpoint{arguments, ibf};
+        EXPECT_FALSE(std::filesystem::exists(checkpoint_file));
+
+        checkpoint.start();
+        for (uint64_t value = 0; value < 100u; ++value)
+            ibf.emplace(value, seqan::hibf::bin_index{0u});
+        checkpoint.finish_bin(0u);
+
+        // The first checkpoint is written after one second.
+        for (size_t i = 0; i < 100u && !std::filesystem::exists(checkpoint_file); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+    ASSERT_TRUE(std::filesystem::exists(checkpoint_file));
+    EXPECT_FALSE(std::filesystem::exists(tmp.path() / "raptor.index.checkpoint.tmp"));
+
+    // Without --resume, the checkpoint is not used.
+    seqan::hibf::interleaved_bloom_filter ibf2 = make_ibf();
+    {
+        raptor::build_checkpoint checkpoint{arguments, ibf2};
+        EXPECT_FALSE(checkpoint.is_finished(0u));
+    }
+
+    arguments.resume = true;
+    {
+        raptor::build_checkpoint checkpoint{arguments, ibf2};
+        EXPECT_TRUE(checkpoint.is_finished(0u));
+        EXPECT_FALSE(checkpoint.is_finished(1u));
+        EXPECT_FALSE(checkpoint.is_finished(2u));
+        EXPECT_TRUE(equal(ibf, ibf2));
+    }
+
+    // The sketch differs. The IBF has the same size.
+    arguments.sketch = raptor::sketch_kind::syncmer;
+    EXPECT_THROW((raptor::build_checkpoint{arguments, ibf2}), std::runtime_error);
+    arguments.sketch = raptor::sketch_kind::minimiser;
+
+    // The options differ.
+    arguments.hash = 3u;
+    seqan::hibf::interleaved_bloom_filter ibf3 = make_ibf();
+    EXPECT_THROW((raptor::build_checkpoint{arguments, ibf3}), std::runtime_error);
+}
+
+TEST_F(build_checkpoint, no_checkpoint)
+{
+    arguments.resume = true;
+    seqan::hibf::interleaved_bloom_filter ibf = make_ibf();
+    raptor::build_checkpoint checkpoint{arguments, ibf};
+    EXPECT_FALSE(checkpoint.is_finished(0u));
+    checkpoint.start();
+    checkpoint.stop();
+    EXPECT_FALSE(std::filesystem::exists(raptor::build_checkpoint::path(arguments)));
+}
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <span>
+#include <thread>
+
+#include <raptor/build/bulk_emplacer.hpp>
+
+using seqan::hibf::interleaved_bloom_filter;
+
+static interleaved_bloom_filter make_ibf(size_t const bins, size_t const bin_size, size_t const hash_count)
+{
+    return interleaved_bloom_filter{seqan::hibf::bin_count{bins},
+                                    seqan::hibf::bin_size{bin_size},
+                                    seqan::hibf::hash_function_count{hash_count}};
+}
+
+static std::span<uint64_t const> words(interleaved_bloom_filter const & ibf)
+{
+    return {reinterpret_cast<uint64_t const *>(ibf.data()),
+            seqan::hibf::next_multiple_of_64(ibf.bin_count()) * ibf.bin_size() / 64u};
+}
+
+static void expect_same_bits(interleaved_bloom_filter const & expected, interleaved_bloom_filter const & actual)
+{
+    ASSERT_EQ(expected.bit_size(), actual.bit_size());
+    EXPECT_TRUE(std::ranges::equal(words(expected), words(actual)));
+}
+
+// The bulk emplacer must set the same bits as seqan::hibf::interleaved_bloom_filter::emplace.
+TEST(bulk_emplacer, same_as_emplace)
+{
+    std::mt19937_64 engine{0u};
+    for (size_t const bins : {1u, 64u, 130u})
+    {
+        for (size_t const hash_count : {1u, 2u, 3u, 5u})
+        {
+            // A bin size of 5000 has fewer than 2^12 rows, 100'003 more.
+            for (size_t const bin_size : {5000u, 100'003u})
+            {
+                interleaved_bloom_filter expected = make_ibf(bins, bin_size, hash_count);
+                interleaved_bloom_filter actual = make_ibf(bins, bin_size, hash_count);
+
+                for (size_t bin = 0; bin < bins; bin += 63u)
+                {
+                    // A small block size to flush more than once.
+                    raptor::bulk_emplacer inserter{actual, seqan::hibf::bin_index{bin}, 1000u};
+                    for (size_t i = 0; i < 2500u; ++i)
+                    {
+                        uint64_t const value = engine();
+                        expected.emplace(value, seqan::hibf::bin_index{bin});
+                        inserter.push_back(value);
+                    }
+                    inserter.flush();
+                }
+
+                expect_same_bits(expected, actual);
+            }
+        }
+    }
+}
+
+TEST(bulk_emplacer, back_inserter)
+{
+    interleaved_bloom_filter expected = make_ibf(10u, 1024u, 2u);
+    interleaved_bloom_filter actual = make_ibf(10u, 1024u, 2u);
+    std::vector<uint64_t> const values{1u, 2u, 3u, 2u, 1u, 1000u};
+    for (uint64_t const value : values)
+        expected.emplace(value, seqan::hibf::bin_index{7u});
+
+    {
+        // The destructor flushes.
+        raptor::bulk_emplacer inserter{actual, seqan::hibf::bin_index{7u}};
+        std::ranges::copy(values, std::back_inserter(inserter));
+    }
+
+    expect_same_bits(expected, actual);
+}
+
+// Emplacers of the same and of neighbouring bins share words.
+TEST(bulk_emplacer, concurrent)
+{
+    size_t const bins{4u};
+    size_t const threads{8u};
+    size_t const values_per_thread{20'000u};
+    interleaved_bloom_filter expected = make_ibf(bins, 4096u, 2u);
+    interleaved_bloom_filter actual = make_ibf(bins, 4096u, 2u);
+
+    for (size_t thread = 0; thread < threads; ++thread)
+        for (size_t i = 0; i < values_per_thread; ++i)
+            expected.emplace(thread * values_per_thread + i, seqan::hibf::bin_index{thread % bins});
+
+    std::vector<std::jthread> workers{};
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back(
+            [&, thread]()
+            {
+                raptor::bulk_emplacer inserter{actual, seqan::hibf::bin_index{thread % bins}, 512u};
+                for (size_t i = 0; i < values_per_thread; ++i)
+                    inserter.push_back(thread * values_per_thread + i);
+                inserter.flush();
+            });
+    workers.clear();
+
+    expect_same_bits(expected, actual);
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <mutex>
+#include <set>
+
+#include <raptor/call_parallel_on_bin_slices.hpp>
+#include <raptor/test/cli_test.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct call_parallel_on_bin_slices : public raptor_base
+{
+    using hashes_t = std::set<std::pair<size_t, uint64_t>>;
+
+    raptor::test::tmp_test_file tmp{};
+
+    // A single record of 1000 bases and a file with many short records.
+    std::vector<std::vector<std::string>> sequence_bins() const
+    {
+        std::string long_record{};
+        for (size_t i = 0; i < 1000u; ++i)
+            long_record += "ACGT"[(i * 7u + i / 3u) % 4u];
+
+        std::string short_records{};
+        for (size_t i = 0; i < 50u; ++i)
+            short_records += ">" + std::to_string(i) + '\n' + long_record.substr(i * 13u, 40u) + '\n';
+
+        return {{tmp.create("long.fa", ">long\n", long_record, '\n').string()},
+                {data("bin1.fa"), tmp.create("short.fa", short_records).string()},
+                {data("bin2.fa")}};
+    }
+
+    template <raptor::file_types file_type>
+    static hashes_t expected(raptor::file_reader<file_type> const & reader,
+                             std::vector<std::vector<std::string>> const & bins)
+    {
+        hashes_t result{};
+        for (size_t bin = 0; bin < bins.size(); ++bin)
+        {
+            std::vector<uint64_t> hashes{};
+            reader.hash_into(bins[bin], std::back_inserter(hashes));
+            for (uint64_t const hash : hashes)
+                result.emplace(bin, hash);
+        }
+        return result;
+    }
+
+    template <raptor::file_types file_type>
+    static hashes_t actual(raptor::file_reader<file_type> const & reader,
+                           std::vector<std::vector<std::string>> const & bins,
+                           uint64_t const slice_size)
+    {
+        hashes_t result{};
+        std::mutex mutex{};
+        raptor::call_parallel_on_bin_slices(
+            [&](auto const & slice, size_t const bin_number)
+            {
+                std::vector<uint64_t> hashes{};
+                reader.hash_into(slice, std::back_inserter(hashes));
+                std::lock_guard<std::mutex> lock{mutex};
+                for (uint64_t const hash : hashes)
+                    result.emplace(bin_number, hash);
+            },
+            reader,
+            bins,
+            4u,
+            slice_size);
+        return result;
+    }
+};
+
+TEST_F(call_parallel_on_bin_slices, sequence)
+{
+    std::vector<std::vector<std::string>> const bins = sequence_bins();
+
+    for (uint32_t const window_size : {19u, 23u})
+    {
+        raptor::file_reader<raptor::file_types::sequence> const reader{seqan3::ungapped{19u}, window_size};
+        hashes_t const expected_hashes = expected(reader, bins);
+
+        for (uint64_t const slice_size : {1u, 7u, 100u, raptor::default_bases_per_slice})
+            EXPECT_EQ(actual(reader, bins, slice_size), expected_hashes)
+                << "window size " << window_size << ", slice size " << slice_size;
+    }
+}
+
+TEST_F(call_parallel_on_bin_slices, minimiser)
+{
+    std::filesystem::path const minimiser_file = tmp.path() / "bin.minimiser";
+    {
+        std::ofstream stream{minimiser_file, std::ios::binary};
+        for (uint64_t value = 0; value < 1000u; ++value)
+        {
+            uint64_t const hash = value * 0x9E3779B97F4A7C15ULL;
+            stream.write(reinterpret_cast<char const *>(&hash), sizeof(hash));
+        }
+    }
+    std::filesystem::path const empty_file = tmp.create("empty.minimiser", "");
+
+    std::vector<std::vector<std::string>> const bins{{empty_file.string()},
+                                                     {minimiser_file.string(), empty_file.string()}};
+    raptor::file_reader<raptor::file_types::minimiser> const reader{};
+    hashes_t const expected_hashes = expected(reader, bins);
+    ASSERT_EQ(expected_hashes.size(), 1000u);
+
+    for (uint64_t const slice_size : {1u, 64u, 999u, 1000u, raptor::default_minimisers_per_slice})
+        EXPECT_EQ(actual(reader, bins, slice_size), expected_hashes) << "slice size " << slice_size;
+}
+
+TEST_F(call_parallel_on_bin_slices, on_bin_done)
+{
+    std::vector<std::vector<std::string>> bins = sequence_bins();
+    bins.emplace_back(); // A user bin without files.
+    raptor::file_reader<raptor::file_types::sequence> const reader{seqan3::ungapped{19u}, 23u};
+
+    std::vector<size_t> expected_hashes(bins.size());
+    for (size_t bin = 0; bin < bins.size(); ++bin)
+        reader.for_each_hash(bins[bin],
+                             [&](uint64_t)
+                             {
+                                 ++expected_hashes[bin];
+                             });
+
+    for (uint64_t const slice_size : {7u, raptor::default_bases_per_slice})
+    {
+        std::mutex mutex{};
+        std::vector<size_t> hashes(bins.size());
+        std::vector<size_t> hashes_when_done(bins.size());
+        std::vector<size_t> times_done(bins.size());
+
+        raptor::call_parallel_on_bin_slices(
+            [&](auto const & slice, size_t const bin_number)
+            {
+                size_t count{};
+                reader.for_each_hash(slice,
+                                     [&count](uint64_t)
+                                     {
+                                         ++count;
+                                     });
+                std::lock_guard<std::mutex> lock{mutex};
+                hashes[bin_number] += count;
+            },
+            reader,
+            bins,
+            4u,
+            slice_size,
+            [&](size_t const bin_number)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                hashes_when_done[bin_number] = hashes[bin_number];
+                ++times_done[bin_number];
+            });
+
+        EXPECT_EQ(times_done, std::vector<size_t>(bins.size(), 1u)) << "slice size " << slice_size;
+        EXPECT_EQ(hashes_when_done, expected_hashes) << "slice size " << slice_size;
+    }
+}
@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <raptor/index_container.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct index_container : public ::testing::Test
+{
+    raptor::test::tmp_test_file tmp{};
+    raptor::build_arguments arguments{};
+
+    void SetUp() override
+    {
+        arguments.window_size = 23u;
+        arguments.shape = seqan3::ungapped{19u};
+        arguments.bin_path = {{"bin0.fa"}, {"bin1.fa"}, {"bin2.fa", "bin3.fa"}};
+        arguments.bins = 3u;
+        arguments.bits = 4096u;
+        arguments.hash = 2u;
+    }
+
+    template <typename data_t>
+    raptor::raptor_index<data_t> make_index() const
+    {
+        raptor::raptor_index<data_t> index{arguments};
+        for (uint64_t value = 0; value < 1000u; ++value)
+            index.ibf().emplace(value * 7919u, seqan::hibf::bin_index{value % arguments.bins});
+        return index;
+    }
+
+    template <typename data_t>
+    static void expect_equal(raptor::raptor_index<data_t> const & expected, raptor::raptor_index<data_t> const & actual)
+    {
+        EXPECT_EQ(expected.window_size(), actual.window_size());
+        EXPECT_EQ(expected.shape(), actual.shape());
+        EXPECT_EQ(expected.parts(), actual.parts());
+        EXPECT_EQ(expected.partitioning(), actual.partitioning());
+        EXPECT_EQ(expected.bin_path(), actual.bin_path());
+        EXPECT_EQ(expected.fpr(), actual.fpr());
+        EXPECT_EQ(expected.is_blocked_ibf(), actual.is_blocked_ibf());
+        EXPECT_TRUE(expected.ibf() == actual.ibf());
+    }
+};
+
+TEST_F(index_container, ibf)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    raptor::write_index_container(path, expected, 4u);
+    EXPECT_TRUE(raptor::is_index_container(path));
+
+    for (uint8_t const threads : {1u, 4u})
+    {
+        raptor::raptor_index<raptor::index_structure::ibf> actual{};
+        raptor::read_index_container(actual, path, threads);
+        expect_equal(expected, actual);
+    }
+}
+
+TEST_F(index_container, blocked_ibf)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::blocked_ibf>();
+    raptor::write_index_container(path, expected, 2u);
+
+    raptor::raptor_index<raptor::index_structure::blocked_ibf> actual{};
+    raptor::read_index_container(actual, path, 2u);
+    expect_equal(expected, actual);
+    EXPECT_TRUE(actual.is_blocked_ibf());
+}
+
+TEST_F(index_container, parameters)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    raptor::write_index_container(path, expected, 1u);
+
+    raptor::raptor_index<raptor::index_structure::ibf> actual{};
+    raptor::read_index_parameters(actual, path);
+    EXPECT_EQ(expected.window_size(), actual.window_size());
+    EXPECT_EQ(expected.shape(), actual.shape());
+    EXPECT_EQ(expected.bin_path(), actual.bin_path());
+    EXPECT_EQ(actual.partitioning(), raptor::hash_partitioning::balanced);
+}
+
+TEST_F(index_container, previous_version)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    {
+        std::ofstream os{path, std::ios::binary};
+        cereal::BinaryOutputArchive oarchive{os};
+        oarchive(expected);
+    }
+    EXPECT_FALSE(raptor::is_index_container(path));
+
+    raptor::raptor_index<raptor::index_structure::ibf> actual{};
+    raptor::read_index_container(actual, path, 2u);
+    expect_equal(expected, actual);
+    EXPECT_FALSE(raptor::read_index_metadata(path).has_value());
+}
+
+TEST_F(index_container, metadata)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    raptor::write_index_container(path, expected, 2u, raptor::index_compression::zstd);
+
+    std::optional<raptor::index_metadata> const metadata = raptor::read_index_metadata(path);
+    ASSERT_TRUE(metadata.has_value());
+    EXPECT_EQ(metadata->fixed.index_version, raptor::raptor_index<>::version);
+    EXPECT_EQ(metadata->fixed.window_size, 23u);
+    EXPECT_EQ(metadata->shape_string(), expected.shape().to_string());
+    EXPECT_EQ(metadata->fixed.parts, 1u);
+    EXPECT_EQ(metadata->fixed.number_of_user_bins, 3u);
+    EXPECT_EQ(metadata->fixed.hash_function_count, 2u);
+    EXPECT_EQ(metadata->fixed.fpr, expected.fpr());
+    EXPECT_FALSE(metadata->fixed.is_hibf);
+    EXPECT_FALSE(metadata->fixed.is_blocked_ibf);
+    EXPECT_EQ(metadata->fixed.sketch, std::to_underlying(expected.sketch()));
+    EXPECT_EQ(metadata->fixed.partitioning, std::to_underlying(expected.partitioning()));
+
+    ASSERT_EQ(metadata->ibfs.size(), 1u);
+    raptor::index_metadata::ibf_type const & ibf = metadata->ibfs[0];
+    EXPECT_EQ(ibf.bin_count, 3u);
+    EXPECT_EQ(ibf.bit_size, expected.ibf().bit_size());
+    EXPECT_EQ(ibf.level, 0u);
+    EXPECT_GT(ibf.set_bits, 0u);
+    EXPECT_LE(ibf.set_bits, 2000u);
+}
+
+TEST_F(index_container, truncated)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    raptor::write_index_container(path, expected, 1u);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1u);
+
+    raptor::raptor_index<raptor::index_structure::ibf> actual{};
+    EXPECT_THROW(raptor::read_index_container(actual, path, 1u), std::runtime_error);
+}
+
+TEST_F(index_container, compressed)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+
+    for (auto const compression : {raptor::index_compression::lz4, raptor::index_compression::zstd})
+    {
+        raptor::write_index_container(path, expected, 4u, compression);
+        EXPECT_EQ(raptor::read_index_compression(path), compression);
+
+        for (uint8_t const threads : {1u, 4u})
+        {
+            raptor::raptor_index<raptor::index_structure::ibf> actual{};
+            raptor::read_index_container(actual, path, threads);
+            expect_equal(expected, actual);
+        }
+    }
+}
+
+TEST_F(index_container, compressed_blocked_ibf)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::blocked_ibf>();
+    raptor::write_index_container(path, expected, 2u, raptor::index_compression::zstd);
+
+    raptor::raptor_index<raptor::index_structure::blocked_ibf> actual{};
+    raptor::read_index_container(actual, path, 2u);
+    expect_equal(expected, actual);
+}
+
+TEST_F(index_container, compressed_corrupted)
+{
+    std::filesystem::path const path = tmp.path() / "raptor.index";
+    auto expected = make_index<raptor::index_structure::ibf>();
+    raptor::write_index_container(path, expected, 1u, raptor::index_compression::lz4);
+    EXPECT_EQ(raptor::read_index_compression(path), raptor::index_compression::lz4);
+    {
+        // Overwrites the compressed block of the bit vector, but not the raw size and the block size.
+        raptor::detail::index_file const file{path, O_RDWR};
+        raptor::index_section const section = raptor::detail::read_section_table(file)[1];
+        std::string const garbage(section.size - 2u * sizeof(uint64_t), '\xff');
+        file.write_at(garbage.data(), garbage.size(), section.offset + 2u * sizeof(uint64_t));
+    }
+
+    raptor::raptor_index<raptor::index_structure::ibf> actual{};
+    EXPECT_THROW(raptor::read_index_container(actual, path, 1u), std::runtime_error);
+}
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <raptor/search/latency_histogram.hpp>
+
+TEST(latency_histogram, empty)
+{
+    raptor::latency_histogram const histogram{};
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.percentile(50.0), 0u);
+}
+
+TEST(latency_histogram, exact_small_values)
+{
+    raptor::latency_histogram histogram{};
+    for (uint64_t value = 1u; value <= 10u; ++value)
+        histogram.record(value);
+
+    EXPECT_EQ(histogram.count(), 10u);
+    EXPECT_EQ(histogram.max(), 10u);
+    EXPECT_EQ(histogram.percentile(0.0), 1u);
+    EXPECT_EQ(histogram.percentile(50.0), 5u);
+    EXPECT_EQ(histogram.percentile(90.0), 9u);
+    EXPECT_EQ(histogram.percentile(100.0), 10u);
+}
+
+TEST(latency_histogram, relative_error)
+{
+    raptor::latency_histogram histogram{};
+    for (uint64_t value = 1u; value <= 100'000u; ++value)
+        histogram.record(value);
+
+    for (double const percentile : {50.0, 90.0, 99.0})
+    {
+        double const exact = percentile * 1000.0;
+        double const estimate = histogram.percentile(percentile);
+        EXPECT_GE(estimate, exact);
+        EXPECT_LE(estimate, exact * (1.0 + 1.0 / 32.0));
+    }
+    EXPECT_EQ(histogram.percentile(100.0), 100'000u);
+}
+
+TEST(latency_histogram, large_values)
+{
+    raptor::latency_histogram histogram{};
+    histogram.record(std::numeric_limits<uint64_t>::max());
+    histogram.record(0u);
+
+    EXPECT_EQ(histogram.percentile(50.0), 0u);
+    EXPECT_EQ(histogram.percentile(100.0), std::numeric_limits<uint64_t>::max());
+}
+
+TEST(latency_histogram, merge)
+{
+    raptor::latency_histogram first{};
+    raptor::latency_histogram second{};
+    raptor::latency_histogram both{};
+    for (uint64_t value = 0u; value < 1000u; ++value)
+    {
+        (value % 2u ? first : second).record(value * 7u);
+        both.record(value * 7u);
+    }
+
+    first += second;
+    EXPECT_EQ(first.count(), both.count());
+    EXPECT_EQ(first.max(), both.max());
+    for (double const percentile : {10.0, 50.0, 90.0, 99.0})
+        EXPECT_EQ(first.percentile(percentile), both.percentile(percentile));
+}
+
+TEST(stage_latencies, disabled)
+{
+    raptor::stage_latencies latencies{};
+    latencies.set_query_length(100u);
+    latencies.start();
+    latencies.stop(raptor::latency_stage::query_ibf);
+
+    EXPECT_EQ(latencies.histogram(raptor::latency_stage::query_ibf).count(), 0u);
+    EXPECT_TRUE(latencies.histograms_per_length(raptor::latency_stage::query_ibf).empty());
+}
+
+TEST(stage_latencies, per_length)
+{
+    raptor::stage_latencies latencies{true};
+    for (size_t const length : {100u, 120u, 250u})
+    {
+        latencies.set_query_length(length);
+        latencies.start();
+        latencies.stop(raptor::latency_stage::compute_minimiser);
+    }
+
+    raptor::concurrent_stage_latencies merged{};
+    merged += latencies;
+    merged += latencies;
+
+    raptor::stage_latencies const & result = merged.get();
+    EXPECT_EQ(result.histogram(raptor::latency_stage::compute_minimiser).count(), 6u);
+    EXPECT_EQ(result.histogram(raptor::latency_stage::query_ibf).count(), 0u);
+
+    // 100 and 120 are in [64, 128), 250 is in [128, 256).
+    auto const & per_length = result.histograms_per_length(raptor::latency_stage::compute_minimiser);
+    ASSERT_EQ(per_length.size(), 9u);
+    EXPECT_EQ(per_length[7].count(), 4u);
+    EXPECT_EQ(per_length[8].count(), 2u);
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <numeric>
+#include <thread>
+
+#include <raptor/search/lazy_hibf.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct lazy_hibf : public ::testing::Test
+{
+    static constexpr size_t number_of_user_bins{256u};
+    static constexpr uint64_t values_per_user_bin{100u};
+
+    raptor::test::tmp_test_file tmp{};
+    std::filesystem::path index_path{tmp.path() / "raptor.index"};
+    raptor::raptor_index<raptor::index_structure::hibf> expected{};
+
+    void SetUp() override
+    {
+        seqan::hibf::config config{.input_fn =
+                                       [](size_t const user_bin_id, seqan::hibf::insert_iterator it)
+                                   {
+                                       for (uint64_t value = 0; value < values_per_user_bin; ++value)
+                                           it = user_bin_id * values_per_user_bin + value;
+                                   },
+                                   .number_of_user_bins = number_of_user_bins,
+                                   .tmax = 64u};
+        seqan::hibf::hierarchical_interleaved_bloom_filter hibf{config};
+        raptor::bin_path_table const bin_path{
+            std::vector<std::vector<std::string>>(number_of_user_bins, std::vector<std::string>{"bin.fa"})};
+        expected = raptor::raptor_index<raptor::index_structure::hibf>{raptor::window{19u},
+                                                                       seqan3::ungapped{19u},
+                                                                       1u,
+                                                                       bin_path,
+                                                                       config,
+                                                                       std::move(hibf)};
+        raptor::write_index_container(index_path, expected, 1u);
+        ASSERT_GT(expected.ibf().ibf_vector.size(), 2u);
+    }
+
+    static std::vector<uint64_t> query(size_t const user_bin_id)
+    {
+        std::vector<uint64_t> values(values_per_user_bin);
+        std::iota(values.begin(), values.end(), user_bin_id * values_per_user_bin);
+        return values;
+    }
+};
+
+TEST_F(lazy_hibf, loads_on_demand)
+{
+    raptor::lazy_hibf index{};
+    index.load(index_path);
+    EXPECT_EQ(index.number_of_loaded_ibfs(), 1u);
+    EXPECT_EQ(index.index().bin_path().size(), number_of_user_bins);
+    EXPECT_EQ(index.hash_function_count(), expected.ibf().ibf_vector[0].hash_function_count());
+
+    auto agent = index.membership_agent();
+    auto expected_agent = expected.ibf().membership_agent();
+    std::vector<uint64_t> const values = query(5u);
+    auto const & expected_result = expected_agent.membership_for(values, values_per_user_bin);
+    EXPECT_EQ(agent.membership_for(values, values_per_user_bin),
+              std::vector<uint64_t>(expected_result.begin(), expected_result.end()));
+    EXPECT_LT(index.number_of_loaded_ibfs(), expected.ibf().ibf_vector.size());
+}
+
+TEST_F(lazy_hibf, concurrent)
+{
+    raptor::lazy_hibf index{};
+    index.load(index_path);
+
+    std::vector<std::thread> threads{};
+    std::vector<size_t> failures(4u);
+    for (size_t t = 0; t < failures.size(); ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                auto agent = index.membership_agent();
+                for (size_t user_bin_id = t; user_bin_id < number_of_user_bins; user_bin_id += 3u)
+                {
+                    auto const & result = agent.membership_for(query(user_bin_id), values_per_user_bin);
+                    failures[t] += !std::ranges::binary_search(result, user_bin_id);
+                }
+            });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    EXPECT_EQ(failures, std::vector<size_t>(failures.size()));
+    EXPECT_EQ(index.number_of_loaded_ibfs(), expected.ibf().ibf_vector.size());
+}
+
+TEST_F(lazy_hibf, previous_version)
+{
+    {
+        std::ofstream os{index_path, std::ios::binary};
+        cereal::BinaryOutputArchive oarchive{os};
+        oarchive(expected);
+    }
+
+    raptor::lazy_hibf index{};
+    index.load(index_path);
+    EXPECT_EQ(index.number_of_loaded_ibfs(), expected.ibf().ibf_vector.size());
+
+    auto agent = index.membership_agent();
+    auto const & result = agent.membership_for(query(42u), values_per_user_bin);
+    EXPECT_TRUE(std::ranges::binary_search(result, 42u));
+}
+
+TEST_F(lazy_hibf, compressed)
+{
+    raptor::write_index_container(index_path, expected, 2u, raptor::index_compression::lz4);
+
+    raptor::lazy_hibf index{};
+    index.load(index_path);
+    EXPECT_EQ(index.number_of_loaded_ibfs(), 1u);
+
+    auto agent = index.membership_agent();
+    auto const & result = agent.membership_for(query(42u), values_per_user_bin);
+    EXPECT_TRUE(std::ranges::binary_search(result, 42u));
+    EXPECT_LT(index.number_of_loaded_ibfs(), expected.ibf().ibf_vector.size());
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include <raptor/prepare/minimiser_counter.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct minimiser_counter : public ::testing::Test
+{
+    raptor::test::tmp_test_file tmp{};
+
+    // Many small values occur multiple times. One value occurs more than 254 times.
+    static std::vector<uint64_t> const & values()
+    {
+        static std::vector<uint64_t> const result = []()
+        {
+            std::mt19937_64 engine{42u};
+            std::uniform_int_distribution<uint64_t> distribution{0u, 5000u};
+            std::vector<uint64_t> result(20000u);
+            for (uint64_t & value : result)
+                value = engine() % 2u ? distribution(engine) : engine();
+            result.insert(result.end(), 300u, 23u);
+            std::ranges::shuffle(result, engine);
+            return result;
+        }();
+        return result;
+    }
+
+    static std::vector<uint64_t> expected(uint8_t const cutoff)
+    {
+        std::map<uint64_t, size_t> occurrences{};
+        for (uint64_t const value : values())
+            ++occurrences[value];
+
+        std::vector<uint64_t> result{};
+        for (auto const & [value, count] : occurrences)
+            if (count >= cutoff)
+                result.push_back(value);
+        return result;
+    }
+
+    std::vector<uint64_t> count(uint64_t const memory,
+                                uint8_t const cutoff,
+                                size_t & number_of_runs,
+                                size_t const max_fan_in = raptor::minimiser_counter::default_max_fan_in) const
+    {
+        raptor::minimiser_counter counter{tmp.path() / "test.run", memory, max_fan_in};
+        for (uint64_t const value : values())
+            counter.add(value);
+        number_of_runs = counter.number_of_runs();
+
+        std::vector<uint64_t> result{};
+        counter.for_each(cutoff,
+                         [&result](uint64_t const value)
+                         {
+                             result.push_back(value);
+                         });
+        return result;
+    }
+};
+
+TEST_F(minimiser_counter, in_memory)
+{
+    for (uint8_t const cutoff : {1u, 2u, 3u, 254u})
+    {
+        size_t number_of_runs{};
+        EXPECT_EQ(count(1ULL << 20, cutoff, number_of_runs), expected(cutoff)) << static_cast<int>(cutoff);
+        EXPECT_EQ(number_of_runs, 0u);
+    }
+}
+
+TEST_F(minimiser_counter, spill)
+{
+    for (uint8_t const cutoff : {1u, 2u, 3u, 254u})
+    {
+        size_t number_of_runs{};
+        EXPECT_EQ(count(8000u, cutoff, number_of_runs), expected(cutoff)) << static_cast<int>(cutoff);
+        EXPECT_EQ(number_of_runs, 20u); // 20300 values, 1000 per run
+    }
+
+    // Temporary files are removed.
+    EXPECT_TRUE(std::filesystem::is_empty(tmp.path()));
+}
+
+// More runs than are merged at once. The runs are merged in multiple passes.
+TEST_F(minimiser_counter, multi_pass_merge)
+{
+    for (size_t const max_fan_in : {2u, 3u, 7u})
+    {
+        for (uint8_t const cutoff : {1u, 2u, 254u})
+        {
+            size_t number_of_runs{};
+            EXPECT_EQ(count(8000u, cutoff, number_of_runs, max_fan_in), expected(cutoff))
+                << max_fan_in << ' ' << static_cast<int>(cutoff);
+            EXPECT_EQ(number_of_runs, 20u);
+        }
+    }
+
+    EXPECT_TRUE(std::filesystem::is_empty(tmp.path()));
+}
+
+TEST_F(minimiser_counter, empty)
+{
+    raptor::minimiser_counter counter{tmp.path() / "test.run", 0u};
+    size_t calls{};
+    counter.for_each(1u,
+                     [&calls](uint64_t const)
+                     {
+                         ++calls;
+                     });
+    EXPECT_EQ(calls, 0u);
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <raptor/minimiser_file.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct minimiser_file : public ::testing::Test
+{
+    raptor::test::tmp_test_file tmp{};
+
+    static std::vector<uint64_t> random_values(size_t const count)
+    {
+        std::mt19937_64 engine{count};
+        std::vector<uint64_t> result(count);
+        for (uint64_t & value : result)
+            value = engine();
+        // Include small differences, and the smallest and largest value.
+        if (count > 3u)
+        {
+            result[0] = 0u;
+            result[1] = 1u;
+            result[2] = std::numeric_limits<uint64_t>::max();
+        }
+        std::ranges::sort(result);
+        result.erase(std::ranges::unique(result).begin(), result.end());
+        return result;
+    }
+
+    static std::vector<uint64_t> read(raptor::minimiser_file_input & input, uint64_t const first, uint64_t const count)
+    {
+        std::vector<uint64_t> result{};
+        input.for_each(first,
+                       count,
+                       [&result](uint64_t const value)
+                       {
+                           result.push_back(value);
+                       });
+        return result;
+    }
+};
+
+TEST_F(minimiser_file, compressed)
+{
+    for (size_t const count : {0u, 1u, 4095u, 4096u, 4097u, 10000u})
+    {
+        std::vector<uint64_t> const values = random_values(count);
+        std::filesystem::path const path = tmp.path() / "test.minimiser";
+        raptor::write_minimiser_file(
+            path,
+            values,
+            {.shape = 0b1101u, .window_size = 23u, .cutoff = 3u, .sketch = raptor::sketch_kind::syncmer});
+
+        raptor::minimiser_file_input input{path};
+        ASSERT_TRUE(input.is_compressed());
+        EXPECT_EQ(input.size(), values.size());
+        EXPECT_EQ(input.header()->shape, 0b1101u);
+        EXPECT_EQ(input.header()->window_size, 23u);
+        EXPECT_EQ(input.header()->cutoff, 3u);
+        EXPECT_EQ(input.header()->sketch, raptor::sketch_kind::syncmer);
+        EXPECT_EQ(read(input, 0u, input.size()), values) << count;
+
+        // Ranges that start and end within blocks.
+        for (uint64_t const first : {0u, 1u, 4095u, 4096u, 5000u})
+        {
+            for (uint64_t const length : {0u, 1u, 4096u, 8192u})
+            {
+                size_t const begin = std::min<size_t>(first, values.size());
+                size_t const end = std::min<size_t>(first + length, values.size());
+                std::vector<uint64_t> const expected(values.begin() + begin, values.begin() + end);
+                EXPECT_EQ(read(input, first, length), expected) << count << ' ' << first << ' ' << length;
+            }
+        }
+    }
+}
+
+TEST_F(minimiser_file, smaller_than_raw)
+{
+    std::vector<uint64_t> const values = random_values(100000u);
+    std::filesystem::path const path = tmp.path() / "test.minimiser";
+    raptor::write_minimiser_file(path, values, {});
+    EXPECT_LT(std::filesystem::file_size(path), values.size() * sizeof(uint64_t));
+}
+
+// Version 2 has no sketch. Its values are minimisers.
+TEST_F(minimiser_file, previous_version)
+{
+    std::filesystem::path const path = tmp.path() / "previous.minimiser";
+    {
+        auto write = [](std::ofstream & stream, auto const value)
+        {
+            stream.write(reinterpret_cast<char const *>(&value), sizeof(value));
+        };
+        uint64_t const block_offset{raptor::minimiser_file_header::previous_size_in_bytes};
+        std::ofstream stream{path, std::ios::binary};
+        stream.write(raptor::minimiser_file_header::previous_magic.data(), 8u);
+        write(stream, uint64_t{1u});                // count
+        write(stream, uint64_t{0b111u});            // shape
+        write(stream, uint32_t{5u});                // window_size
+        write(stream, uint8_t{2u});                 // cutoff
+        write(stream, uint64_t{4096u});             // values_per_block
+        write(stream, uint64_t{1u});                // number_of_blocks
+        write(stream, uint64_t{block_offset + 8u}); // index_offset
+        write(stream, uint64_t{42u});               // The only block.
+        write(stream, block_offset);                // The block index.
+    }
+
+    raptor::minimiser_file_input input{path};
+    ASSERT_TRUE(input.is_compressed());
+    EXPECT_EQ(input.size(), 1u);
+    EXPECT_EQ(input.header()->shape, 0b111u);
+    EXPECT_EQ(input.header()->window_size, 5u);
+    EXPECT_EQ(input.header()->cutoff, 2u);
+    EXPECT_EQ(input.header()->sketch, raptor::sketch_kind::minimiser);
+    EXPECT_EQ(read(input, 0u, input.size()), (std::vector<uint64_t>{42u}));
+}
+
+TEST_F(minimiser_file, raw)
+{
+    std::vector<uint64_t> const values{42u, 7u, 1u, 42u, std::numeric_limits<uint64_t>::max()};
+    std::filesystem::path const path = tmp.path() / "raw.minimiser";
+    {
+        std::ofstream stream{path, std::ios::binary};
+        stream.write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(uint64_t));
+    }
+
+    raptor::minimiser_file_input input{path};
+    EXPECT_FALSE(input.is_compressed());
+    EXPECT_FALSE(input.header().has_value());
+    EXPECT_EQ(input.size(), values.size());
+    EXPECT_EQ(read(input, 0u, input.size()), values);
+    EXPECT_EQ(read(input, 1u, 2u), (std::vector<uint64_t>{7u, 1u}));
+    EXPECT_EQ(read(input, 4u, 10u), (std::vector<uint64_t>{std::numeric_limits<uint64_t>::max()}));
+
+    std::filesystem::path const empty = tmp.create("empty.minimiser");
+    raptor::minimiser_file_input empty_input{empty};
+    EXPECT_FALSE(empty_input.is_compressed());
+    EXPECT_EQ(empty_input.size(), 0u);
+}
+
+TEST_F(minimiser_file, does_not_exist)
+{
+    EXPECT_THROW(raptor::minimiser_file_input{"does_not_exist.minimiser"}, std::system_error);
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <raptor/build/partition_config.hpp>
+
+using raptor::hash_partitioning;
+using raptor::partition_config;
+
+// Indices of previous versions must still be searched with the same partitioning.
+TEST(partition_config, suffix)
+{
+    partition_config const two{2u, hash_partitioning::suffix};
+    EXPECT_EQ(two.hash_partition(0b0000u), 0u);
+    EXPECT_EQ(two.hash_partition(0b0001u), 0u);
+    EXPECT_EQ(two.hash_partition(0b0010u), 1u);
+    EXPECT_EQ(two.hash_partition(0b0111u), 1u);
+
+    partition_config const eight{8u, hash_partitioning::suffix};
+    EXPECT_EQ(eight.hash_partition(0b000001u), 0u);
+    EXPECT_EQ(eight.hash_partition(0b000010u), 1u);
+    EXPECT_EQ(eight.hash_partition(0b111110u), 7u);
+    EXPECT_EQ(eight.hash_partition(0b1000000u), 0u);
+}
+
+TEST(partition_config, balanced)
+{
+    for (size_t const parts : {1u, 2u, 4u, 8u, 128u})
+    {
+        partition_config const cfg{parts};
+        EXPECT_EQ(cfg.scheme, hash_partitioning::balanced);
+        std::mt19937_64 engine{0u};
+        for (size_t i = 0; i < 1000u; ++i)
+            EXPECT_LT(cfg.hash_partition(engine()), parts);
+    }
+}
+
+// Hashes that only differ in their high bits are all in the same part with the suffix partitioning.
+TEST(partition_config, balanced_load)
+{
+    size_t const parts{8u};
+    size_t const values{80'000u};
+    partition_config const suffix{parts, hash_partitioning::suffix};
+    partition_config const balanced{parts, hash_partitioning::balanced};
+    std::vector<size_t> suffix_counts(parts);
+    std::vector<size_t> balanced_counts(parts);
+
+    for (uint64_t i = 0; i < values; ++i)
+    {
+        uint64_t const hash = i << 16;
+        ++suffix_counts[suffix.hash_partition(hash)];
+        ++balanced_counts[balanced.hash_partition(hash)];
+    }
+
+    EXPECT_EQ(suffix_counts[0], values);
+    auto const [min, max] = std::ranges::minmax(balanced_counts);
+    EXPECT_GT(min, values / parts * 95u / 100u);
+    EXPECT_LT(max, values / parts * 105u / 100u);
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+
+#include <raptor/build/partition_spill.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct partition_spill : public ::testing::Test
+{
+    raptor::test::tmp_test_file tmp{};
+    std::vector<uint64_t> hashes = std::vector<uint64_t>(1000u);
+
+    void SetUp() override
+    {
+        std::iota(hashes.begin(), hashes.end(), 0u);
+    }
+};
+
+TEST_F(partition_spill, round_trip)
+{
+    raptor::partition_spill spill{tmp.path() / "raptor", 2u};
+    spill.write(0u, 3u, hashes);
+    spill.write(1u, 5u, std::span<uint64_t const>{hashes}.first(10u));
+    spill.write(1u, 6u, std::span<uint64_t const>{hashes}.last(10u));
+    spill.finish();
+
+    std::vector<uint64_t> bins{};
+    size_t count{};
+    spill.for_each_block(1u,
+                         1u,
+                         [&](uint64_t const bin, std::span<uint64_t const> const block)
+                         {
+                             bins.push_back(bin);
+                             count += block.size();
+                             std::span<uint64_t const> const expected{hashes.data() + (bin == 5u ? 0u : 990u), 10u};
+                             EXPECT_TRUE(std::ranges::equal(block, expected));
+                         });
+    EXPECT_EQ(bins, (std::vector<uint64_t>{5u, 6u}));
+    EXPECT_EQ(count, 20u);
+}
+
+// A truncated file must not be read as garbage.
+TEST_F(partition_spill, truncated)
+{
+    raptor::partition_spill spill{tmp.path() / "raptor", 1u};
+    spill.write(0u, 0u, hashes);
+    spill.write(0u, 1u, hashes);
+    spill.finish();
+
+    std::filesystem::path const file = tmp.path() / "raptor_0.spill";
+    uint64_t const size = std::filesystem::file_size(file);
+    auto noop = [](uint64_t const, std::span<uint64_t const> const) {};
+
+    // Within the hashes of the second block.
+    std::filesystem::resize_file(file, size - 8u);
+    EXPECT_THROW(spill.for_each_block(0u, 2u, noop), std::runtime_error);
+
+    // Within the header of the second block.
+    std::filesystem::resize_file(file, size / 2u + 4u);
+    EXPECT_THROW(spill.for_each_block(0u, 2u, noop), std::runtime_error);
+}
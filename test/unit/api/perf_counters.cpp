@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <raptor/perf_counters.hpp>
+
+TEST(perf_counters, disabled)
+{
+    raptor::perf_counter_group const group{false};
+    EXPECT_FALSE(group.is_available());
+
+    raptor::serial_perf_counters counters{group};
+    counters.start();
+    counters.stop();
+
+    raptor::concurrent_perf_counters total{};
+    total += counters;
+    for (size_t event = 0; event < raptor::perf_counter_group::number_of_events; ++event)
+    {
+        EXPECT_FALSE(total.is_available(event));
+        EXPECT_EQ(total.value(event), 0u);
+    }
+
+    std::stringstream values{};
+    total.write_values(values);
+    EXPECT_EQ(values.str(), "\tNA\tNA\tNA\tNA");
+}
+
+// The counters are not available in all environments, e.g., in containers or because of perf_event_paranoid.
+TEST(perf_counters, enabled)
+{
+    raptor::perf_counter_group const group{true};
+    raptor::serial_perf_counters counters{group};
+
+    uint64_t sum{};
+    counters.start();
+    for (uint64_t i = 0; i < 1'000'000u; ++i)
+        sum += i * i;
+    counters.stop();
+    EXPECT_GT(sum, 0u);
+
+    raptor::concurrent_perf_counters total{};
+    total += counters;
+    total += counters;
+    for (size_t event = 0; event < raptor::perf_counter_group::number_of_events; ++event)
+    {
+        EXPECT_EQ(total.is_available(event), group.is_available(event));
+        EXPECT_EQ(total.value(event), 2u * counters.value(event));
+    }
+
+    if (group.is_available(1u)) // instructions
+    {
+        EXPECT_GT(counters.value(1u), 0u);
+    }
+}
+
+TEST(perf_counters, copy_does_not_copy_values)
+{
+    raptor::perf_counter_group const group{true};
+    raptor::serial_perf_counters counters{group};
+    counters.start();
+    counters.stop();
+
+    raptor::concurrent_perf_counters total{};
+    total += counters;
+    raptor::concurrent_perf_counters const copy{total};
+    for (size_t event = 0; event < raptor::perf_counter_group::number_of_events; ++event)
+    {
+        EXPECT_FALSE(copy.is_available(event));
+        EXPECT_EQ(copy.value(event), 0u);
+    }
+}
+
+TEST(perf_counters, output)
+{
+    std::stringstream header{};
+    raptor::concurrent_perf_counters::write_header(header, "query_ibf");
+    EXPECT_EQ(header.str(), "\tquery_ibf_cycles\tquery_ibf_instructions\tquery_ibf_llc_misses\tquery_ibf_dtlb_misses");
+
+    raptor::concurrent_perf_counters const total{};
+    std::stringstream tree{};
+    total.print(tree, "  ");
+    EXPECT_EQ(tree.str(),
+              "  ├── Cycles: Not available\n"
+              "  ├── Instructions: Not available\n"
+              "  ├── LLC misses: Not available\n"
+              "  └── dTLB misses: Not available\n");
+}
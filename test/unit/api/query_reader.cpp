@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <seqan3/io/sequence_file/output.hpp>
+
+#include <raptor/dna4_traits.hpp>
+#include <raptor/search/query_reader.hpp>
+#include <raptor/test/cli_test.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct query_reader : public raptor_base
+{
+    using record_t = std::pair<std::string, std::vector<seqan3::dna4>>;
+
+    static std::vector<record_t> read_seqan3(std::filesystem::path const & path)
+    {
+        seqan3::sequence_file_input<raptor::dna4_traits, seqan3::fields<seqan3::field::id, seqan3::field::seq>> fin{
+            path};
+        std::vector<record_t> result{};
+        for (auto && [id, seq] : fin)
+            result.emplace_back(id, seq);
+        return result;
+    }
+
+    static std::vector<record_t> read_raptor(std::filesystem::path const & path, size_t const chunk_size)
+    {
+        raptor::query_reader reader{path, 4u};
+        std::vector<raptor::query_record> records{};
+        std::vector<record_t> result{};
+        while (reader.read_chunk(records, chunk_size))
+        {
+            EXPECT_LE(records.size(), chunk_size);
+            for (auto & [id, seq] : records)
+                result.emplace_back(id, seq);
+        }
+        return result;
+    }
+
+    void check(std::filesystem::path const & path) const
+    {
+        std::vector<record_t> const expected = read_seqan3(path);
+        ASSERT_FALSE(expected.empty());
+
+        for (size_t const chunk_size : {1u, 3u, 1024u})
+            EXPECT_EQ(read_raptor(path, chunk_size), expected) << path << " with chunk size " << chunk_size;
+    }
+
+    // Writes `input` to `output`. The compression is deduced from the extension of `output`.
+    static void convert(std::filesystem::path const & input, std::filesystem::path const & output)
+    {
+        seqan3::sequence_file_input<raptor::dna4_traits> fin{input};
+        seqan3::sequence_file_output fout{output};
+        for (auto && record : fin)
+            fout.push_back(record);
+    }
+};
+
+TEST_F(query_reader, fastq)
+{
+    check(data("query.fq"));
+}
+
+TEST_F(query_reader, fasta)
+{
+    check(data("multi_record_bin.fa"));
+}
+
+TEST_F(query_reader, gzip)
+{
+    check(data("bin1.fa.gz"));
+}
+
+TEST_F(query_reader, bgzf)
+{
+    raptor::test::tmp_test_file tmp{};
+    std::filesystem::path const bgzf_file = tmp.path() / "query.fq.bgzf";
+    convert(data("query.fq"), bgzf_file);
+    check(bgzf_file);
+}
+
+TEST_F(query_reader, multiline_fastq_crlf)
+{
+    using namespace seqan3::literals;
+
+    raptor::test::tmp_test_file tmp{};
+    std::filesystem::path const query_file =
+        tmp.create("query.fq", "@query1 a\r\nACGT\r\nAC\r\n+\r\n@III\r\nII\r\n\n@query2\nGGGG\n+query2\nIIII\n");
+    std::vector<record_t> const expected{{"query1 a", "ACGTAC"_dna4}, {"query2", "GGGG"_dna4}};
+    EXPECT_EQ(read_raptor(query_file, 1024u), expected);
+}
+
+TEST_F(query_reader, empty)
+{
+    raptor::query_reader reader{data("empty.fq"), 4u};
+    std::vector<raptor::query_record> records(5u);
+    EXPECT_FALSE(reader.read_chunk(records, 1024u));
+    EXPECT_TRUE(records.empty());
+}
+
+TEST_F(query_reader, invalid_character)
+{
+    raptor::test::tmp_test_file tmp{};
+    std::filesystem::path const query_file = tmp.create("query.fa", ">query\nAC!T\n");
+    raptor::query_reader reader{query_file, 4u};
+    std::vector<raptor::query_record> records{};
+    EXPECT_THROW(reader.read_chunk(records, 1024u), seqan3::parse_error);
+}
+
+TEST_F(query_reader, no_exist)
+{
+    EXPECT_THROW((raptor::query_reader{"does_not_exist.fq", 1u}), seqan3::file_open_error);
+}
+
+TEST_F(query_reader, sample_small_file)
+{
+    std::vector<uint64_t> expected{};
+    for (auto const & [id, seq] : read_seqan3(data("query_variance.fq")))
+        expected.push_back(seq.size());
+    std::ranges::sort(expected);
+
+    EXPECT_EQ(raptor::sample_query_lengths(data("query_variance.fq"), 4u), expected);
+}
+
+TEST_F(query_reader, sample_large_file)
+{
+    raptor::test::tmp_test_file tmp{};
+    std::filesystem::path const query_file = tmp.path() / "large.fq";
+    size_t const number_of_records{200'000u};
+    {
+        std::ofstream os{query_file};
+        for (size_t i = 0; i < number_of_records; ++i)
+        {
+            size_t const length = (i % 2u == 0u) ? 50u : 150u;
+            os << "@query" << i << '\n' << std::string(length, 'A') << "\n+\n" << std::string(length, '@') << '\n';
+        }
+    }
+
+    std::vector<uint64_t> const lengths = raptor::sample_query_lengths(query_file, 4u);
+    EXPECT_GT(lengths.size(), 1ULL << 16);
+    EXPECT_LT(lengths.size(), number_of_records);
+    EXPECT_TRUE(std::ranges::all_of(lengths,
+                                    [](uint64_t const length)
+                                    {
+                                        return length == 50u || length == 150u;
+                                    }));
+}
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/alphabet/views/complement.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+
+#include <raptor/sketch.hpp>
+
+static std::vector<seqan3::dna4> random_sequence(size_t const length)
+{
+    std::mt19937_64 engine{length};
+    std::vector<seqan3::dna4> result(length);
+    for (seqan3::dna4 & base : result)
+        base.assign_rank(engine() % 4u);
+    return result;
+}
+
+static std::vector<uint64_t> syncmers(raptor::syncmer_hash const & hash, std::vector<seqan3::dna4> const & sequence)
+{
+    std::vector<uint64_t> result{};
+    hash.for_each(sequence,
+                  [&result](uint64_t const value)
+                  {
+                      result.push_back(value);
+                  });
+    return result;
+}
+
+TEST(syncmer_hash, smer_size)
+{
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(19u, 23u), 14u); // 6 s-mers, density 1/3
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(19u, 22u), 14u); // 6 s-mers, rounded up from 5
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(32u, 40u), 23u); // 10 s-mers, density 1/5
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(20u, 20u), 19u); // 2 s-mers, all k-mers
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(15u, 40u), 2u);  // At most k - 1 s-mers, 14 s-mers
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(20u, 40u), 3u);  // 18 s-mers, rounded down from 19
+    EXPECT_EQ(raptor::syncmer_hash::smer_size(3u, 40u), 2u);   // 2 s-mers
+}
+
+TEST(syncmer_hash, short_sequence)
+{
+    raptor::syncmer_hash const hash{19u, 23u};
+    EXPECT_TRUE(syncmers(hash, random_sequence(18u)).empty());
+    EXPECT_TRUE(syncmers(hash, {}).empty());
+}
+
+// If the window size equals the k-mer size, all k-mers are syncmers. The values are those of the minimisers.
+TEST(syncmer_hash, all_kmers)
+{
+    std::vector<seqan3::dna4> const sequence = random_sequence(1000u);
+    raptor::syncmer_hash const hash{19u, 19u};
+    auto minimiser_view = sequence
+                        | seqan3::views::minimiser_hash(seqan3::ungapped{19u},
+                                                        seqan3::window_size{19u},
+                                                        seqan3::seed{raptor::adjust_seed(19u)});
+    std::vector<uint64_t> const expected(minimiser_view.begin(), minimiser_view.end());
+
+    EXPECT_EQ(syncmers(hash, sequence), expected);
+}
+
+TEST(syncmer_hash, reverse_complement)
+{
+    std::vector<seqan3::dna4> const sequence = random_sequence(10000u);
+    auto reverse_complement_view = sequence | std::views::reverse | seqan3::views::complement;
+    std::vector<seqan3::dna4> const reverse_complement(reverse_complement_view.begin(), reverse_complement_view.end());
+
+    for (uint32_t const window_size : {19u, 23u, 32u})
+    {
+        raptor::syncmer_hash const hash{19u, window_size};
+        std::vector<uint64_t> forward = syncmers(hash, sequence);
+        std::vector<uint64_t> reverse = syncmers(hash, reverse_complement);
+        std::ranges::sort(forward);
+        std::ranges::sort(reverse);
+        EXPECT_EQ(forward, reverse) << window_size;
+    }
+}
+
+// The density is that of minimisers for the same window size, 2 / (w - k + 2).
+TEST(syncmer_hash, density)
+{
+    std::vector<seqan3::dna4> const sequence = random_sequence(100000u);
+    size_t const number_of_kmers = sequence.size() - 32u + 1u;
+
+    for (uint32_t const window_size : {40u, 50u})
+    {
+        raptor::syncmer_hash const hash{32u, window_size};
+        double const density = static_cast<double>(syncmers(hash, sequence).size()) / number_of_kmers;
+        double const expected = 2.0 / (window_size - 32u + 2u);
+        EXPECT_NEAR(density, expected, 0.1 * expected) << window_size;
+    }
+}
+
+// With an odd k-mer size, w - k + 2 may be odd. The number of s-mers stays even, and the two middle positions differ.
+// Short s-mers are often equal. Then, multiple positions have the smallest s-mer, and the density is higher.
+TEST(syncmer_hash, density_odd_kmer_size)
+{
+    std::vector<seqan3::dna4> const sequence = random_sequence(100000u);
+    size_t const number_of_kmers = sequence.size() - 19u + 1u;
+
+    for (uint32_t const window_size : {22u, 26u, 40u})
+    {
+        raptor::syncmer_hash const hash{19u, window_size};
+        size_t const smers = 19u - hash.smer_size() + 1u;
+        EXPECT_EQ(smers % 2u, 0u) << window_size;
+        EXPECT_GE(hash.smer_size(), 2u) << window_size;
+
+        double const density = static_cast<double>(syncmers(hash, sequence).size()) / number_of_kmers;
+        double const expected = 2.0 / smers;
+        if (hash.smer_size() >= 8u)
+            EXPECT_NEAR(density, expected, 0.1 * expected) << window_size;
+        else
+            EXPECT_GE(density, 0.9 * expected) << window_size;
+    }
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <raptor/argument_parsing/compute_bin_size.hpp>
+#include <raptor/build/sketch_cache.hpp>
+#include <raptor/test/cli_test.hpp>
+#include <raptor/test/tmp_test_file.hpp>
+
+struct sketch_cache : public raptor_base
+{
+    raptor::test::tmp_test_file tmp{};
+
+    std::filesystem::path cache_directory() const
+    {
+        return tmp.path() / "cache";
+    }
+
+    static raptor::sketch_cache::entry make_entry(size_t const partitions)
+    {
+        raptor::sketch_cache::entry result{
+            .sketches = std::vector<seqan::hibf::sketch::hyperloglog>(partitions, raptor::sketch_cache::sketch_bits),
+            .exact_counts = std::vector<uint64_t>(partitions, raptor::sketch_cache::unknown_count)};
+
+        for (size_t i = 0; i < partitions; ++i)
+            for (uint64_t value = 0; value < 100u * (i + 1u); ++value)
+                result.sketches[i].add(value * (i + 1u));
+
+        return result;
+    }
+};
+
+TEST_F(sketch_cache, disabled)
+{
+    raptor::sketch_cache const cache{};
+    std::vector<std::string> const user_bin{data("bin1.fa")};
+
+    EXPECT_FALSE(cache.is_enabled());
+    cache.store(user_bin, make_entry(1u));
+    EXPECT_FALSE(cache.load(user_bin).has_value());
+}
+
+TEST_F(sketch_cache, roundtrip)
+{
+    raptor::sketch_cache const cache{cache_directory(), seqan3::ungapped{19u}, 23u, raptor::partition_config{4u}};
+    std::vector<std::string> const user_bin{data("bin1.fa"), data("bin2.fa")};
+
+    EXPECT_TRUE(cache.is_enabled());
+    EXPECT_TRUE(std::filesystem::is_directory(cache_directory()));
+    EXPECT_FALSE(cache.load(user_bin).has_value());
+
+    raptor::sketch_cache::entry expected = make_entry(4u);
+    expected.exact_counts[2] = 42u;
+    cache.store(user_bin, expected);
+
+    std::optional<raptor::sketch_cache::entry> const loaded = cache.load(user_bin);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->sketches.size(), 4u);
+    for (size_t i = 0; i < 4u; ++i)
+        EXPECT_EQ(loaded->sketches[i].estimate(), expected.sketches[i].estimate());
+    EXPECT_EQ(loaded->exact_counts, expected.exact_counts);
+
+    // The order of the files matters.
+    EXPECT_FALSE(cache.load({data("bin2.fa"), data("bin1.fa")}).has_value());
+}
+
+TEST_F(sketch_cache, parameters)
+{
+    std::vector<std::string> const user_bin{data("bin1.fa")};
+    raptor::sketch_cache const cache{cache_directory(), seqan3::ungapped{19u}, 23u, raptor::partition_config{1u}};
+    cache.store(user_bin, make_entry(1u));
+    ASSERT_TRUE(cache.load(user_bin).has_value());
+
+    auto load = [&](seqan3::shape const & shape, uint32_t const window_size, raptor::partition_config const & cfg)
+    {
+        return raptor::sketch_cache{cache_directory(), shape, window_size, cfg}.load(user_bin).has_value();
+    };
+
+    EXPECT_FALSE(load(seqan3::ungapped{20u}, 23u, raptor::partition_config{1u}));
+    EXPECT_FALSE(load(seqan3::ungapped{19u}, 24u, raptor::partition_config{1u}));
+    EXPECT_FALSE(load(seqan3::ungapped{19u}, 23u, raptor::partition_config{2u}));
+    EXPECT_FALSE(load(seqan3::bin_literal{0b1101}, 23u, raptor::partition_config{1u}));
+    // With a single partition, the partitioning does not matter.
+    EXPECT_TRUE(load(seqan3::ungapped{19u}, 23u, raptor::partition_config{1u, raptor::hash_partitioning::suffix}));
+}
+
+// The counts per partition depend on the partitioning.
+TEST_F(sketch_cache, partitioning)
+{
+    using raptor::hash_partitioning;
+    std::vector<std::string> const user_bin{data("bin1.fa")};
+    raptor::partition_config const balanced{2u, hash_partitioning::balanced};
+    raptor::partition_config const suffix{2u, hash_partitioning::suffix};
+    raptor::sketch_cache const balanced_cache{cache_directory(), seqan3::ungapped{19u}, 23u, balanced};
+    raptor::sketch_cache const suffix_cache{cache_directory(), seqan3::ungapped{19u}, 23u, suffix};
+
+    balanced_cache.store(user_bin, make_entry(2u));
+    EXPECT_TRUE(balanced_cache.load(user_bin).has_value());
+    EXPECT_FALSE(suffix_cache.load(user_bin).has_value());
+
+    suffix_cache.store(user_bin, make_entry(2u));
+    EXPECT_TRUE(suffix_cache.load(user_bin).has_value());
+    EXPECT_EQ(std::ranges::distance(std::filesystem::directory_iterator{cache_directory()}), 2);
+}
+
+TEST_F(sketch_cache, modified_file)
+{
+    std::filesystem::path const file = tmp.create("bin.fa", ">seq\nACGTACGTACGTACGTACGTACGTACGT\n");
+    std::vector<std::string> const user_bin{file.string()};
+    raptor::sketch_cache const cache{cache_directory(), seqan3::ungapped{19u}, 23u, raptor::partition_config{1u}};
+
+    cache.store(user_bin, make_entry(1u));
+    ASSERT_TRUE(cache.load(user_bin).has_value());
+
+    {
+        std::ofstream stream{file, std::ios::app};
+        stream << ">seq2\nTTTTTTTTTTTTTTTTTTTTTTTTT\n";
+    }
+    EXPECT_FALSE(cache.load(user_bin).has_value());
+}
+
+TEST_F(sketch_cache, corrupted_file)
+{
+    std::vector<std::string> const user_bin{data("bin1.fa")};
+    raptor::sketch_cache const cache{cache_directory(), seqan3::ungapped{19u}, 23u, raptor::partition_config{1u}};
+    cache.store(user_bin, make_entry(1u));
+
+    ASSERT_EQ(std::ranges::distance(std::filesystem::directory_iterator{cache_directory()}), 1);
+    std::filesystem::path const entry_file = std::filesystem::directory_iterator{cache_directory()}->path();
+    std::filesystem::resize_file(entry_file, std::filesystem::file_size(entry_file) / 2u);
+
+    EXPECT_FALSE(cache.load(user_bin).has_value());
+}
+
+TEST_F(sketch_cache, compute_bin_size)
+{
+    raptor::build_arguments const config{.bin_path = {{data("multi_record_bin.fa")}, {data("bin3.fa")}},
+                                         .sketch_cache_dir = cache_directory()};
+
+    EXPECT_EQ(raptor::compute_bin_size(config), 3794u); // exact count = 480, exact size = 3794
+    EXPECT_EQ(std::ranges::distance(std::filesystem::directory_iterator{cache_directory()}), 2);
+    // The second run uses the cached sketches and exact count.
+    EXPECT_EQ(raptor::compute_bin_size(config), 3794u);
+}
@@ -127,6 +127,30 @@ TEST(minimiser, logspace_substract)
         EXPECT_EQ(threshold.get(i), expected[i - 12u]) << i;
 }
 
+// Syncmers are not affected indirectly, hence the thresholds do not depend on a simulation.
+TEST(syncmer, with_error)
+{
+    auto threshold_params = default_parameters;
+    threshold_params.window_size = 23u;
+    threshold_params.shape = seqan3::ungapped{19u};
+    threshold_params.sketch = raptor::sketch_kind::syncmer;
+    threshold_params.errors = 1u;
+    raptor::threshold::threshold threshold{threshold_params};
+    size_t const max_count{231u}; // 250 - 19
+
+    EXPECT_EQ(threshold_params.minimal_number_of_minimisers(), 1u);
+    EXPECT_EQ(threshold_params.maximal_number_of_minimisers(), max_count);
+    EXPECT_EQ(threshold.get(0u), threshold.get(1u));
+    EXPECT_EQ(threshold.get(max_count), threshold.get(1000u));
+    EXPECT_EQ(threshold.get(80u), 70u);
+    EXPECT_EQ(threshold.get(200u), 190u);
+    EXPECT_EQ(threshold.get(max_count), 221u);
+
+    // One error affects at most k syncmers.
+    for (size_t i = 1u; i <= max_count; ++i)
+        EXPECT_GE(threshold.get(i) + 19u, i) << i;
+}
+
 TEST(percentage, 100)
 {
     auto threshold_params = default_parameters;
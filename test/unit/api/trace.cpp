@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <raptor/test/tmp_test_file.hpp>
+#include <raptor/trace.hpp>
+
+static std::string read_trace(std::filesystem::path const & path)
+{
+    std::ifstream input{path};
+    std::stringstream buffer{};
+    buffer << input.rdbuf();
+    return buffer.str();
+}
+
+// Tracing cannot be disabled once enabled. Hence, there is only one test that enables it.
+TEST(trace, record_and_write)
+{
+    raptor::test::tmp_test_file tmp{};
+
+    {
+        raptor::trace_scope const disabled{"Disabled", "test"};
+    }
+
+    raptor::enable_tracing();
+
+    {
+        raptor::trace_scope stage{"Stage", "test"};
+        std::thread worker{[]()
+                           {
+                               raptor::trace_scope const chunk{"Chunk", "worker", "start", 4u, "extent", 2u};
+                           }};
+        worker.join(); // The events of the thread are kept after it exits.
+        stage.stop();
+        stage.stop(); // No effect.
+    }
+
+    std::filesystem::path const trace_file = tmp.path() / "trace.json";
+    raptor::write_trace(trace_file);
+    std::string const trace = read_trace(trace_file);
+
+    EXPECT_TRUE(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")) << trace;
+    EXPECT_TRUE(trace.ends_with("]}\n")) << trace;
+    EXPECT_EQ(trace.find("Disabled"), std::string::npos) << trace;
+    EXPECT_NE(trace.find(R"("args":{"name":"main"})"), std::string::npos) << trace;
+    EXPECT_NE(trace.find(R"("args":{"name":"thread 2"})"), std::string::npos) << trace;
+    EXPECT_NE(trace.find(R"({"name":"Stage","cat":"test","ph":"X","pid":1,"tid":1,)"), std::string::npos) << trace;
+    EXPECT_NE(trace.find(R"({"name":"Chunk","cat":"worker","ph":"X","pid":1,"tid":2,)"), std::string::npos) << trace;
+    EXPECT_NE(trace.find(R"("args":{"start":4,"extent":2}})"), std::string::npos) << trace;
+
+    size_t events{};
+    for (size_t position = trace.find("\"ph\":\"X\""); position != std::string::npos;
+         position = trace.find("\"ph\":\"X\"", position + 1u))
+        ++events;
+    EXPECT_EQ(events, 2u);
+}
@@ -9,6 +9,8 @@
 
 struct argparse_build : public raptor_base
 {};
+struct argparse_info : public raptor_base
+{};
 struct argparse_main : public raptor_base
 {};
 struct argparse_search : public raptor_base
@@ -55,9 +57,12 @@ TEST_F(argparse_build, no_options)
     cli_test_result const result = execute_app("raptor", "build");
     std::string const expected{
         "Raptor-build - Constructs a Raptor index\n========================================\n"
-        "    raptor build --input <file> --output <file> [--threads <number>] [--quiet]\n    [--kmer <numb"
-        "er>|--shape <01-pattern>] [--window <number>] [--fpr\n    <number>] [--hash <number>] [--parts <number>]\n   "
-        " Try -h or --help for more information.\n"};
+        "    raptor build --input <file> --output <file> [--threads <number>] [--quiet]\n"
+        "    [--kmer <number>|--shape <01-pattern>] [--window <number>] [--sketch\n"
+        "    minimiser|syncmer] [--fpr <number>] [--hash <number>] [--blocked]\n"
+        "    [--compress none|lz4|zstd] [--parts <number>] [--bin-range <A:B>]\n"
+        "    [--memory-limit <number>] [--checkpoint-interval <seconds>] [--resume]\n"
+        "    Try -h or --help for more information.\n"};
     EXPECT_EQ(result.out, expected);
     EXPECT_EQ(result.err, std::string{});
     RAPTOR_ASSERT_ZERO_EXIT(result);
@@ -76,11 +81,31 @@ TEST_F(argparse_search, no_options)
     RAPTOR_ASSERT_ZERO_EXIT(result);
 }
 
+TEST_F(argparse_info, no_options)
+{
+    cli_test_result const result = execute_app("raptor", "info");
+    std::string const expected{
+        "Raptor-info - Prints information about a Raptor index\n=====================================================\n"
+        "    raptor info --index <file>\n"
+        "    Try -h or --help for more information.\n"};
+    EXPECT_EQ(result.out, expected);
+    EXPECT_EQ(result.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result);
+}
+
+TEST_F(argparse_info, index_missing)
+{
+    cli_test_result const result = execute_app("raptor", "info", "--index", "foo.index");
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] The file \"foo.index\" does not exist!\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
 TEST_F(argparse_main, no_subparser)
 {
     cli_test_result const result = execute_app("raptor", "foo");
     std::string const expected{"[Error] You specified an unknown subcommand! Available subcommands are: "
-                               "[build, layout, prepare, search, update, upgrade]. "
+                               "[build, info, layout, merge, prepare, search, update, upgrade]. "
                                "Use -h/--help for more information.\n"};
     EXPECT_EQ(result.out, std::string{});
     EXPECT_EQ(result.err, expected);
@@ -181,6 +206,34 @@ TEST_F(argparse_build, kmer_shape)
     RAPTOR_ASSERT_FAIL_EXIT(result);
 }
 
+TEST_F(argparse_build, sketch_gapped_shape)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--shape 11011",
+                                               "--sketch syncmer",
+                                               "--output index.raptor",
+                                               "--input",
+                                               tmp_bin_list_file);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] --sketch syncmer requires an ungapped shape.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
+TEST_F(argparse_build, sketch_small_kmer)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--kmer 2",
+                                               "--sketch syncmer",
+                                               "--output index.raptor",
+                                               "--input",
+                                               tmp_bin_list_file);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] --sketch syncmer requires a k-mer size of at least 3.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
 TEST_F(argparse_build, zero_threads)
 {
     cli_test_result const result = execute_app("raptor",
@@ -264,6 +317,67 @@ TEST_F(argparse_build, partitioned_parts)
     RAPTOR_ASSERT_FAIL_EXIT(result);
 }
 
+TEST_F(argparse_build, memory_limit_hibf)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--memory-limit 1024",
+                                               "--output index.raptor",
+                                               "--input",
+                                               data("three_levels.layout"));
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] --memory-limit is not available for the HIBF.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
+TEST_F(argparse_build, checkpoint_partitioned)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--kmer 20",
+                                               "--parts 2",
+                                               "--resume",
+                                               "--output index.raptor",
+                                               "--input",
+                                               tmp_bin_list_file);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err,
+              std::string{"[Error] --checkpoint-interval and --resume are only available for unpartitioned IBFs.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
+TEST_F(argparse_build, blocked_partitioned)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--kmer 20",
+                                               "--parts 2",
+                                               "--blocked",
+                                               "--output index.raptor",
+                                               "--input",
+                                               tmp_bin_list_file);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err,
+              std::string{"[Error] --blocked is only available for unpartitioned IBFs and cannot be combined with "
+                          "--memory-limit, --bin-range, --checkpoint-interval, or --resume.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
+TEST_F(argparse_build, compress_bin_range)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "build",
+                                               "--kmer 20",
+                                               "--compress zstd",
+                                               "--bin-range 0:1",
+                                               "--output index.raptor",
+                                               "--input",
+                                               tmp_bin_list_file);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] --compress cannot be combined with --bin-range.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
 TEST_F(argparse_build, minimiser_and_shape)
 {
     cli_test_result const result =
@@ -291,6 +405,15 @@ TEST_F(argparse_build, minimiser_and_window)
     RAPTOR_ASSERT_FAIL_EXIT(result);
 }
 
+TEST_F(argparse_build, minimiser_and_sketch)
+{
+    cli_test_result const result =
+        execute_app("raptor", "build", "--sketch syncmer", "--output index.raptor", "--input", minimiser_list);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] You cannot set --sketch when using minimiser files as input.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
 TEST_F(argparse_build, layout_and_kmer)
 {
     cli_test_result const result =
@@ -312,12 +435,7 @@ TEST_F(argparse_build, layout_and_window)
     RAPTOR_ASSERT_ZERO_EXIT(result);
 
     raptor::raptor_index<raptor::index_structure::hibf> index{};
-
-    {
-        std::ifstream is{"index.raptor", std::ios::binary};
-        cereal::BinaryInputArchive iarchive{is};
-        iarchive(index);
-    }
+    raptor::read_index_container(index, "index.raptor", 1u);
 
     EXPECT_EQ(index.window_size(), 28u);
     EXPECT_EQ(index.shape(), seqan3::shape{seqan3::ungapped{19u}});
@@ -473,6 +591,21 @@ TEST_F(argparse_search, error_treshold)
     RAPTOR_ASSERT_FAIL_EXIT(result);
 }
 
+TEST_F(argparse_search, lazy_load_ibf)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "search",
+                                               "--query ",
+                                               data("query.fq"),
+                                               "--index ",
+                                               data("1bins23window.index"),
+                                               "--lazy-load",
+                                               "--output search.out");
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{"[Error] --lazy-load is only available for HIBF indices.\n"});
+    RAPTOR_ASSERT_FAIL_EXIT(result);
+}
+
 TEST_F(argparse_search, empty_query)
 {
     cli_test_result const result = execute_app("raptor",
@@ -575,9 +708,12 @@ TEST_F(argparse_prepare, no_options)
     std::string const expected{
         "Raptor-prepare - Computes minimisers for the use with raptor layout and raptor "
         "build\n====================================================================================\n"
-        "    raptor prepare --input <file> --output <directory> [--threads <number>]\n    [--quiet] [-"
-        "-kmer <number>|--shape <01-pattern>] [--window <number>]\n    [--kmer-count-cutoff <number>|--use-filesize-de"
-        "pendent-cutoff]\n    Try -h or --help for more information.\n"};
+        "    raptor prepare --input <file> --output <directory> [--threads <number>]\n"
+        "    [--quiet] [--kmer <number>|--shape <01-pattern>] [--window <number>]\n"
+        "    [--sketch minimiser|syncmer] [--kmer-count-cutoff\n"
+        "    <number>|--use-filesize-dependent-cutoff] [--counting-memory <number>]\n"
+        "    [--memory-limit <number>]\n"
+        "    Try -h or --help for more information.\n"};
     EXPECT_EQ(result.out, expected);
     EXPECT_EQ(result.err, std::string{});
     RAPTOR_ASSERT_ZERO_EXIT(result);
@@ -92,10 +92,8 @@ TEST_F(build_hibf_layout, pipeline)
     }
 
     {
-        std::ifstream index_file{index_filename + '_' + std::to_string(counter)};
-        cereal::BinaryInputArchive archive{index_file};
         raptor::raptor_index<raptor::index_structure::hibf> index;
-        archive(index);
+        raptor::read_index_container(index, index_filename + '_' + std::to_string(counter), 1u);
         raptor::dump_index(index);
         // for (auto & ibf : index.ibf().ibf_vector)
         // {
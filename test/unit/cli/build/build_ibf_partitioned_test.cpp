@@ -136,6 +136,93 @@ TEST_F(build_ibf_partitioned, pipeline_misc)
     compare_search(16, 1, "search2.out", is_empty::yes);
 }
 
+TEST_F(build_ibf_partitioned, spill_parts)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(16))
+            file << file_path << '\n';
+    }
+
+    auto build = [this](std::string const & output, auto &&... additional_arguments)
+    {
+        return execute_app("raptor",
+                           "build",
+                           "--kmer 19",
+                           "--window 23",
+                           "--output",
+                           output,
+                           "--threads 2",
+                           "--parts 4",
+                           "--quiet",
+                           additional_arguments...,
+                           "--input",
+                           "raptor_cli_test.txt");
+    };
+
+    cli_test_result const result1 = build("in_memory.index");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = build("spill.index", "--spill-parts");
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    for (size_t part = 0; part < 4u; ++part)
+    {
+        std::string const suffix = "_" + std::to_string(part);
+        EXPECT_EQ(string_from_file("in_memory.index" + suffix, std::ios::binary),
+                  string_from_file("spill.index" + suffix, std::ios::binary))
+            << "part " << part;
+        EXPECT_FALSE(std::filesystem::exists("spill.index" + suffix + ".spill"));
+    }
+}
+
+TEST_F(build_ibf_partitioned, memory_limit)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(128))
+            file << file_path << '\n';
+    }
+
+    // With 512 user bins and an FPR of 0.0001, the unpartitioned index needs more than 1 MiB.
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--fpr 0.0001",
+                                                "--output raptor.index",
+                                                "--threads 2",
+                                                "--memory-limit 1",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+    EXPECT_FALSE(std::filesystem::exists("raptor.index"));
+    EXPECT_TRUE(std::filesystem::exists("raptor.index_0"));
+    EXPECT_TRUE(std::filesystem::exists("raptor.index_1"));
+
+    cli_test_result const result2 = execute_app("raptor",
+                                                "search",
+                                                "--output search.out",
+                                                "--error 1",
+                                                "--index ",
+                                                "raptor.index",
+                                                "--quiet",
+                                                "--query ",
+                                                data("query.fq"));
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    compare_search(128, 1, "search.out");
+}
+
 INSTANTIATE_TEST_SUITE_P(
     build_ibf_partitioned_suite,
     build_ibf_partitioned,
@@ -105,3 +105,174 @@ TEST_F(build_ibf, verbose)
 
     compare_index(ibf_path(16, 19), "raptor.index");
 }
+
+TEST_F(build_ibf, checkpoint)
+{
+    { // generate input file
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(16u))
+            file << file_path << '\n';
+        file << '\n';
+    }
+
+    auto build = [this](auto &&... additional_arguments)
+    {
+        return execute_app("raptor",
+                           "build",
+                           "--kmer 19",
+                           "--window 19",
+                           "--threads 2",
+                           "--output raptor.index",
+                           "--quiet",
+                           additional_arguments...,
+                           "--input",
+                           "raptor_cli_test.txt");
+    };
+
+    cli_test_result const result1 = build("--checkpoint-interval 1", "--resume");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+    EXPECT_FALSE(std::filesystem::exists("raptor.index.checkpoint"));
+    compare_index(ibf_path(16, 19), "raptor.index");
+
+    // A checkpoint that does not match the input is not used.
+    {
+        std::ofstream file{"raptor.index.checkpoint"};
+        file << "RAPTOR_BUILD_CHECKPOINT_1\n";
+    }
+    cli_test_result const result2 = build("--resume");
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_NE(result2.err, std::string{});
+    EXPECT_NE(result2.exit_code, 0);
+}
+
+TEST_F(build_ibf, blocked)
+{
+    { // generate input file
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(16u))
+            file << file_path << '\n';
+        file << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--threads 2",
+                                                "--blocked",
+                                                "--output raptor.index",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    {
+        raptor::raptor_index<raptor::index_structure::blocked_ibf> index{};
+        raptor::read_index_container(index, "raptor.index", 1u);
+        EXPECT_TRUE(index.is_blocked_ibf());
+        EXPECT_FALSE(index.is_hibf());
+        EXPECT_EQ(index.ibf().bin_count(), 64u);
+    }
+
+    cli_test_result const result2 = execute_app("raptor",
+                                                "search",
+                                                "--output search.out",
+                                                "--error 1",
+                                                "--index raptor.index",
+                                                "--quiet",
+                                                "--query",
+                                                data("query.fq"));
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    compare_search(16, 1, "search.out");
+}
+
+TEST_F(build_ibf, compressed)
+{
+    { // generate input file
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(16u))
+            file << file_path << '\n';
+        file << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 19",
+                                                "--threads 2",
+                                                "--compress zstd",
+                                                "--output raptor.index",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+    EXPECT_EQ(raptor::read_index_compression("raptor.index"), raptor::index_compression::zstd);
+    compare_index(ibf_path(16, 19), "raptor.index");
+
+    cli_test_result const result2 = execute_app("raptor",
+                                                "search",
+                                                "--output search.out",
+                                                "--error 1",
+                                                "--threads 2",
+                                                "--index raptor.index",
+                                                "--quiet",
+                                                "--query",
+                                                data("query.fq"));
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    compare_search(16, 1, "search.out");
+}
+
+TEST_F(build_ibf, syncmer)
+{
+    { // generate input file
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(16u))
+            file << file_path << '\n';
+        file << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--sketch syncmer",
+                                                "--threads 2",
+                                                "--output raptor.index",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    raptor::raptor_index<> index{};
+    raptor::read_index_parameters(index, "raptor.index");
+    EXPECT_EQ(index.sketch(), raptor::sketch_kind::syncmer);
+    EXPECT_EQ(index.window_size(), 23u);
+
+    // The search reads the sketch from the index.
+    cli_test_result const result2 = execute_app("raptor",
+                                                "search",
+                                                "--output search.out",
+                                                "--error 1",
+                                                "--index raptor.index",
+                                                "--quiet",
+                                                "--query",
+                                                data("query.fq"));
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+    EXPECT_GT(std::filesystem::file_size("search.out"), 0u);
+}
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <raptor/test/cli_test.hpp>
+
+struct info : public raptor_base
+{};
+
+TEST_F(info, ibf)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(4))
+            file << file_path << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--output raptor.index",
+                                                "--threads 1",
+                                                "--quiet",
+                                                "--compress lz4",
+                                                "--input raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = execute_app("raptor", "info", "--index raptor.index");
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    raptor::raptor_index<raptor::index_structure::ibf> index{};
+    raptor::read_index_container(index, "raptor.index", 1u);
+    std::string const bits = std::to_string(index.ibf().bit_size());
+
+    for (std::string_view const expected : {"Type: IBF\n",
+                                            "Compression: lz4\n",
+                                            "Shape: 1111111111111111111\n",
+                                            "Window size: 23\n",
+                                            "Sketch: minimiser\n",
+                                            "Parts: 1\n",
+                                            "Hash functions: 2\n",
+                                            "False positive rate: 0.05\n",
+                                            "User bins: 16\n",
+                                            "IBFs: 1\n",
+                                            "#PART\tIBF\tLEVEL\tBINS\tBITS\tSET_BITS\tOCCUPANCY\n"})
+        EXPECT_NE(result2.out.find(expected), std::string::npos) << expected;
+    EXPECT_NE(result2.out.find("0\t0\t0\t16\t" + bits + '\t'), std::string::npos);
+    // The partitioning is only printed for multiple parts.
+    EXPECT_EQ(result2.out.find("Partitioning:"), std::string::npos);
+}
+
+TEST_F(info, partitioned)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(4))
+            file << file_path << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--parts 2",
+                                                "--output raptor.index",
+                                                "--threads 1",
+                                                "--quiet",
+                                                "--input raptor_cli_test.txt");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = execute_app("raptor", "info", "--index raptor.index");
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+    EXPECT_NE(result2.out.find("Parts: 2\nPartitioning: balanced\n"), std::string::npos);
+}
+
+TEST_F(info, hibf)
+{
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 19",
+                                                "--threads 1",
+                                                "--output raptor.index",
+                                                "--quiet",
+                                                "--input",
+                                                data("three_levels.layout"));
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = execute_app("raptor", "info", "--index raptor.index");
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    std::optional<raptor::index_metadata> const metadata = raptor::read_index_metadata("raptor.index");
+    ASSERT_TRUE(metadata.has_value());
+    EXPECT_NE(result2.out.find("Type: HIBF\n"), std::string::npos);
+    EXPECT_NE(result2.out.find("IBFs: " + std::to_string(metadata->ibfs.size()) + '\n'), std::string::npos);
+    // One line per IBF and the header.
+    EXPECT_EQ(std::ranges::count(result2.out, '\t'), 6u * (metadata->ibfs.size() + 1u));
+    EXPECT_EQ(std::ranges::max(metadata->ibfs, {}, &raptor::index_metadata::ibf_type::level).level, 2u);
+}
+
+TEST_F(info, previous_version)
+{
+    cli_test_result const result = execute_app("raptor", "info", "--index", ibf_path(16, 23));
+    EXPECT_EQ(result.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result);
+    EXPECT_NE(result.out.find("Window size: 23\n"), std::string::npos);
+    EXPECT_NE(result.out.find("User bins: 16\n"), std::string::npos);
+    EXPECT_NE(result.out.find("The index was built by a previous version of Raptor."), std::string::npos);
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2006-2026 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2026 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <raptor/test/cli_test.hpp>
+
+struct merge_ibf : public raptor_base, public testing::WithParamInterface<size_t>
+{};
+
+TEST_P(merge_ibf, same_as_build)
+{
+    size_t const parts = GetParam();
+
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(4))
+            file << file_path << '\n';
+    }
+
+    auto build = [this, parts](std::string const & output, auto &&... additional_arguments)
+    {
+        return execute_app("raptor",
+                           "build",
+                           "--kmer 19",
+                           "--window 23",
+                           "--output",
+                           output,
+                           "--threads 2",
+                           "--parts",
+                           std::to_string(parts),
+                           "--quiet",
+                           additional_arguments...,
+                           "--input",
+                           "raptor_cli_test.txt");
+    };
+
+    cli_test_result const result1 = build("raptor.index");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = build("shard_0.index", "--bin-range 0:5");
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    cli_test_result const result3 = build("shard_1.index", "--bin-range 5:16");
+    EXPECT_EQ(result3.out, std::string{});
+    EXPECT_EQ(result3.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result3);
+
+    cli_test_result const result4 = execute_app("raptor",
+                                                "merge",
+                                                "--input shard_0.index",
+                                                "--input shard_1.index",
+                                                "--output merged.index",
+                                                "--threads 2",
+                                                "--quiet");
+    EXPECT_EQ(result4.out, std::string{});
+    EXPECT_EQ(result4.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result4);
+
+    if (parts == 1u)
+    {
+        EXPECT_EQ(string_from_file("raptor.index", std::ios::binary),
+                  string_from_file("merged.index", std::ios::binary));
+        return;
+    }
+
+    for (size_t part = 0; part < parts; ++part)
+    {
+        std::string const suffix = "_" + std::to_string(part);
+        EXPECT_EQ(string_from_file("raptor.index" + suffix, std::ios::binary),
+                  string_from_file("merged.index" + suffix, std::ios::binary))
+            << "part " << part;
+    }
+}
+
+TEST_F(merge_ibf, different_parameters)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(4))
+            file << file_path << '\n';
+    }
+
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--output shard_0.index",
+                                                "--bin-range 0:8",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 23",
+                                                "--hash 3",
+                                                "--output shard_1.index",
+                                                "--bin-range 8:16",
+                                                "--quiet",
+                                                "--input",
+                                                "raptor_cli_test.txt");
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    cli_test_result const result3 = execute_app("raptor",
+                                                "merge",
+                                                "--input shard_0.index",
+                                                "--input shard_1.index",
+                                                "--output merged.index",
+                                                "--quiet");
+    EXPECT_EQ(result3.out, std::string{});
+    EXPECT_NE(result3.err, std::string{});
+    EXPECT_NE(result3.exit_code, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(merge_ibf_suite,
+                         merge_ibf,
+                         testing::Values(1, 2),
+                         [](testing::TestParamInfo<merge_ibf::ParamType> const & info)
+                         {
+                             return std::to_string(info.param) + "_parts";
+                         });
@@ -100,3 +100,34 @@ TEST_F(search_hibf, three_levels)
 
     compare_search(32, 0, "search.out");
 }
+
+TEST_F(search_hibf, lazy_load)
+{
+    cli_test_result const result1 = execute_app("raptor",
+                                                "build",
+                                                "--kmer 19",
+                                                "--window 19",
+                                                "--output raptor.index",
+                                                "--quiet",
+                                                "--input",
+                                                data("three_levels.layout"));
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    cli_test_result const result2 = execute_app("raptor",
+                                                "search",
+                                                "--output search.out",
+                                                "--error 0",
+                                                "--index raptor.index",
+                                                "--lazy-load",
+                                                "--threads 2",
+                                                "--quiet",
+                                                "--query ",
+                                                data("query.fq"));
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    compare_search(32, 0, "search.out");
+}
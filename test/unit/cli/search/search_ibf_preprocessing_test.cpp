@@ -151,6 +151,62 @@ TEST_P(search_ibf_preprocessing, pipeline_compressed_bins)
     compare_search(number_of_repeated_bins, number_of_errors, "search.out", is_empty::no, is_preprocessed::yes);
 }
 
+TEST_F(search_ibf_preprocessing, memory_options)
+{
+    {
+        std::ofstream file{"raptor_cli_test.txt"};
+        for (auto && file_path : get_repeated_bins(1))
+            file << file_path << '\n';
+    }
+
+    auto prepare = [this](std::string const & output, auto &&... additional_arguments)
+    {
+        return execute_app("raptor",
+                           "prepare",
+                           "--kmer 19",
+                           "--window 23",
+                           "--kmer-count-cutoff 2",
+                           "--threads 2",
+                           "--output",
+                           output,
+                           "--quiet",
+                           additional_arguments...,
+                           "--input raptor_cli_test.txt");
+    };
+
+    cli_test_result const result1 = prepare("in_memory");
+    EXPECT_EQ(result1.out, std::string{});
+    EXPECT_EQ(result1.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result1);
+
+    // 512 KiB per thread. The bins have more minimisers, so counts are written to temporary files.
+    cli_test_result const result2 = prepare("limited", "--counting-memory 1");
+    EXPECT_EQ(result2.out, std::string{});
+    EXPECT_EQ(result2.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result2);
+
+    // Each bin exceeds the limit on its own, hence the bins are processed one after another.
+    cli_test_result const result3 = prepare("sequential", "--memory-limit 1");
+    EXPECT_EQ(result3.out, std::string{});
+    EXPECT_EQ(result3.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result3);
+
+    for (std::string const bin : {"bin1", "bin2", "bin3", "bin4"})
+    {
+        std::string const expected_minimiser = string_from_file("in_memory/" + bin + ".minimiser", std::ios::binary);
+        std::string const expected_header = string_from_file("in_memory/" + bin + ".header");
+        for (std::string const directory : {"limited/", "sequential/"})
+        {
+            EXPECT_EQ(string_from_file(directory + bin + ".minimiser", std::ios::binary), expected_minimiser)
+                << directory << bin;
+            EXPECT_EQ(string_from_file(directory + bin + ".header"), expected_header) << directory << bin;
+        }
+    }
+
+    for (auto const & entry : std::filesystem::directory_iterator{"limited"})
+        EXPECT_FALSE(entry.path().extension().string().starts_with(".run")) << entry.path();
+}
+
 INSTANTIATE_TEST_SUITE_P(search_ibf_preprocessing_suite,
                          search_ibf_preprocessing,
                          testing::Combine(testing::Values(0, 16, 32),
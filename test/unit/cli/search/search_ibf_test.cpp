@@ -143,3 +143,97 @@ TEST_F(search_ibf, verbose)
 
     compare_search(16, 1, "search.out");
 }
+
+TEST_F(search_ibf, latency_histograms)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "search",
+                                               "--output search.out",
+                                               "--timing-output raptor.time",
+                                               "--latency-histograms",
+                                               "--quiet",
+                                               "--error 1",
+                                               "--p_max 0.4",
+                                               "--index ",
+                                               ibf_path(16, 19),
+                                               "--query ",
+                                               data("query.fq"));
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result);
+
+    std::string header{};
+    std::ifstream timing_file{"raptor.time"};
+    std::getline(timing_file, header);
+    EXPECT_TRUE(header.ends_with("generate_results_max_in_microseconds")) << header;
+
+    std::ifstream latency_file{"raptor.time.latency"};
+    std::getline(latency_file, header);
+    EXPECT_EQ(header,
+              "stage\tmin_query_length\tmax_query_length\tnumber_of_queries\tp50_in_microseconds\t"
+              "p90_in_microseconds\tp99_in_microseconds\tmax_in_microseconds");
+    std::string line{};
+    size_t lines{};
+    while (std::getline(latency_file, line))
+        ++lines;
+    EXPECT_EQ(lines, 3u); // All queries have length 65: One line per stage.
+
+    compare_search(16, 1, "search.out");
+}
+
+TEST_F(search_ibf, perf_counters)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "search",
+                                               "--output search.out",
+                                               "--timing-output raptor.time",
+                                               "--perf-counters",
+                                               "--quiet",
+                                               "--error 1",
+                                               "--p_max 0.4",
+                                               "--index ",
+                                               ibf_path(16, 19),
+                                               "--query ",
+                                               data("query.fq"));
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result);
+
+    // The counters may not be available, e.g., in containers. Then, the values are NA.
+    std::string header{};
+    std::string values{};
+    std::ifstream timing_file{"raptor.time"};
+    std::getline(timing_file, header);
+    std::getline(timing_file, values);
+    EXPECT_TRUE(header.ends_with("generate_results_dtlb_misses")) << header;
+    EXPECT_EQ(std::ranges::count(header, '\t'), std::ranges::count(values, '\t'));
+
+    compare_search(16, 1, "search.out");
+}
+
+TEST_F(search_ibf, trace)
+{
+    cli_test_result const result = execute_app("raptor",
+                                               "search",
+                                               "--output search.out",
+                                               "--trace raptor.trace.json",
+                                               "--threads 2",
+                                               "--quiet",
+                                               "--error 1",
+                                               "--p_max 0.4",
+                                               "--index ",
+                                               ibf_path(16, 19),
+                                               "--query ",
+                                               data("query.fq"));
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+    RAPTOR_ASSERT_ZERO_EXIT(result);
+
+    std::string const trace = string_from_file("raptor.trace.json");
+    EXPECT_TRUE(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")) << trace;
+    for (std::string_view const name : {"Determine query length", "Load index", "Query file I/O", "Parallel search",
+                                        "Chunk", "Complete search"})
+        EXPECT_NE(trace.find(name), std::string::npos) << name;
+
+    compare_search(16, 1, "search.out");
+}
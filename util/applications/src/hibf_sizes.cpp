@@ -9,6 +9,7 @@
 #include <sharg/parser.hpp>
 
 #include <raptor/index.hpp>
+#include <raptor/index_container.hpp>
 #include <raptor/search/load_index.hpp>
 
 struct config
@@ -57,36 +58,55 @@ int main(int argc, char const * argv[])
         return -1;
     }
 
-    raptor::raptor_index<raptor::index_structure::hibf> index{};
-    raptor::detail::load_index(index, cfg.input);
-    auto const & next_ibf_id = index.ibf().next_ibf_id;
-    auto const & ibf_vector = index.ibf().ibf_vector;
-    assert(next_ibf_id.size() == ibf_vector.size());
-    size_t const number_of_ibfs = next_ibf_id.size();
+    std::vector<size_t> ibf_levels{};
+    std::vector<size_t> ibf_sizes{};
 
-    std::vector<size_t> ibf_levels = [&]()
+    // Only the metadata is read. Indices built by previous versions have none and are loaded.
+    if (std::optional<raptor::index_metadata> const metadata = raptor::read_index_metadata(cfg.input))
     {
-        std::vector<size_t> current_ibf_levels(number_of_ibfs);
-        std::vector<size_t> old_ibf_levels(number_of_ibfs, 1u);
-        while (current_ibf_levels != old_ibf_levels)
+        for (raptor::index_metadata::ibf_type const & ibf : metadata->ibfs)
         {
-            old_ibf_levels = current_ibf_levels;
-            for (size_t ibf_idx = 0; ibf_idx < number_of_ibfs; ++ibf_idx)
+            ibf_levels.push_back(ibf.level);
+            ibf_sizes.push_back(ibf.bit_size);
+        }
+    }
+    else
+    {
+        raptor::raptor_index<raptor::index_structure::hibf> index{};
+        raptor::detail::load_index(index, cfg.input);
+        auto const & next_ibf_id = index.ibf().next_ibf_id;
+        auto const & ibf_vector = index.ibf().ibf_vector;
+        assert(next_ibf_id.size() == ibf_vector.size());
+        size_t const number_of_ibfs = next_ibf_id.size();
+
+        ibf_levels = [&]()
+        {
+            std::vector<size_t> current_ibf_levels(number_of_ibfs);
+            std::vector<size_t> old_ibf_levels(number_of_ibfs, 1u);
+            while (current_ibf_levels != old_ibf_levels)
             {
-                for (size_t const next_ibf_idx : next_ibf_id[ibf_idx])
+                old_ibf_levels = current_ibf_levels;
+                for (size_t ibf_idx = 0; ibf_idx < number_of_ibfs; ++ibf_idx)
                 {
-                    if (next_ibf_idx != ibf_idx) // there is a lower level for this merged tb
-                        current_ibf_levels[next_ibf_idx] = current_ibf_levels[ibf_idx] + 1;
+                    for (size_t const next_ibf_idx : next_ibf_id[ibf_idx])
+                    {
+                        if (next_ibf_idx != ibf_idx) // there is a lower level for this merged tb
+                            current_ibf_levels[next_ibf_idx] = current_ibf_levels[ibf_idx] + 1;
+                    }
                 }
             }
-        }
-        return current_ibf_levels;
-    }();
+            return current_ibf_levels;
+        }();
+
+        for (auto const & ibf : ibf_vector)
+            ibf_sizes.push_back(ibf.bit_size());
+    }
 
+    size_t const number_of_ibfs = ibf_levels.size();
     size_t const number_of_levels = std::ranges::max(ibf_levels) + 1u;
     std::vector<size_t> size_per_level(number_of_levels);
     for (size_t ibf_idx = 0; ibf_idx < number_of_ibfs; ++ibf_idx)
-        size_per_level[ibf_levels[ibf_idx]] += ibf_vector[ibf_idx].bit_size();
+        size_per_level[ibf_levels[ibf_idx]] += ibf_sizes[ibf_idx];
 
     std::ofstream output{cfg.output};
     if (!output.good() || !output.is_open())
@@ -95,7 +115,7 @@ int main(int argc, char const * argv[])
     output << "IDX\tLEVEL\tSIZE\n";
     for (size_t ibf_idx = 0; ibf_idx < number_of_ibfs; ++ibf_idx)
     {
-        output << ibf_idx << '\t' << ibf_levels[ibf_idx] << '\t' << ibf_vector[ibf_idx].bit_size() << '\n';
+        output << ibf_idx << '\t' << ibf_levels[ibf_idx] << '\t' << ibf_sizes[ibf_idx] << '\n';
     }
 
     std::cout << "LEVEL\tSIZE\n";